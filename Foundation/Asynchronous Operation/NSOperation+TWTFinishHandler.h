@@ -0,0 +1,45 @@
+//
+//  NSOperation+TWTFinishHandler.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@interface NSOperation (TWTFinishHandler)
+
+/*!
+ @abstract Adds a block to be invoked once when the operation has finished.
+ @discussion For TWTAsynchronousOperations, this is equivalent to ‑[TWTAsynchronousOperation addFinishHandler:].
+     Other operations are observed using KVO until they finish. In either case, the handler is invoked on the thread 
+     that finished the operation, or immediately on the calling thread if the operation is already finished.
+ @param finishHandler The block to invoke. May not be nil.
+ */
+- (void)twt_addFinishHandler:(void (^)(NSOperation *operation))finishHandler;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,128 @@
+//
+//  NSOperation+TWTFinishHandler.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "NSOperation+TWTFinishHandler.h"
+
+#import <stdatomic.h>
+
+#import "TWTAsynchronousOperation.h"
+
+
+static void *TWTOperationFinishObserverContext = &TWTOperationFinishObserverContext;
+
+
+#pragma mark Finish Observer
+
+/*!
+ TWTOperationFinishObserver is used to find out when an operation that doesn’t support finish handlers has finished.
+ It keeps itself alive until the operation has finished and its finish handler has been invoked exactly once.
+ */
+@interface TWTOperationFinishObserver : NSObject {
+    NSOperation *_operation;
+    void (^_finishHandler)(NSOperation *);
+    atomic_flag _finished;
+    TWTOperationFinishObserver *_selfReference;
+}
+
+- (instancetype)initWithOperation:(NSOperation *)operation finishHandler:(void (^)(NSOperation *))finishHandler;
+- (void)startObserving;
+
+@end
+
+
+@implementation TWTOperationFinishObserver
+
+- (instancetype)initWithOperation:(NSOperation *)operation finishHandler:(void (^)(NSOperation *))finishHandler
+{
+    self = [super init];
+    if (self) {
+        _operation = operation;
+        _finishHandler = [finishHandler copy];
+        atomic_flag_clear(&_finished);
+    }
+    return self;
+}
+
+
+- (void)startObserving
+{
+    _selfReference = self;
+    [_operation addObserver:self forKeyPath:@"isFinished" options:0 context:TWTOperationFinishObserverContext];
+
+    // The operation may have finished before we started observing it
+    if (_operation.isFinished) {
+        [self operationDidFinish];
+    }
+}
+
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    if (context != TWTOperationFinishObserverContext) {
+        [super observeValueForKeyPath:keyPath ofObject:object change:change context:context];
+        return;
+    }
+
+    if ([object isFinished]) {
+        [self operationDidFinish];
+    }
+}
+
+
+- (void)operationDidFinish
+{
+    if (atomic_flag_test_and_set(&_finished)) {
+        return;
+    }
+
+    // Removing our self-reference may deallocate us, so hold on to ourselves until we’re done
+    NS_VALID_UNTIL_END_OF_SCOPE TWTOperationFinishObserver *strongSelf = _selfReference;
+    _selfReference = nil;
+
+    [_operation removeObserver:strongSelf forKeyPath:@"isFinished" context:TWTOperationFinishObserverContext];
+    _finishHandler(_operation);
+}
+
+@end
+
+
+#pragma mark -
+
+@implementation NSOperation (TWTFinishHandler)
+
+- (void)twt_addFinishHandler:(void (^)(NSOperation *))finishHandler
+{
+    NSParameterAssert(finishHandler);
+
+    if ([self isKindOfClass:[TWTAsynchronousOperation class]]) {
+        [(TWTAsynchronousOperation *)self addFinishHandler:finishHandler];
+        return;
+    }
+
+    [[[TWTOperationFinishObserver alloc] initWithOperation:self finishHandler:finishHandler] startObserving];
+}
+
+@end
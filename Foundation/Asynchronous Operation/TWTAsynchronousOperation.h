@@ -33,9 +33,29 @@ NS_ASSUME_NONNULL_BEGIN
 
 typedef void (^TWTAsynchronousOperationBlock)(TWTAsynchronousOperation *operation);
 
+/**
+ The actions an operation can take when it misses its deadline.
+ */
+typedef NS_ENUM(NSInteger, TWTAsynchronousOperationDeadlineAction) {
+    /** The operation is cancelled. If it is executing, its block is responsible for noticing and finishing. */
+    TWTAsynchronousOperationDeadlineActionCancel,
+
+    /**
+     The operation is cancelled and, if it is executing, finished immediately. The block’s eventual invocation of
+     `-[TWTAsynchronousOperation finishOperationExecution]` has no effect.
+     */
+    TWTAsynchronousOperationDeadlineActionFinish
+};
+
 
 @interface TWTAsynchronousOperation : NSOperation
 
+/**
+ Whether the operation missed a deadline set with `-[TWTAsynchronousOperation setDeadlineWithTimeInterval:action:]`.
+ This allows finish handlers and completion blocks to distinguish timeouts from other cancellations.
+ */
+@property (nonatomic, assign, readonly) BOOL missedDeadline;
+
 /**
  @abstract Initializes an operation given an operation block to execute.
  
@@ -50,6 +70,9 @@ typedef void (^TWTAsynchronousOperationBlock)(TWTAsynchronousOperation *operatio
  It is also recommended (as an optimization) that the block periodically check the
  `-[TWTAsynchronousOperation isCancelled]` flag, and properly abort the execution of its asynchronous task, followed
  by an invocation of `-[TWTAsynchronousOperation finishOperationExecution]` to mark the operation is finished.
+ 
+ If the operation is cancelled before it is started, the block is never executed and the operation moves directly to
+ the finished state when it is started.
  */
 - (id)initWithOperationBlock:(nullable TWTAsynchronousOperationBlock)operationBlock;
 
@@ -71,9 +94,42 @@ typedef void (^TWTAsynchronousOperationBlock)(TWTAsynchronousOperation *operatio
  asynchronous tasks have been completed, and it may leave the executing state and enter the finished state. The 
  operation will never leave the executing state on its on, and failure by the developer submitted block to invoke this
  method will result in indefinite execution of this operation.
+ 
+ This method is safe to invoke from any thread. Invocations after the first one, or before the operation has started
+ executing, have no effect.
  */
 - (void)finishOperationExecution;
 
+/**
+ @abstract Adds a block to be invoked when the operation enters the finished state.
+ 
+ @param finishHandler The block to invoke. May not be nil.
+ 
+ @discussion Unlike `-[NSOperation completionBlock]`, any number of finish handlers may be added, and they are invoked
+ synchronously on the thread that finishes the operation, in the order they were added. This makes them a cheap
+ alternative to observing `isFinished` for executors and other infrastructure built on top of the operation. If the 
+ operation is already finished, the handler is invoked immediately on the calling thread.
+ */
+- (void)addFinishHandler:(TWTAsynchronousOperationBlock)finishHandler;
+
+/**
+ @abstract Sets a deadline by which the operation must finish.
+ 
+ @param timeInterval The time interval from now after which the deadline expires.
+ @param action The action to take if the operation has not finished when the deadline expires.
+ 
+ @discussion Deadlines are tracked by the shared `TWTTimerWheel`, so they are cheap to set and are removed as soon as 
+ the operation finishes rather than lingering until they would have expired. Expirations are processed on the timer
+ wheel’s thread, and are accurate to within its tick interval. Setting a deadline replaces any previous deadline. 
+ Setting a deadline on a finished operation has no effect.
+ */
+- (void)setDeadlineWithTimeInterval:(NSTimeInterval)timeInterval action:(TWTAsynchronousOperationDeadlineAction)action;
+
+/**
+ @abstract Removes the operation’s deadline, if any.
+ */
+- (void)removeDeadline;
+
 @end
 
 NS_ASSUME_NONNULL_END
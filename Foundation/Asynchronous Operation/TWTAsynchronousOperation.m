@@ -26,28 +26,68 @@
 
 #import "TWTAsynchronousOperation.h"
 
+#import <pthread.h>
+#import <stdatomic.h>
+
+#import "TWTOperationInstrumentation+Private.h"
+#import "TWTTimerWheel.h"
+
 typedef NS_ENUM(NSUInteger, TWTOperationState) {
     TWTOperationStateReady,
     TWTOperationStateExecuting,
-    TWTOperationStateFinished
+    TWTOperationStateFinished,
+
+    // Transitional states, which the operation is in while the thread making a transition sends its will-change
+    // notifications. Until the transition completes, the operation reports the values of the state it is leaving.
+    TWTOperationStateReadyToExecuting,
+    TWTOperationStateReadyToFinished,
+    TWTOperationStateExecutingToFinished
 };
 
-static NSString * TWTKeyFromOperationState(TWTOperationState state) {
-    switch (state) {
-        case TWTOperationStateReady:
-            return @"isReady";
-        case TWTOperationStateExecuting:
-            return @"isExecuting";
-        case TWTOperationStateFinished:
-            return @"isFinished";
+static TWTOperationState TWTTransitionalOperationState(TWTOperationState fromState, TWTOperationState toState)
+{
+    if (fromState == TWTOperationStateReady && toState == TWTOperationStateExecuting) {
+        return TWTOperationStateReadyToExecuting;
+    } else if (fromState == TWTOperationStateReady) {
+        return TWTOperationStateReadyToFinished;
     }
+
+    NSCAssert(fromState == TWTOperationStateExecuting && toState == TWTOperationStateFinished, @"Invalid transition");
+    return TWTOperationStateExecutingToFinished;
 }
 
-@interface TWTAsynchronousOperation ()
+@interface TWTAsynchronousOperation () {
+    // The operation's state. All transitions are claimed with compare-and-swap so that -start,
+    // -finishOperationExecution, and -cancel can safely race with one another on different threads.
+    _Atomic(TWTOperationState) _state;
+
+    // Guards _finishHandlers, which is nil until a handler is added and set back to nil once the handlers are invoked,
+    // and _deadlineTimer, which is cancelled and set to nil when the operation finishes
+    pthread_mutex_t _finishHandlersLock;
+    NSMutableArray<TWTAsynchronousOperationBlock> *_finishHandlers;
+    TWTTimerWheelTimer *_deadlineTimer;
+
+    _Atomic(bool) _missedDeadline;
+
+    // Monotonic timestamps of when the operation was first ready and when it started, or 0 if instrumentation was off
+    _Atomic(uint64_t) _readyTime;
+    _Atomic(uint64_t) _startTime;
+}
 
-@property (nonatomic, assign) TWTOperationState state;
 @property (nonatomic, copy) TWTAsynchronousOperationBlock operationBlock;
 
+/*!
+ @abstract Atomically moves the operation from one state to another, sending KVO notifications only for the
+     keys whose values change as a result.
+ @discussion The transition is claimed by moving into a transitional state before any notifications are sent, so
+     when several threads race to move the operation out of the same state, only the winner sends notifications.
+ @param fromState The state the operation is expected to be in.
+ @param toState The state to move the operation to.
+ @result Whether the transition happened. If the operation was not in fromState, no transition or KVO notifications
+     occur and NO is returned.
+ */
+- (BOOL)transitionFromState:(TWTOperationState)fromState toState:(TWTOperationState)toState;
+
 @end
 
 @implementation TWTAsynchronousOperation
@@ -56,10 +96,28 @@ static NSString * TWTKeyFromOperationState(TWTOperationState state) {
 
 - (void)start
 {
-    self.state = TWTOperationStateExecuting;
-    
-    if (self.operationBlock) {
-        self.operationBlock(self);
+    // If we were cancelled before being started, move straight to finished without ever running the block.
+    if (self.isCancelled) {
+        if ([self transitionFromState:TWTOperationStateReady toState:TWTOperationStateFinished]) {
+            self.operationBlock = nil;
+        }
+
+        return;
+    }
+
+    // Read the block before entering the executing state. Until that transition happens, no one can finish the
+    // operation and clear the block out from under us.
+    TWTAsynchronousOperationBlock operationBlock = self.operationBlock;
+    if (![self transitionFromState:TWTOperationStateReady toState:TWTOperationStateExecuting]) {
+        return;
+    }
+
+    if (atomic_load_explicit(&TWTOperationInstrumentationEnabled, memory_order_relaxed)) {
+        atomic_store_explicit(&_startTime, TWTOperationInstrumentationCurrentTime(), memory_order_relaxed);
+    }
+
+    if (operationBlock) {
+        operationBlock(self);
     } else {
         [self finishOperationExecution];
     }
@@ -67,23 +125,72 @@ static NSString * TWTKeyFromOperationState(TWTOperationState state) {
 
 - (void)finishOperationExecution
 {
-    self.operationBlock = nil;
-    self.state = TWTOperationStateFinished;
+    if ([self transitionFromState:TWTOperationStateExecuting toState:TWTOperationStateFinished]) {
+        self.operationBlock = nil;
+    }
+}
+
+- (void)addFinishHandler:(TWTAsynchronousOperationBlock)finishHandler
+{
+    NSParameterAssert(finishHandler);
+
+    pthread_mutex_lock(&_finishHandlersLock);
+    if (!self.isFinished) {
+        if (!_finishHandlers) {
+            _finishHandlers = [[NSMutableArray alloc] init];
+        }
+
+        [_finishHandlers addObject:[finishHandler copy]];
+        finishHandler = nil;
+    }
+    pthread_mutex_unlock(&_finishHandlersLock);
+
+    // If we're already finished, invoke the handler immediately
+    if (finishHandler) {
+        finishHandler(self);
+    }
+}
+
+- (void)invokeFinishHandlers
+{
+    pthread_mutex_lock(&_finishHandlersLock);
+    NSMutableArray<TWTAsynchronousOperationBlock> *finishHandlers = _finishHandlers;
+    TWTTimerWheelTimer *deadlineTimer = _deadlineTimer;
+    _finishHandlers = nil;
+    _deadlineTimer = nil;
+    pthread_mutex_unlock(&_finishHandlersLock);
+
+    [deadlineTimer cancel];
+
+    for (TWTAsynchronousOperationBlock finishHandler in finishHandlers) {
+        finishHandler(self);
+    }
 }
 
 - (BOOL)isReady
 {
-    return self.state == TWTOperationStateReady && [super isReady];
+    BOOL ready = [super isReady];
+
+    // Only the first time we report being ready counts as the start of our queue wait
+    if (ready && atomic_load_explicit(&TWTOperationInstrumentationEnabled, memory_order_relaxed) &&
+        atomic_load_explicit(&_readyTime, memory_order_relaxed) == 0) {
+        uint64_t expectedTime = 0;
+        atomic_compare_exchange_strong_explicit(&_readyTime, &expectedTime, TWTOperationInstrumentationCurrentTime(),
+                                                memory_order_relaxed, memory_order_relaxed);
+    }
+
+    return ready;
 }
 
 - (BOOL)isExecuting
 {
-    return self.state == TWTOperationStateExecuting;
+    TWTOperationState state = atomic_load_explicit(&_state, memory_order_acquire);
+    return state == TWTOperationStateExecuting || state == TWTOperationStateExecutingToFinished;
 }
 
 - (BOOL)isFinished
 {
-    return self.state == TWTOperationStateFinished;
+    return atomic_load_explicit(&_state, memory_order_acquire) == TWTOperationStateFinished;
 }
 
 - (BOOL)isConcurrent
@@ -91,28 +198,155 @@ static NSString * TWTKeyFromOperationState(TWTOperationState state) {
     return YES;
 }
 
-- (void)setState:(TWTOperationState)state
+- (BOOL)isAsynchronous
+{
+    return YES;
+}
+
+- (BOOL)transitionFromState:(TWTOperationState)fromState toState:(TWTOperationState)toState
+{
+    // Claim the transition before sending any notifications. Threads that lose the race send none, and no other
+    // transition can start until we store the final state.
+    TWTOperationState expectedState = fromState;
+    TWTOperationState transitionalState = TWTTransitionalOperationState(fromState, toState);
+    if (!atomic_compare_exchange_strong_explicit(&_state, &expectedState, transitionalState,
+                                                 memory_order_acq_rel, memory_order_acquire)) {
+        return NO;
+    }
+
+    // isReady's value is determined entirely by NSOperation, so the only keys that can change are isExecuting and
+    // isFinished
+    BOOL executingChanges = (fromState == TWTOperationStateExecuting) != (toState == TWTOperationStateExecuting);
+    BOOL finishedChanges = (fromState == TWTOperationStateFinished) != (toState == TWTOperationStateFinished);
+
+    if (executingChanges) {
+        [self willChangeValueForKey:@"isExecuting"];
+    }
+
+    if (finishedChanges) {
+        [self willChangeValueForKey:@"isFinished"];
+    }
+
+    // Record before observers learn that we've finished so that anyone waiting on us sees our measurements
+    if (fromState == TWTOperationStateExecuting && toState == TWTOperationStateFinished) {
+        [self recordInstrumentation];
+    }
+
+    atomic_store_explicit(&_state, toState, memory_order_release);
+
+    if (finishedChanges) {
+        [self didChangeValueForKey:@"isFinished"];
+    }
+
+    if (executingChanges) {
+        [self didChangeValueForKey:@"isExecuting"];
+    }
+
+    if (toState == TWTOperationStateFinished) {
+        [self invokeFinishHandlers];
+    }
+
+    return YES;
+}
+
+- (void)recordInstrumentation
 {
-    NSString *oldStateKey = TWTKeyFromOperationState(self.state);
-    NSString *newStateKey = TWTKeyFromOperationState(state);
-    
-    [self willChangeValueForKey:oldStateKey];
-    [self willChangeValueForKey:newStateKey];
-    _state = state;
-    [self didChangeValueForKey:oldStateKey];
-    [self didChangeValueForKey:newStateKey];
+    if (!atomic_load_explicit(&TWTOperationInstrumentationEnabled, memory_order_relaxed)) {
+        return;
+    }
+
+    // If we started before instrumentation was enabled, there's nothing to record
+    uint64_t startTime = atomic_load_explicit(&_startTime, memory_order_relaxed);
+    if (startTime == 0) {
+        return;
+    }
+
+    NSString *label = self.name ?: NSStringFromClass(self.class);
+    TWTOperationInstrumentationRecord(label, atomic_load_explicit(&_readyTime, memory_order_relaxed), startTime,
+                                      TWTOperationInstrumentationCurrentTime());
+}
+
+#pragma mark - Deadlines
+
+- (void)setDeadlineWithTimeInterval:(NSTimeInterval)timeInterval action:(TWTAsynchronousOperationDeadlineAction)action
+{
+    if (self.isFinished) {
+        return;
+    }
+
+    // The timer only holds a weak reference so that pending deadlines don't extend the operation's lifetime
+    __weak typeof(self) weakSelf = self;
+    TWTTimerWheelTimer *deadlineTimer = [[TWTTimerWheel sharedTimerWheel] scheduleTimerWithTimeInterval:timeInterval block:^{
+        [weakSelf deadlineDidExpireWithAction:action];
+    }];
+
+    pthread_mutex_lock(&_finishHandlersLock);
+    TWTTimerWheelTimer *previousDeadlineTimer = _deadlineTimer;
+
+    // If we finished while the timer was being scheduled, the finish handlers have already run, so cancel it ourselves
+    BOOL finished = self.isFinished;
+    _deadlineTimer = finished ? nil : deadlineTimer;
+    pthread_mutex_unlock(&_finishHandlersLock);
+
+    [previousDeadlineTimer cancel];
+    if (finished) {
+        [deadlineTimer cancel];
+    }
+}
+
+- (void)removeDeadline
+{
+    pthread_mutex_lock(&_finishHandlersLock);
+    TWTTimerWheelTimer *deadlineTimer = _deadlineTimer;
+    _deadlineTimer = nil;
+    pthread_mutex_unlock(&_finishHandlersLock);
+
+    [deadlineTimer cancel];
+}
+
+- (void)deadlineDidExpireWithAction:(TWTAsynchronousOperationDeadlineAction)action
+{
+    if (self.isFinished) {
+        return;
+    }
+
+    atomic_store(&_missedDeadline, true);
+    [self cancel];
+
+    if (action == TWTAsynchronousOperationDeadlineActionFinish) {
+        [self finishOperationExecution];
+    }
+}
+
+- (BOOL)missedDeadline
+{
+    return atomic_load(&_missedDeadline);
 }
 
 #pragma mark - Init
 
+- (id)init
+{
+    return [self initWithOperationBlock:nil];
+}
+
 - (id)initWithOperationBlock:(TWTAsynchronousOperationBlock)operationBlock
 {
     self = [super init];
     if (self) {
         _operationBlock = [operationBlock copy];
-        _state = TWTOperationStateReady;
+        atomic_init(&_state, TWTOperationStateReady);
+        atomic_init(&_missedDeadline, false);
+        atomic_init(&_readyTime, 0);
+        atomic_init(&_startTime, 0);
+        pthread_mutex_init(&_finishHandlersLock, NULL);
     }
     return self;
 }
 
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_finishHandlersLock);
+}
+
 @end
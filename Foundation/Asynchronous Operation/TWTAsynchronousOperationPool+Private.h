@@ -0,0 +1,47 @@
+//
+//  TWTAsynchronousOperationPool+Private.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTAsynchronousOperationPool.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ Methods that TWTWorkStealingExecutor uses to run TWTAsynchronousTasks without allocating a finish handler.
+ */
+@interface TWTAsynchronousTask (Private)
+
+/*!
+ @abstract Executes the task’s block on the calling thread and leaves the specified dispatch group when the task 
+     finishes.
+ @discussion If the task is already executing, it is not started again and the group is left immediately.
+ @param group The dispatch group to leave when the task finishes, or nil.
+ */
+- (void)startInGroup:(nullable dispatch_group_t)group;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,127 @@
+//
+//  TWTAsynchronousOperationPool.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+@class TWTAsynchronousTask;
+
+typedef void (^TWTAsynchronousTaskBlock)(TWTAsynchronousTask *task);
+
+/*!
+ TWTAsynchronousTasks are lightweight, recyclable units of asynchronous work vended by TWTAsynchronousOperationPools.
+ Like a TWTAsynchronousOperation, a task executes a block that may start asynchronous work, and the block must 
+ eventually invoke ‑finishTaskExecution. Unlike operations, tasks are not NSOperations: they have no dependencies, 
+ cancellation, finish handlers, or KVO-observable state, and they cannot be added to operation queues. That is what 
+ allows them to be reset and run again, which NSOperation does not support.
+ 
+ Tasks are run by sending them ‑start or by submitting them to a TWTWorkStealingExecutor with ‑addTask:. Each task 
+ should be started once. As soon as a task finishes, it is returned to its pool and may be vended again, so the task 
+ must not be referenced after it invokes ‑finishTaskExecution. 
+ */
+@interface TWTAsynchronousTask : NSObject
+
+/*! Whether the task has been started and has not yet finished. */
+@property (nonatomic, assign, readonly, getter=isExecuting) BOOL executing;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Executes the task’s block on the calling thread.
+ @discussion If the task has no block, it finishes immediately. Starting a task that is already executing has no 
+     effect.
+ */
+- (void)start;
+
+/*!
+ @abstract Finishes the task and returns it to its pool.
+ @discussion This may be invoked from any thread. Invoking it on a task that is not executing has no effect.
+ */
+- (void)finishTaskExecution;
+
+@end
+
+
+/*!
+ TWTAsynchronousOperationPools vend and recycle TWTAsynchronousTasks so that workloads consisting of many very short 
+ pieces of asynchronous work do not allocate for each one. Once its free lists are warm, vending a task, running it, 
+ and recycling it allocate nothing beyond copying the task’s block, which is itself free for blocks that have already
+ been copied to the heap.
+ 
+ Each thread has its own free list. A task is allocated on a thread’s free list the first time that thread asks for a
+ task and finds its free list empty, and from then on it always returns to that free list when it finishes, no matter
+ which thread finishes it. This means that a thread that submits tasks to be run elsewhere, e.g., by a 
+ TWTWorkStealingExecutor, gets its tasks back. Free lists are guarded by locks that are only held long enough to 
+ push or pop a single task.
+ 
+ The total number of tasks held by the pool across all threads never exceeds the pool’s maximum size; tasks that 
+ finish while the pool is full are simply released. A thread’s free list and the tasks in it are released when the
+ thread exits.
+ */
+@interface TWTAsynchronousOperationPool : NSObject
+
+/*! The maximum number of finished tasks the pool holds across all threads. */
+@property (nonatomic, assign, readonly) NSUInteger maximumPoolSize;
+
+/*! The number of finished tasks currently held by the pool across all threads. */
+@property (nonatomic, assign, readonly) NSUInteger pooledTaskCount;
+
+/*! The number of times ‑taskWithBlock: reused a finished task. */
+@property (nonatomic, assign, readonly) NSUInteger hitCount;
+
+/*! The number of times ‑taskWithBlock: had to allocate a new task. */
+@property (nonatomic, assign, readonly) NSUInteger missCount;
+
+/*! The number of tasks that finished but were not returned to the pool because it was full. */
+@property (nonatomic, assign, readonly) NSUInteger discardCount;
+
+/*!
+ @abstract Initializes a newly created pool that holds up to 1024 tasks.
+ @result An initialized pool.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created pool with the specified maximum size.
+ @param maximumPoolSize The maximum number of finished tasks the pool holds across all threads.
+ @result An initialized pool.
+ */
+- (instancetype)initWithMaximumPoolSize:(NSUInteger)maximumPoolSize NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Returns a task that will execute the specified block.
+ @discussion If the calling thread’s free list is not empty, a finished task is removed from it and reset. Otherwise,
+     a new task is allocated. 
+ @param block The block the task will execute.
+ @result A task that executes the specified block.
+ */
+- (TWTAsynchronousTask *)taskWithBlock:(nullable TWTAsynchronousTaskBlock)block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,321 @@
+//
+//  TWTAsynchronousOperationPool.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTAsynchronousOperationPool.h"
+#import "TWTAsynchronousOperationPool+Private.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+
+// Used to give each pool a unique free list key. Keys derived from pool addresses could be reused by a new pool after
+// an old one is deallocated, and the new pool would pick up the old pool’s free lists
+static _Atomic(uint64_t) TWTAsynchronousOperationPoolNextIdentifier;
+
+
+#pragma mark Free Lists
+
+/*!
+ TWTAsynchronousTaskFreeLists hold the finished tasks that were allocated on a single thread as a singly linked list.
+ They are stored in their thread’s thread dictionary, so they are released when their thread exits, at which point
+ their tasks are removed from the pool’s count. Tasks can finish on any thread, so the list is guarded by a lock.
+ */
+@interface TWTAsynchronousTaskFreeList : NSObject {
+@public
+    __weak TWTAsynchronousOperationPool *_pool;
+    pthread_mutex_t _lock;
+    TWTAsynchronousTask *_firstTask;
+    NSUInteger _taskCount;
+}
+
+@end
+
+
+@interface TWTAsynchronousTask () {
+@public
+    // The free list of the thread that allocated the task, to which the task returns when it finishes. It is weak so
+    // that a free list and its tasks do not retain each other
+    __weak TWTAsynchronousTaskFreeList *_freeList;
+
+    // The next task in the free list. Guarded by the free list’s lock
+    TWTAsynchronousTask *_nextFreeTask;
+
+    TWTAsynchronousTaskBlock _block;
+    dispatch_group_t _finishGroup;
+
+    // Keeps the task alive while it executes, since nothing else is required to reference it
+    TWTAsynchronousTask *_executingTask;
+    _Atomic(bool) _executing;
+}
+
+- (instancetype)initWithFreeList:(TWTAsynchronousTaskFreeList *)freeList;
+
+@end
+
+
+@interface TWTAsynchronousOperationPool () {
+@public
+    _Atomic(NSUInteger) _pooledTaskCount;
+    _Atomic(NSUInteger) _hitCount;
+    _Atomic(NSUInteger) _missCount;
+    _Atomic(NSUInteger) _discardCount;
+}
+
+// The key under which the pool’s free lists are stored in each thread’s thread dictionary
+@property (nonatomic, copy, readonly) NSString *freeListKey;
+
+- (void)recycleTask:(TWTAsynchronousTask *)task toFreeList:(TWTAsynchronousTaskFreeList *)freeList;
+
+@end
+
+
+@implementation TWTAsynchronousTaskFreeList
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    TWTAsynchronousOperationPool *pool = _pool;
+    if (pool) {
+        atomic_fetch_sub(&pool->_pooledTaskCount, _taskCount);
+    }
+
+    // Unlink the tasks one at a time so that releasing a long list doesn’t recurse once per task
+    TWTAsynchronousTask *task = _firstTask;
+    _firstTask = nil;
+    while (task) {
+        TWTAsynchronousTask *nextTask = task->_nextFreeTask;
+        task->_nextFreeTask = nil;
+        task = nextTask;
+    }
+
+    pthread_mutex_destroy(&_lock);
+}
+
+@end
+
+
+#pragma mark - Tasks
+
+@implementation TWTAsynchronousTask
+
+- (instancetype)initWithFreeList:(TWTAsynchronousTaskFreeList *)freeList
+{
+    self = [super init];
+    if (self) {
+        _freeList = freeList;
+        atomic_init(&_executing, false);
+    }
+    return self;
+}
+
+
+- (BOOL)isExecuting
+{
+    return atomic_load(&_executing);
+}
+
+
+- (void)start
+{
+    [self startInGroup:nil];
+}
+
+
+- (void)startInGroup:(dispatch_group_t)group
+{
+    bool expectedExecuting = false;
+    if (!atomic_compare_exchange_strong(&_executing, &expectedExecuting, true)) {
+        if (group) {
+            dispatch_group_leave(group);
+        }
+
+        return;
+    }
+
+    _finishGroup = group;
+    _executingTask = self;
+
+    // Hold the block in a local, since finishing the task from inside the block releases the task’s reference to it
+    TWTAsynchronousTaskBlock block = _block;
+    if (block) {
+        block(self);
+    } else {
+        [self finishTaskExecution];
+    }
+}
+
+
+- (void)finishTaskExecution
+{
+    if (!atomic_exchange(&_executing, false)) {
+        return;
+    }
+
+    TWTAsynchronousTask *task = _executingTask;
+    dispatch_group_t finishGroup = _finishGroup;
+    _executingTask = nil;
+    _finishGroup = nil;
+    _block = nil;
+
+    // If the thread that allocated the task has exited, its free list is gone and the task is simply released.
+    // Otherwise, once the task is back in its free list, another thread may reuse it, so we can’t touch its ivars
+    TWTAsynchronousTaskFreeList *freeList = _freeList;
+    if (freeList) {
+        [freeList->_pool recycleTask:task toFreeList:freeList];
+    }
+
+    if (finishGroup) {
+        dispatch_group_leave(finishGroup);
+    }
+}
+
+@end
+
+
+#pragma mark - Pool
+
+@implementation TWTAsynchronousOperationPool
+
+- (instancetype)init
+{
+    return [self initWithMaximumPoolSize:1024];
+}
+
+
+- (instancetype)initWithMaximumPoolSize:(NSUInteger)maximumPoolSize
+{
+    self = [super init];
+    if (self) {
+        _maximumPoolSize = maximumPoolSize;
+        _freeListKey = [NSString stringWithFormat:@"%@.%llu", self.class,
+                        (unsigned long long)atomic_fetch_add(&TWTAsynchronousOperationPoolNextIdentifier, 1)];
+        atomic_init(&_pooledTaskCount, 0);
+        atomic_init(&_hitCount, 0);
+        atomic_init(&_missCount, 0);
+        atomic_init(&_discardCount, 0);
+    }
+    return self;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p maximumPoolSize=%lu pooledTaskCount=%lu hitCount=%lu missCount=%lu discardCount=%lu>",
+            self.class, self, (unsigned long)self.maximumPoolSize, (unsigned long)self.pooledTaskCount,
+            (unsigned long)self.hitCount, (unsigned long)self.missCount, (unsigned long)self.discardCount];
+}
+
+
+- (NSUInteger)pooledTaskCount
+{
+    return atomic_load(&_pooledTaskCount);
+}
+
+
+- (NSUInteger)hitCount
+{
+    return atomic_load(&_hitCount);
+}
+
+
+- (NSUInteger)missCount
+{
+    return atomic_load(&_missCount);
+}
+
+
+- (NSUInteger)discardCount
+{
+    return atomic_load(&_discardCount);
+}
+
+
+- (TWTAsynchronousTaskFreeList *)freeListForCurrentThread
+{
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    TWTAsynchronousTaskFreeList *freeList = threadDictionary[self.freeListKey];
+    if (!freeList || freeList->_pool != self) {
+        freeList = [[TWTAsynchronousTaskFreeList alloc] init];
+        freeList->_pool = self;
+        threadDictionary[self.freeListKey] = freeList;
+    }
+
+    return freeList;
+}
+
+
+- (TWTAsynchronousTask *)taskWithBlock:(TWTAsynchronousTaskBlock)block
+{
+    TWTAsynchronousTaskFreeList *freeList = [self freeListForCurrentThread];
+
+    pthread_mutex_lock(&freeList->_lock);
+    TWTAsynchronousTask *task = freeList->_firstTask;
+    if (task) {
+        freeList->_firstTask = task->_nextFreeTask;
+        task->_nextFreeTask = nil;
+        --freeList->_taskCount;
+    }
+    pthread_mutex_unlock(&freeList->_lock);
+
+    if (task) {
+        atomic_fetch_sub(&_pooledTaskCount, 1);
+        atomic_fetch_add_explicit(&_hitCount, 1, memory_order_relaxed);
+    } else {
+        task = [[TWTAsynchronousTask alloc] initWithFreeList:freeList];
+        atomic_fetch_add_explicit(&_missCount, 1, memory_order_relaxed);
+    }
+
+    task->_block = [block copy];
+    return task;
+}
+
+
+- (void)recycleTask:(TWTAsynchronousTask *)task toFreeList:(TWTAsynchronousTaskFreeList *)freeList
+{
+    // Reserve a slot in the pool before doing any work, and give it back if we can’t use it
+    if (atomic_fetch_add(&_pooledTaskCount, 1) >= self.maximumPoolSize) {
+        atomic_fetch_sub(&_pooledTaskCount, 1);
+        atomic_fetch_add_explicit(&_discardCount, 1, memory_order_relaxed);
+        return;
+    }
+
+    pthread_mutex_lock(&freeList->_lock);
+    task->_nextFreeTask = freeList->_firstTask;
+    freeList->_firstTask = task;
+    ++freeList->_taskCount;
+    pthread_mutex_unlock(&freeList->_lock);
+}
+
+@end
@@ -0,0 +1,52 @@
+//
+//  TWTOperationInstrumentation+Private.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import <stdatomic.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! Whether operation instrumentation is enabled. Read without a lock at each operation state transition. */
+extern _Atomic(bool) TWTOperationInstrumentationEnabled;
+
+/*!
+ @abstract Returns the current time in the units TWTOperationInstrumentationRecord expects.
+ @result The current mach absolute time.
+ */
+extern uint64_t TWTOperationInstrumentationCurrentTime(void);
+
+/*!
+ @abstract Records the queue wait and execution latencies of an operation with the current thread's recorder.
+ @param label The label under which to record the latencies. May not be nil.
+ @param readyTime The time at which the operation became ready.
+ @param startTime The time at which the operation started executing.
+ @param finishTime The time at which the operation finished.
+ */
+extern void TWTOperationInstrumentationRecord(NSString *label, uint64_t readyTime, uint64_t startTime, uint64_t finishTime);
+
+NS_ASSUME_NONNULL_END
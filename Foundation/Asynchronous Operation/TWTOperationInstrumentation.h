@@ -0,0 +1,111 @@
+//
+//  TWTOperationInstrumentation.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*! Snapshot key for the statistics of the time operations spent ready but waiting to be started. */
+extern NSString *const kTWTOperationInstrumentationQueueWaitTimeKey;
+
+/*! Snapshot key for the statistics of the time operations spent executing. */
+extern NSString *const kTWTOperationInstrumentationRunTimeKey;
+
+/*! Statistic key for the number of recorded values. The value is an NSNumber containing an unsigned integer. */
+extern NSString *const kTWTOperationInstrumentationCountKey;
+
+/*! 
+ Statistic keys for the minimum, maximum, and mean recorded values, and for the 50th, 90th, 99th and 99.9th 
+ percentiles. The values are NSNumbers containing times in seconds.
+ */
+extern NSString *const kTWTOperationInstrumentationMinimumKey;
+extern NSString *const kTWTOperationInstrumentationMaximumKey;
+extern NSString *const kTWTOperationInstrumentationMeanKey;
+extern NSString *const kTWTOperationInstrumentationP50Key;
+extern NSString *const kTWTOperationInstrumentationP90Key;
+extern NSString *const kTWTOperationInstrumentationP99Key;
+extern NSString *const kTWTOperationInstrumentationP999Key;
+
+
+/*!
+ TWTOperationInstrumentation measures how long TWTAsynchronousOperations wait to be started after becoming ready and 
+ how long they spend executing. Instrumentation is off by default. While it is off, operations only pay for a single
+ relaxed atomic load at each state transition.
+ 
+ While instrumentation is on, operations timestamp their ready, start, and finish transitions using the monotonic 
+ clock. When an operation finishes, its queue wait and run times are recorded on the finishing thread into histograms
+ owned by that thread, so recording never takes a lock or contends with other threads. Histograms are grouped by 
+ label, which is the operation’s name if it has one and its class name otherwise.
+ 
+ Histograms are log-linear in the manner of HDR histograms: values are bucketed with a relative error of at most 1/16 
+ across the range from one nanosecond to about 18 minutes. Larger values are counted in the last bucket, though the 
+ maximum is tracked exactly. 
+ 
+ An operation’s queue wait is measured from the first time it reports that it is ready while instrumentation is on. 
+ Operations that are started manually without ever being asked whether they’re ready only record their run time.
+ */
+@interface TWTOperationInstrumentation : NSObject
+
+/*!
+ @abstract Returns whether instrumentation is enabled.
+ @result Whether instrumentation is enabled.
+ */
++ (BOOL)isEnabled;
+
+/*!
+ @abstract Enables or disables instrumentation.
+ @discussion Operations that are already executing when instrumentation is enabled are not recorded.
+ @param enabled Whether instrumentation should be enabled.
+ */
++ (void)setEnabled:(BOOL)enabled;
+
+/*!
+ @abstract Returns a snapshot of the statistics recorded since instrumentation was last reset.
+ @discussion The snapshot maps each label to a dictionary containing the statistics for 
+     kTWTOperationInstrumentationQueueWaitTimeKey and kTWTOperationInstrumentationRunTimeKey. Each set of statistics 
+     is a dictionary keyed by the statistic keys above. Taking a snapshot merges every thread’s histograms, but does
+     not block threads that are recording.
+ @result A snapshot of the recorded statistics.
+ */
++ (NSDictionary<NSString *, NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *> *)snapshot;
+
+/*!
+ @abstract Returns a snapshot of the recorded statistics as JSON data.
+ @param error On return, contains an error if the snapshot could not be serialized.
+ @result The JSON data, or nil if an error occurred.
+ */
++ (nullable NSData *)snapshotJSONDataWithError:(NSError *__autoreleasing *)error;
+
+/*!
+ @abstract Discards every recorded value.
+ @discussion Values recorded concurrently with a reset may be discarded along with those recorded before it.
+ */
++ (void)reset;
+
+@end
+
+NS_ASSUME_NONNULL_END
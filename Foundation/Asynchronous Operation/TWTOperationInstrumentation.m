@@ -0,0 +1,392 @@
+//
+//  TWTOperationInstrumentation.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTOperationInstrumentation.h"
+#import "TWTOperationInstrumentation+Private.h"
+
+#import <mach/mach_time.h>
+#import <pthread.h>
+#import <stdatomic.h>
+
+
+NSString *const kTWTOperationInstrumentationQueueWaitTimeKey = @"queueWaitTime";
+NSString *const kTWTOperationInstrumentationRunTimeKey = @"runTime";
+NSString *const kTWTOperationInstrumentationCountKey = @"count";
+NSString *const kTWTOperationInstrumentationMinimumKey = @"min";
+NSString *const kTWTOperationInstrumentationMaximumKey = @"max";
+NSString *const kTWTOperationInstrumentationMeanKey = @"mean";
+NSString *const kTWTOperationInstrumentationP50Key = @"p50";
+NSString *const kTWTOperationInstrumentationP90Key = @"p90";
+NSString *const kTWTOperationInstrumentationP99Key = @"p99";
+NSString *const kTWTOperationInstrumentationP999Key = @"p999";
+
+
+// Values below 2^kSubBucketBits nanoseconds get a bucket each. Above that, every power of two is split into
+// 2^kSubBucketBits buckets, up to 2^kMaximumExponent nanoseconds.
+enum {
+    kTWTLatencyHistogramSubBucketBits = 4,
+    kTWTLatencyHistogramSubBucketCount = 1 << kTWTLatencyHistogramSubBucketBits,
+    kTWTLatencyHistogramMaximumExponent = 40,
+    kTWTLatencyHistogramBucketCount = (kTWTLatencyHistogramMaximumExponent - kTWTLatencyHistogramSubBucketBits + 1) * kTWTLatencyHistogramSubBucketCount
+};
+
+
+/*!
+ TWTLatencyHistogram is a log-linear histogram of nanosecond values. Each histogram has a single writer, so values are
+ updated with relaxed loads and stores rather than read-modify-write operations; readers may observe a histogram
+ mid-update, which only affects the most recent value.
+ */
+typedef struct {
+    _Atomic(uint64_t) counts[kTWTLatencyHistogramBucketCount];
+    _Atomic(uint64_t) totalCount;
+    _Atomic(uint64_t) sum;
+    _Atomic(uint64_t) minimum;
+    _Atomic(uint64_t) maximum;
+} TWTLatencyHistogram;
+
+
+static inline NSUInteger TWTLatencyHistogramBucketIndex(uint64_t value)
+{
+    if (value < kTWTLatencyHistogramSubBucketCount) {
+        return (NSUInteger)value;
+    }
+
+    NSUInteger exponent = 63 - __builtin_clzll(value);
+    if (exponent >= kTWTLatencyHistogramMaximumExponent) {
+        return kTWTLatencyHistogramBucketCount - 1;
+    }
+
+    // The top kSubBucketBits + 1 bits of the value, which are in [2^kSubBucketBits, 2^(kSubBucketBits + 1))
+    uint64_t mantissa = value >> (exponent - kTWTLatencyHistogramSubBucketBits);
+    return (exponent - kTWTLatencyHistogramSubBucketBits + 1) * kTWTLatencyHistogramSubBucketCount
+            + (NSUInteger)(mantissa - kTWTLatencyHistogramSubBucketCount);
+}
+
+
+static inline uint64_t TWTLatencyHistogramBucketHighestValue(NSUInteger index)
+{
+    if (index < kTWTLatencyHistogramSubBucketCount) {
+        return index;
+    }
+
+    NSUInteger shift = index / kTWTLatencyHistogramSubBucketCount - 1;
+    uint64_t mantissa = index % kTWTLatencyHistogramSubBucketCount + kTWTLatencyHistogramSubBucketCount;
+    return ((mantissa + 1) << shift) - 1;
+}
+
+
+static void TWTLatencyHistogramInit(TWTLatencyHistogram *histogram)
+{
+    for (NSUInteger i = 0; i < kTWTLatencyHistogramBucketCount; ++i) {
+        atomic_init(&histogram->counts[i], 0);
+    }
+
+    atomic_init(&histogram->totalCount, 0);
+    atomic_init(&histogram->sum, 0);
+    atomic_init(&histogram->minimum, UINT64_MAX);
+    atomic_init(&histogram->maximum, 0);
+}
+
+
+static void TWTLatencyHistogramRecordValue(TWTLatencyHistogram *histogram, uint64_t value)
+{
+    _Atomic(uint64_t) *count = &histogram->counts[TWTLatencyHistogramBucketIndex(value)];
+    atomic_store_explicit(count, atomic_load_explicit(count, memory_order_relaxed) + 1, memory_order_relaxed);
+
+    atomic_store_explicit(&histogram->sum, atomic_load_explicit(&histogram->sum, memory_order_relaxed) + value,
+                          memory_order_relaxed);
+
+    if (value < atomic_load_explicit(&histogram->minimum, memory_order_relaxed)) {
+        atomic_store_explicit(&histogram->minimum, value, memory_order_relaxed);
+    }
+
+    if (value > atomic_load_explicit(&histogram->maximum, memory_order_relaxed)) {
+        atomic_store_explicit(&histogram->maximum, value, memory_order_relaxed);
+    }
+
+    // Publish the total last so that readers never see more values than have been bucketed
+    atomic_store_explicit(&histogram->totalCount, atomic_load_explicit(&histogram->totalCount, memory_order_relaxed) + 1,
+                          memory_order_release);
+}
+
+
+#pragma mark - Recorders
+
+/*!
+ TWTOperationLatencyRecorder holds the histograms for a single label on a single thread. Recorders are created for a
+ particular generation; resetting instrumentation starts a new generation, and threads replace their recorders the
+ next time they record.
+ */
+@interface TWTOperationLatencyRecorder : NSObject {
+@public
+    NSString *_label;
+    NSUInteger _generation;
+    TWTLatencyHistogram _queueWaitTime;
+    TWTLatencyHistogram _runTime;
+}
+
+@end
+
+
+@implementation TWTOperationLatencyRecorder
+
+- (instancetype)initWithLabel:(NSString *)label generation:(NSUInteger)generation
+{
+    self = [super init];
+    if (self) {
+        _label = [label copy];
+        _generation = generation;
+        TWTLatencyHistogramInit(&_queueWaitTime);
+        TWTLatencyHistogramInit(&_runTime);
+    }
+    return self;
+}
+
+@end
+
+
+#pragma mark - Recording
+
+_Atomic(bool) TWTOperationInstrumentationEnabled = false;
+
+static _Atomic(NSUInteger) TWTOperationInstrumentationGeneration = 0;
+
+// Guards TWTOperationInstrumentationRecorders, which contains every recorder of the current generation
+static pthread_mutex_t TWTOperationInstrumentationRecordersLock = PTHREAD_MUTEX_INITIALIZER;
+static NSMutableArray<TWTOperationLatencyRecorder *> *TWTOperationInstrumentationRecorders = nil;
+
+static NSString *const kTWTOperationInstrumentationThreadRecordersKey = @"TWTOperationInstrumentation.recorders";
+
+
+static uint64_t TWTOperationInstrumentationNanosecondsFromTime(uint64_t time)
+{
+    static mach_timebase_info_data_t timebaseInfo;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        mach_timebase_info(&timebaseInfo);
+    });
+
+    return time * timebaseInfo.numer / timebaseInfo.denom;
+}
+
+
+uint64_t TWTOperationInstrumentationCurrentTime(void)
+{
+    return mach_absolute_time();
+}
+
+
+static TWTOperationLatencyRecorder *TWTOperationInstrumentationCurrentThreadRecorder(NSString *label)
+{
+    NSMutableDictionary *threadDictionary = [[NSThread currentThread] threadDictionary];
+    NSMutableDictionary<NSString *, TWTOperationLatencyRecorder *> *recorders = threadDictionary[kTWTOperationInstrumentationThreadRecordersKey];
+    if (!recorders) {
+        recorders = [[NSMutableDictionary alloc] init];
+        threadDictionary[kTWTOperationInstrumentationThreadRecordersKey] = recorders;
+    }
+
+    NSUInteger generation = atomic_load_explicit(&TWTOperationInstrumentationGeneration, memory_order_acquire);
+    TWTOperationLatencyRecorder *recorder = recorders[label];
+    if (recorder && recorder->_generation == generation) {
+        return recorder;
+    }
+
+    recorder = [[TWTOperationLatencyRecorder alloc] initWithLabel:label generation:generation];
+    recorders[label] = recorder;
+
+    pthread_mutex_lock(&TWTOperationInstrumentationRecordersLock);
+    // If a reset happened in the meantime, this recorder will be replaced on the next recording anyway
+    if (generation == atomic_load_explicit(&TWTOperationInstrumentationGeneration, memory_order_relaxed)) {
+        if (!TWTOperationInstrumentationRecorders) {
+            TWTOperationInstrumentationRecorders = [[NSMutableArray alloc] init];
+        }
+
+        [TWTOperationInstrumentationRecorders addObject:recorder];
+    }
+    pthread_mutex_unlock(&TWTOperationInstrumentationRecordersLock);
+
+    return recorder;
+}
+
+
+void TWTOperationInstrumentationRecord(NSString *label, uint64_t readyTime, uint64_t startTime, uint64_t finishTime)
+{
+    TWTOperationLatencyRecorder *recorder = TWTOperationInstrumentationCurrentThreadRecorder(label);
+
+    if (readyTime != 0 && readyTime <= startTime) {
+        TWTLatencyHistogramRecordValue(&recorder->_queueWaitTime, TWTOperationInstrumentationNanosecondsFromTime(startTime - readyTime));
+    }
+
+    if (startTime <= finishTime) {
+        TWTLatencyHistogramRecordValue(&recorder->_runTime, TWTOperationInstrumentationNanosecondsFromTime(finishTime - startTime));
+    }
+}
+
+
+#pragma mark - Snapshots
+
+/*!
+ TWTLatencyHistogramSnapshot accumulates the histograms of every thread for a single label and metric.
+ */
+typedef struct {
+    uint64_t counts[kTWTLatencyHistogramBucketCount];
+    uint64_t totalCount;
+    uint64_t sum;
+    uint64_t minimum;
+    uint64_t maximum;
+} TWTLatencyHistogramSnapshot;
+
+
+static void TWTLatencyHistogramSnapshotAddHistogram(TWTLatencyHistogramSnapshot *snapshot, TWTLatencyHistogram *histogram)
+{
+    uint64_t totalCount = atomic_load_explicit(&histogram->totalCount, memory_order_acquire);
+    if (totalCount == 0) {
+        return;
+    }
+
+    for (NSUInteger i = 0; i < kTWTLatencyHistogramBucketCount; ++i) {
+        snapshot->counts[i] += atomic_load_explicit(&histogram->counts[i], memory_order_relaxed);
+    }
+
+    snapshot->totalCount += totalCount;
+    snapshot->sum += atomic_load_explicit(&histogram->sum, memory_order_relaxed);
+    snapshot->minimum = MIN(snapshot->minimum, atomic_load_explicit(&histogram->minimum, memory_order_relaxed));
+    snapshot->maximum = MAX(snapshot->maximum, atomic_load_explicit(&histogram->maximum, memory_order_relaxed));
+}
+
+
+static NSDictionary<NSString *, NSNumber *> *TWTLatencyHistogramSnapshotStatistics(TWTLatencyHistogramSnapshot *snapshot)
+{
+    if (snapshot->totalCount == 0) {
+        return @{ kTWTOperationInstrumentationCountKey : @0 };
+    }
+
+    static const double percentiles[] = { 0.5, 0.9, 0.99, 0.999 };
+    NSString *const percentileKeys[] = { kTWTOperationInstrumentationP50Key, kTWTOperationInstrumentationP90Key,
+                                         kTWTOperationInstrumentationP99Key, kTWTOperationInstrumentationP999Key };
+    const NSUInteger percentileCount = sizeof(percentiles) / sizeof(percentiles[0]);
+
+    NSMutableDictionary<NSString *, NSNumber *> *statistics = [[NSMutableDictionary alloc] initWithCapacity:percentileCount + 4];
+    statistics[kTWTOperationInstrumentationCountKey] = @(snapshot->totalCount);
+    statistics[kTWTOperationInstrumentationMinimumKey] = @(snapshot->minimum / (double)NSEC_PER_SEC);
+    statistics[kTWTOperationInstrumentationMaximumKey] = @(snapshot->maximum / (double)NSEC_PER_SEC);
+    statistics[kTWTOperationInstrumentationMeanKey] = @(snapshot->sum / (double)snapshot->totalCount / NSEC_PER_SEC);
+
+    // Walk the buckets once, reporting each percentile as the highest value equivalent to the bucket it falls in
+    uint64_t cumulativeCount = 0;
+    NSUInteger percentileIndex = 0;
+    for (NSUInteger i = 0; i < kTWTLatencyHistogramBucketCount && percentileIndex < percentileCount; ++i) {
+        cumulativeCount += snapshot->counts[i];
+        while (percentileIndex < percentileCount && cumulativeCount >= ceil(percentiles[percentileIndex] * snapshot->totalCount)) {
+            uint64_t value = MIN(TWTLatencyHistogramBucketHighestValue(i), snapshot->maximum);
+            statistics[percentileKeys[percentileIndex]] = @(value / (double)NSEC_PER_SEC);
+            ++percentileIndex;
+        }
+    }
+
+    // Counts that were bucketed but not yet published can leave the highest percentiles unassigned
+    for (; percentileIndex < percentileCount; ++percentileIndex) {
+        statistics[percentileKeys[percentileIndex]] = statistics[kTWTOperationInstrumentationMaximumKey];
+    }
+
+    return statistics;
+}
+
+
+#pragma mark -
+
+@implementation TWTOperationInstrumentation
+
++ (BOOL)isEnabled
+{
+    return atomic_load(&TWTOperationInstrumentationEnabled);
+}
+
+
++ (void)setEnabled:(BOOL)enabled
+{
+    atomic_store(&TWTOperationInstrumentationEnabled, enabled);
+}
+
+
++ (NSDictionary<NSString *, NSDictionary<NSString *, NSDictionary<NSString *, NSNumber *> *> *> *)snapshot
+{
+    pthread_mutex_lock(&TWTOperationInstrumentationRecordersLock);
+    NSArray<TWTOperationLatencyRecorder *> *recorders = [TWTOperationInstrumentationRecorders copy];
+    pthread_mutex_unlock(&TWTOperationInstrumentationRecordersLock);
+
+    NSMutableDictionary<NSString *, NSMutableArray<TWTOperationLatencyRecorder *> *> *recordersByLabel = [[NSMutableDictionary alloc] init];
+    for (TWTOperationLatencyRecorder *recorder in recorders) {
+        NSMutableArray<TWTOperationLatencyRecorder *> *labelRecorders = recordersByLabel[recorder->_label];
+        if (!labelRecorders) {
+            labelRecorders = [[NSMutableArray alloc] init];
+            recordersByLabel[recorder->_label] = labelRecorders;
+        }
+
+        [labelRecorders addObject:recorder];
+    }
+
+    NSMutableDictionary *snapshot = [[NSMutableDictionary alloc] initWithCapacity:recordersByLabel.count];
+    TWTLatencyHistogramSnapshot *queueWaitTime = malloc(sizeof(TWTLatencyHistogramSnapshot));
+    TWTLatencyHistogramSnapshot *runTime = malloc(sizeof(TWTLatencyHistogramSnapshot));
+
+    for (NSString *label in recordersByLabel) {
+        memset(queueWaitTime, 0, sizeof(TWTLatencyHistogramSnapshot));
+        memset(runTime, 0, sizeof(TWTLatencyHistogramSnapshot));
+        queueWaitTime->minimum = UINT64_MAX;
+        runTime->minimum = UINT64_MAX;
+
+        for (TWTOperationLatencyRecorder *recorder in recordersByLabel[label]) {
+            TWTLatencyHistogramSnapshotAddHistogram(queueWaitTime, &recorder->_queueWaitTime);
+            TWTLatencyHistogramSnapshotAddHistogram(runTime, &recorder->_runTime);
+        }
+
+        snapshot[label] = @{ kTWTOperationInstrumentationQueueWaitTimeKey : TWTLatencyHistogramSnapshotStatistics(queueWaitTime),
+                             kTWTOperationInstrumentationRunTimeKey : TWTLatencyHistogramSnapshotStatistics(runTime) };
+    }
+
+    free(queueWaitTime);
+    free(runTime);
+
+    return snapshot;
+}
+
+
++ (NSData *)snapshotJSONDataWithError:(NSError *__autoreleasing *)error
+{
+    return [NSJSONSerialization dataWithJSONObject:[self snapshot] options:NSJSONWritingPrettyPrinted error:error];
+}
+
+
++ (void)reset
+{
+    pthread_mutex_lock(&TWTOperationInstrumentationRecordersLock);
+    atomic_fetch_add_explicit(&TWTOperationInstrumentationGeneration, 1, memory_order_release);
+    [TWTOperationInstrumentationRecorders removeAllObjects];
+    pthread_mutex_unlock(&TWTOperationInstrumentationRecordersLock);
+}
+
+@end
@@ -0,0 +1,106 @@
+//
+//  TWTTimerWheel.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TWTTimerWheelTimers are returned by TWTTimerWheel when a timer is scheduled. They serve as handles with which the
+ timer can be cancelled.
+ */
+@interface TWTTimerWheelTimer : NSObject
+
+/*!
+ @abstract Cancels the timer if it has not yet fired.
+ @discussion This is equivalent to sending ‑cancelTimer: to the timer’s wheel.
+ @result Whether the timer was cancelled. Returns NO if the timer already fired or was already cancelled.
+ */
+- (BOOL)cancel;
+
+@end
+
+
+/*!
+ TWTTimerWheels schedule large numbers of timers cheaply. Timers are stored in a hierarchical timing wheel: four levels
+ of 64 slots each, where every level’s slots span 64 times as many ticks as the level below it. Scheduling and 
+ cancelling a timer are O(1) and allocate nothing beyond the timer handle itself, and cancelled timers are removed 
+ immediately rather than lingering until their fire date. 
+ 
+ A single thread per wheel drives every expiration. The thread sleeps until the next tick that has timers in it, and 
+ does not wake up at all while the wheel is empty. Timer blocks are invoked on this thread, so they should be short; 
+ longer work should be dispatched elsewhere.
+ 
+ Timers fire no earlier than requested, and at most one tick late plus scheduling latency. Timers further out than 
+ the wheel’s range (2^24 ticks) are parked in the top level and rescheduled as the wheel turns.
+ */
+@interface TWTTimerWheel : NSObject
+
+/*! The duration of a single tick of the wheel, which is the resolution of its timers. */
+@property (nonatomic, assign, readonly) NSTimeInterval tickInterval;
+
+/*! The number of timers that are scheduled and have not yet fired or been cancelled. */
+@property (nonatomic, assign, readonly) NSUInteger timerCount;
+
+/*!
+ @abstract Returns the shared timer wheel, which has a tick interval of 10 milliseconds.
+ @result The shared timer wheel.
+ */
++ (TWTTimerWheel *)sharedTimerWheel;
+
+/*!
+ @abstract Initializes a newly created timer wheel with a 10 millisecond tick interval.
+ @result An initialized timer wheel.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created timer wheel with the specified tick interval.
+ @param tickInterval The duration of a single tick. Must be positive.
+ @result An initialized timer wheel.
+ */
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Schedules a block to be invoked after the specified time interval.
+ @param timeInterval The time interval after which to invoke the block. Non-positive intervals fire on the next tick.
+ @param block The block to invoke. May not be nil.
+ @result A handle for the scheduled timer.
+ */
+- (TWTTimerWheelTimer *)scheduleTimerWithTimeInterval:(NSTimeInterval)timeInterval block:(dispatch_block_t)block;
+
+/*!
+ @abstract Cancels the specified timer if it has not yet fired.
+ @param timer The timer to cancel. May not be nil.
+ @result Whether the timer was cancelled. Returns NO if the timer already fired, was already cancelled, or was not 
+     scheduled on the receiver.
+ */
+- (BOOL)cancelTimer:(TWTTimerWheelTimer *)timer;
+
+@end
+
+NS_ASSUME_NONNULL_END
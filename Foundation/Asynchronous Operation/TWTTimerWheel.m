@@ -0,0 +1,455 @@
+//
+//  TWTTimerWheel.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTTimerWheel.h"
+
+#import <pthread.h>
+
+
+// The wheel has four levels of 64 slots. Level n’s slots each span 64^n ticks, so the wheel covers 2^24 ticks.
+static const NSUInteger kTWTTimerWheelLevelCount = 4;
+static const NSUInteger kTWTTimerWheelSlotBits = 6;
+static const NSUInteger kTWTTimerWheelSlotCount = 1 << kTWTTimerWheelSlotBits;
+static const uint64_t kTWTTimerWheelSlotMask = kTWTTimerWheelSlotCount - 1;
+static const uint64_t kTWTTimerWheelTickRange = (uint64_t)1 << (kTWTTimerWheelSlotBits * kTWTTimerWheelLevelCount);
+
+static const NSTimeInterval kTWTTimerWheelDefaultTickInterval = 0.01;
+
+
+@class TWTTimerWheelDriver;
+
+@interface TWTTimerWheelTimer () {
+@public
+    __weak TWTTimerWheelDriver *_driver;
+    dispatch_block_t _block;
+    uint64_t _expirationTick;
+
+    // The timer’s position in the wheel. Timers in a slot form a doubly linked list so that they can be removed in
+    // constant time. These are all guarded by the driver’s lock.
+    NSUInteger _level;
+    NSUInteger _slot;
+    BOOL _scheduled;
+    TWTTimerWheelTimer *_next;
+    __unsafe_unretained TWTTimerWheelTimer *_previous;
+}
+
+@end
+
+
+#pragma mark -
+
+/*!
+ TWTTimerWheelDriver does the actual work of a TWTTimerWheel. It is a separate object so that the wheel’s thread, which
+ retains the driver, does not keep the wheel itself alive.
+ */
+@interface TWTTimerWheelDriver : NSObject {
+@public
+    NSTimeInterval _tickInterval;
+}
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval;
+- (TWTTimerWheelTimer *)scheduleTimerWithTimeInterval:(NSTimeInterval)timeInterval block:(dispatch_block_t)block;
+- (BOOL)cancelTimer:(TWTTimerWheelTimer *)timer;
+- (NSUInteger)timerCount;
+- (void)stop;
+
+@end
+
+
+@implementation TWTTimerWheelDriver {
+    // Guards every ivar below
+    pthread_mutex_t _lock;
+    pthread_cond_t _condition;
+
+    NSTimeInterval _startTime;
+
+    // Every tick before _nextTick has been processed. Slot positions are relative to this tick.
+    uint64_t _nextTick;
+
+    // The tick at which the driver thread will next wake up. New timers only need to wake it if they expire sooner.
+    uint64_t _wakeTick;
+
+    __strong TWTTimerWheelTimer *_slots[kTWTTimerWheelLevelCount][kTWTTimerWheelSlotCount];
+    NSUInteger _timerCount;
+    BOOL _threadStarted;
+    BOOL _running;
+}
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval
+{
+    self = [super init];
+    if (self) {
+        _tickInterval = tickInterval;
+        _startTime = [[NSProcessInfo processInfo] systemUptime];
+        _wakeTick = UINT64_MAX;
+        _running = YES;
+        pthread_mutex_init(&_lock, NULL);
+        pthread_cond_init(&_condition, NULL);
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_cond_destroy(&_condition);
+    pthread_mutex_destroy(&_lock);
+}
+
+
+- (void)stop
+{
+    pthread_mutex_lock(&_lock);
+    _running = NO;
+    pthread_cond_signal(&_condition);
+    pthread_mutex_unlock(&_lock);
+}
+
+
+- (NSUInteger)timerCount
+{
+    pthread_mutex_lock(&_lock);
+    NSUInteger timerCount = _timerCount;
+    pthread_mutex_unlock(&_lock);
+    return timerCount;
+}
+
+
+- (uint64_t)currentTick
+{
+    NSTimeInterval elapsedTime = [[NSProcessInfo processInfo] systemUptime] - _startTime;
+    return (uint64_t)(elapsedTime / _tickInterval);
+}
+
+
+#pragma mark Scheduling
+
+- (TWTTimerWheelTimer *)scheduleTimerWithTimeInterval:(NSTimeInterval)timeInterval block:(dispatch_block_t)block
+{
+    NSTimeInterval elapsedTime = [[NSProcessInfo processInfo] systemUptime] - _startTime + MAX(timeInterval, 0);
+
+    TWTTimerWheelTimer *timer = [[TWTTimerWheelTimer alloc] init];
+    timer->_driver = self;
+    timer->_block = [block copy];
+    timer->_expirationTick = (uint64_t)ceil(elapsedTime / _tickInterval);
+
+    pthread_mutex_lock(&_lock);
+    if (!_threadStarted) {
+        _threadStarted = YES;
+        NSThread *thread = [[NSThread alloc] initWithTarget:self selector:@selector(run) object:nil];
+        thread.name = [NSString stringWithFormat:@"%@.%p", self.class, self];
+        [thread start];
+    }
+
+    // An empty wheel’s position is meaningless, so fast-forward it instead of making the driver catch up tick by tick
+    if (_timerCount == 0) {
+        _nextTick = MAX(_nextTick, [self currentTick] + 1);
+    }
+
+    [self insertTimer:timer];
+    timer->_scheduled = YES;
+    ++_timerCount;
+
+    if (timer->_expirationTick < _wakeTick) {
+        pthread_cond_signal(&_condition);
+    }
+    pthread_mutex_unlock(&_lock);
+
+    return timer;
+}
+
+
+- (BOOL)cancelTimer:(TWTTimerWheelTimer *)timer
+{
+    pthread_mutex_lock(&_lock);
+    if (timer->_driver != self || !timer->_scheduled) {
+        pthread_mutex_unlock(&_lock);
+        return NO;
+    }
+
+    [self unlinkTimer:timer];
+    timer->_scheduled = NO;
+    --_timerCount;
+
+    // Release the block after unlocking in case releasing it has side effects that involve the wheel
+    dispatch_block_t block = timer->_block;
+    timer->_block = nil;
+    pthread_mutex_unlock(&_lock);
+
+    block = nil;
+    return YES;
+}
+
+
+#pragma mark Wheel Management
+
+// Must be called with the lock held
+- (void)insertTimer:(TWTTimerWheelTimer *)timer
+{
+    uint64_t expirationTick = MAX(timer->_expirationTick, _nextTick);
+    uint64_t delta = expirationTick - _nextTick;
+
+    // Timers past the end of the wheel are parked in the farthest slot and reinserted when that slot is cascaded
+    if (delta >= kTWTTimerWheelTickRange) {
+        expirationTick = _nextTick + kTWTTimerWheelTickRange - 1;
+        delta = kTWTTimerWheelTickRange - 1;
+    }
+
+    NSUInteger level = 0;
+    while (level < kTWTTimerWheelLevelCount - 1 && delta >= ((uint64_t)1 << (kTWTTimerWheelSlotBits * (level + 1)))) {
+        ++level;
+    }
+
+    NSUInteger slot = (NSUInteger)((expirationTick >> (kTWTTimerWheelSlotBits * level)) & kTWTTimerWheelSlotMask);
+
+    timer->_level = level;
+    timer->_slot = slot;
+    timer->_previous = nil;
+    timer->_next = _slots[level][slot];
+    if (timer->_next) {
+        timer->_next->_previous = timer;
+    }
+
+    _slots[level][slot] = timer;
+}
+
+
+// Must be called with the lock held
+- (void)unlinkTimer:(TWTTimerWheelTimer *)timer
+{
+    TWTTimerWheelTimer *next = timer->_next;
+    if (timer->_previous) {
+        timer->_previous->_next = next;
+    } else {
+        _slots[timer->_level][timer->_slot] = next;
+    }
+
+    if (next) {
+        next->_previous = timer->_previous;
+    }
+
+    timer->_next = nil;
+    timer->_previous = nil;
+}
+
+
+// Must be called with the lock held. Moves every timer in the current slot of the specified level into lower levels
+// and returns the index of that slot.
+- (NSUInteger)cascadeLevel:(NSUInteger)level
+{
+    NSUInteger slot = (NSUInteger)((_nextTick >> (kTWTTimerWheelSlotBits * level)) & kTWTTimerWheelSlotMask);
+
+    TWTTimerWheelTimer *timer = _slots[level][slot];
+    _slots[level][slot] = nil;
+
+    while (timer) {
+        TWTTimerWheelTimer *next = timer->_next;
+        [self insertTimer:timer];
+        timer = next;
+    }
+
+    return slot;
+}
+
+
+// Must be called with the lock held. Processes every tick up to and including the specified tick and returns the
+// timers that expired.
+- (NSMutableArray<TWTTimerWheelTimer *> *)advanceToTick:(uint64_t)tick
+{
+    NSMutableArray<TWTTimerWheelTimer *> *expiredTimers = [[NSMutableArray alloc] init];
+
+    while (_nextTick <= tick) {
+        // Every 64 ticks, bring the next slot of level 1 down into level 0, and so on up the levels
+        if ((_nextTick & kTWTTimerWheelSlotMask) == 0) {
+            for (NSUInteger level = 1; level < kTWTTimerWheelLevelCount; ++level) {
+                if ([self cascadeLevel:level] != 0) {
+                    break;
+                }
+            }
+        }
+
+        NSUInteger slot = (NSUInteger)(_nextTick & kTWTTimerWheelSlotMask);
+        TWTTimerWheelTimer *timer = _slots[0][slot];
+        _slots[0][slot] = nil;
+
+        while (timer) {
+            TWTTimerWheelTimer *next = timer->_next;
+            timer->_next = nil;
+            timer->_previous = nil;
+            timer->_scheduled = NO;
+            [expiredTimers addObject:timer];
+            timer = next;
+        }
+
+        ++_nextTick;
+    }
+
+    _timerCount -= expiredTimers.count;
+    return expiredTimers;
+}
+
+
+#pragma mark Driver Thread
+
+- (void)run
+{
+    pthread_mutex_lock(&_lock);
+    while (_running) {
+        if (_timerCount == 0) {
+            _wakeTick = UINT64_MAX;
+            pthread_cond_wait(&_condition, &_lock);
+            continue;
+        }
+
+        uint64_t currentTick = [self currentTick];
+        if (_nextTick <= currentTick) {
+            NSMutableArray<TWTTimerWheelTimer *> *expiredTimers = [self advanceToTick:currentTick];
+            if (expiredTimers.count == 0) {
+                continue;
+            }
+
+            pthread_mutex_unlock(&_lock);
+            @autoreleasepool {
+                for (TWTTimerWheelTimer *timer in expiredTimers) {
+                    dispatch_block_t block = timer->_block;
+                    timer->_block = nil;
+                    block();
+                }
+            }
+            pthread_mutex_lock(&_lock);
+            continue;
+        }
+
+        // Sleep until the next tick with timers in it, or until the next cascade, whichever comes first
+        uint64_t wakeTick = _nextTick;
+        while ((wakeTick & kTWTTimerWheelSlotMask) != 0 && !_slots[0][wakeTick & kTWTTimerWheelSlotMask]) {
+            ++wakeTick;
+        }
+
+        _wakeTick = wakeTick;
+        NSTimeInterval wakeTime = _startTime + wakeTick * _tickInterval;
+        NSTimeInterval sleepInterval = MAX(wakeTime - [[NSProcessInfo processInfo] systemUptime], 0);
+
+        // Wait for a relative interval rather than until a wall-clock deadline, so that changes to the system clock
+        // don’t make the driver oversleep or spin
+        double wholeSeconds = floor(sleepInterval);
+        struct timespec sleepTimespec = { (time_t)wholeSeconds, (long)((sleepInterval - wholeSeconds) * NSEC_PER_SEC) };
+        pthread_cond_timedwait_relative_np(&_condition, &_lock, &sleepTimespec);
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+@end
+
+
+#pragma mark -
+
+@implementation TWTTimerWheelTimer
+
+- (BOOL)cancel
+{
+    TWTTimerWheelDriver *driver = _driver;
+    return [driver cancelTimer:self];
+}
+
+@end
+
+
+#pragma mark -
+
+@implementation TWTTimerWheel {
+    TWTTimerWheelDriver *_driver;
+}
+
++ (TWTTimerWheel *)sharedTimerWheel
+{
+    static TWTTimerWheel *sharedTimerWheel = nil;
+    static dispatch_once_t onceToken;
+    dispatch_once(&onceToken, ^{
+        sharedTimerWheel = [[TWTTimerWheel alloc] init];
+    });
+
+    return sharedTimerWheel;
+}
+
+
+- (instancetype)init
+{
+    return [self initWithTickInterval:kTWTTimerWheelDefaultTickInterval];
+}
+
+
+- (instancetype)initWithTickInterval:(NSTimeInterval)tickInterval
+{
+    NSParameterAssert(tickInterval > 0);
+
+    self = [super init];
+    if (self) {
+        _driver = [[TWTTimerWheelDriver alloc] initWithTickInterval:tickInterval];
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    [_driver stop];
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p tickInterval=%g timerCount=%lu>",
+            self.class, self, self.tickInterval, (unsigned long)self.timerCount];
+}
+
+
+- (NSTimeInterval)tickInterval
+{
+    return _driver->_tickInterval;
+}
+
+
+- (NSUInteger)timerCount
+{
+    return [_driver timerCount];
+}
+
+
+- (TWTTimerWheelTimer *)scheduleTimerWithTimeInterval:(NSTimeInterval)timeInterval block:(dispatch_block_t)block
+{
+    NSParameterAssert(block);
+    return [_driver scheduleTimerWithTimeInterval:timeInterval block:block];
+}
+
+
+- (BOOL)cancelTimer:(TWTTimerWheelTimer *)timer
+{
+    NSParameterAssert(timer);
+    return [_driver cancelTimer:timer];
+}
+
+@end
@@ -0,0 +1,101 @@
+//
+//  NSDictionary+TWTKeyPathFlattening.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ @abstract Specifies how key-path flattening handles two leaves that produce the same key path.
+ @discussion Distinct leaves only collide when keys contain the separator, e.g., the leaves of { "a.b" : 1 } and 
+     { "a" : { "b" : 2 } } both have the key path "a.b". Dictionaries have no inherent order, so “first” and “last”
+     refer to the order in which the receiver is enumerated.
+ */
+typedef NS_ENUM(NSUInteger, TWTKeyPathFlatteningCollisionPolicy) {
+    /*! The value of the first leaf enumerated is kept. */
+    TWTKeyPathFlatteningCollisionPolicyKeepFirst,
+
+    /*! The value of the last leaf enumerated is kept. This is how ‑twt_flatten handles collisions. */
+    TWTKeyPathFlatteningCollisionPolicyKeepLast,
+
+    /*!
+     The values of every colliding leaf are collected into an array in the order they were enumerated. Key paths
+     without collisions keep their values as is.
+     */
+    TWTKeyPathFlatteningCollisionPolicyCollect
+};
+
+
+/*!
+ The TWTKeyPathFlattening category on NSDictionary converts nested dictionaries to and from flat dictionaries whose 
+ keys are key paths. Unlike ‑twt_flatten, which discards the keys of child dictionaries, key-path flattening preserves
+ the location of every leaf, e.g., { "a" : { "b" : { "c" : 1 } }, "d" : 2 } flattens to { "a.b.c" : 1, "d" : 2 }. This
+ makes it easy to diff nested configuration payloads.
+ 
+ Flattening walks the receiver iteratively and builds key paths in a single reusable buffer, so no string is created
+ for a key path until a leaf is reached. Keys that are not strings are converted using their descriptions. Empty 
+ child dictionaries are treated as leaves so that they survive a round trip.
+ */
+@interface NSDictionary (TWTKeyPathFlattening)
+
+/*!
+ @abstract Returns a flat dictionary whose keys are the dot-separated key paths of the receiver’s leaves.
+ @discussion This is equivalent to invoking ‑twt_keyPathFlattenedDictionaryWithSeparator:collisionPolicy: with "." 
+     and TWTKeyPathFlatteningCollisionPolicyKeepLast.
+ @result A flat dictionary of key paths to leaf values.
+ */
+- (NSDictionary<NSString *, id> *)twt_keyPathFlattenedDictionary;
+
+/*!
+ @abstract Returns a flat dictionary whose keys are the key paths of the receiver’s leaves.
+ @param separator The string that separates keys in a key path. May not be nil or empty.
+ @param collisionPolicy How to handle leaves that produce the same key path.
+ @result A flat dictionary of key paths to leaf values.
+ */
+- (NSDictionary<NSString *, id> *)twt_keyPathFlattenedDictionaryWithSeparator:(NSString *)separator
+                                                               collisionPolicy:(TWTKeyPathFlatteningCollisionPolicy)collisionPolicy;
+
+/*!
+ @abstract Returns a nested dictionary built from the receiver’s dot-separated key paths.
+ @discussion This is equivalent to invoking ‑twt_keyPathUnflattenedDictionaryWithSeparator: with ".".
+ @result A nested dictionary.
+ */
+- (NSDictionary *)twt_keyPathUnflattenedDictionary;
+
+/*!
+ @abstract Returns a nested dictionary built from the receiver’s key paths.
+ @discussion This is the inverse of ‑twt_keyPathFlattenedDictionaryWithSeparator:collisionPolicy:. The tree is built
+     in a single pass over the receiver. If one key path is a prefix of another, e.g., "a" and "a.b", the child 
+     dictionary takes precedence and the value of the shorter key path is discarded.
+ @param separator The string that separates keys in a key path. May not be nil or empty.
+ @result A nested dictionary.
+ */
+- (NSDictionary *)twt_keyPathUnflattenedDictionaryWithSeparator:(NSString *)separator;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,162 @@
+//
+//  NSDictionary+TWTKeyPathFlattening.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "NSDictionary+TWTKeyPathFlattening.h"
+
+
+static NSString *const kTWTKeyPathFlatteningDefaultSeparator = @".";
+
+
+@implementation NSDictionary (TWTKeyPathFlattening)
+
+- (NSDictionary *)twt_keyPathFlattenedDictionary
+{
+    return [self twt_keyPathFlattenedDictionaryWithSeparator:kTWTKeyPathFlatteningDefaultSeparator
+                                             collisionPolicy:TWTKeyPathFlatteningCollisionPolicyKeepLast];
+}
+
+
+- (NSDictionary *)twt_keyPathFlattenedDictionaryWithSeparator:(NSString *)separator
+                                              collisionPolicy:(TWTKeyPathFlatteningCollisionPolicy)collisionPolicy
+{
+    NSParameterAssert(separator.length > 0);
+
+    NSMutableDictionary *flattenedDictionary = [[NSMutableDictionary alloc] initWithCapacity:self.count];
+    NSMutableSet *collectedKeyPaths = nil;
+
+    // The key path of the current leaf is built in a single buffer. Each level of the stack records the length of its
+    // dictionary’s key path so that the buffer can be truncated back to it before appending the next key.
+    NSMutableString *keyPathBuffer = [[NSMutableString alloc] init];
+    NSMutableArray *dictionaries = [[NSMutableArray alloc] initWithObjects:self, nil];
+    NSMutableArray *keyEnumerators = [[NSMutableArray alloc] initWithObjects:[self keyEnumerator], nil];
+    NSMutableArray *keyPathLengths = [[NSMutableArray alloc] initWithObjects:@0, nil];
+
+    while (dictionaries.count > 0) {
+        id key = [keyEnumerators.lastObject nextObject];
+        if (!key) {
+            [dictionaries removeLastObject];
+            [keyEnumerators removeLastObject];
+            [keyPathLengths removeLastObject];
+            continue;
+        }
+
+        NSUInteger keyPathLength = [keyPathLengths.lastObject unsignedIntegerValue];
+        [keyPathBuffer deleteCharactersInRange:NSMakeRange(keyPathLength, keyPathBuffer.length - keyPathLength)];
+        if (dictionaries.count > 1) {
+            [keyPathBuffer appendString:separator];
+        }
+
+        [keyPathBuffer appendString:[key isKindOfClass:[NSString class]] ? key : [key description]];
+
+        id value = [dictionaries.lastObject objectForKey:key];
+        if ([value isKindOfClass:[NSDictionary class]] && [value count] > 0) {
+            [dictionaries addObject:value];
+            [keyEnumerators addObject:[value keyEnumerator]];
+            [keyPathLengths addObject:@(keyPathBuffer.length)];
+            continue;
+        }
+
+        // Only now that we’ve reached a leaf do we create a string for its key path
+        NSString *keyPath = [keyPathBuffer copy];
+        id existingValue = flattenedDictionary[keyPath];
+        if (!existingValue) {
+            flattenedDictionary[keyPath] = value;
+            continue;
+        }
+
+        switch (collisionPolicy) {
+            case TWTKeyPathFlatteningCollisionPolicyKeepFirst:
+                break;
+            case TWTKeyPathFlatteningCollisionPolicyKeepLast:
+                flattenedDictionary[keyPath] = value;
+                break;
+            case TWTKeyPathFlatteningCollisionPolicyCollect:
+                if ([collectedKeyPaths containsObject:keyPath]) {
+                    [existingValue addObject:value];
+                } else {
+                    if (!collectedKeyPaths) {
+                        collectedKeyPaths = [[NSMutableSet alloc] init];
+                    }
+
+                    [collectedKeyPaths addObject:keyPath];
+                    flattenedDictionary[keyPath] = [[NSMutableArray alloc] initWithObjects:existingValue, value, nil];
+                }
+                break;
+        }
+    }
+
+    return flattenedDictionary;
+}
+
+
+- (NSDictionary *)twt_keyPathUnflattenedDictionary
+{
+    return [self twt_keyPathUnflattenedDictionaryWithSeparator:kTWTKeyPathFlatteningDefaultSeparator];
+}
+
+
+- (NSDictionary *)twt_keyPathUnflattenedDictionaryWithSeparator:(NSString *)separator
+{
+    NSParameterAssert(separator.length > 0);
+
+    NSMutableDictionary *unflattenedDictionary = [[NSMutableDictionary alloc] init];
+
+    // The dictionaries we create for intermediate keys, as opposed to leaf values that happen to be dictionaries
+    NSHashTable *nodes = [NSHashTable hashTableWithOptions:NSPointerFunctionsObjectPointerPersonality];
+    [nodes addObject:unflattenedDictionary];
+
+    [self enumerateKeysAndObjectsUsingBlock:^(id keyPathKey, id value, BOOL *stop) {
+        NSString *keyPath = [keyPathKey isKindOfClass:[NSString class]] ? keyPathKey : [keyPathKey description];
+        NSMutableDictionary *node = unflattenedDictionary;
+
+        NSUInteger location = 0;
+        NSRange separatorRange = [keyPath rangeOfString:separator options:NSLiteralSearch];
+        while (separatorRange.location != NSNotFound) {
+            NSString *key = [keyPath substringWithRange:NSMakeRange(location, separatorRange.location - location)];
+            NSMutableDictionary *childNode = node[key];
+            if (!childNode || ![nodes containsObject:childNode]) {
+                childNode = [[NSMutableDictionary alloc] init];
+                [nodes addObject:childNode];
+                node[key] = childNode;
+            }
+
+            node = childNode;
+            location = NSMaxRange(separatorRange);
+            separatorRange = [keyPath rangeOfString:separator options:NSLiteralSearch range:NSMakeRange(location, keyPath.length - location)];
+        }
+
+        // Child dictionaries take precedence over values whose key paths are prefixes of other key paths
+        NSString *key = [keyPath substringFromIndex:location];
+        id existingValue = node[key];
+        if (!existingValue || ![nodes containsObject:existingValue]) {
+            node[key] = value;
+        }
+    }];
+
+    return unflattenedDictionary;
+}
+
+@end
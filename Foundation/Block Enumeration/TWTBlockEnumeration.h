@@ -65,6 +65,30 @@ typedef BOOL (^TWTBlockEnumerationPredicateBlock)(id element);
  */
 typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
 
+/*!
+ @abstract Type for blocks that, when given an element, return the key by which it should be sorted.
+ @discussion This block type is used for sort and top-k operations. Keys are compared using ‑compare:, so every key
+    returned for a collection must be comparable with every other, e.g., all NSNumbers or all NSStrings.
+ @param element The element being enumerated.
+ @result The element’s sort key. May not be nil.
+ */
+typedef id _Nonnull (^TWTBlockEnumerationSortKeyBlock)(id element);
+
+/*!
+ @abstract Options that control how the block enumeration methods enumerate a collection.
+ */
+typedef NS_OPTIONS(NSUInteger, TWTBlockEnumerationOptions) {
+    /*!
+     Elements are enumerated in chunks, each inside its own autorelease pool, so that autoreleased objects created by
+     the block are freed as enumeration proceeds rather than when the enumeration method returns. This bounds the 
+     peak memory use of enumerating very large collections or enumerators with blocks that autorelease temporaries.
+     The number of elements in each chunk adapts to how long the block takes, so that pools are drained every 
+     millisecond or so regardless of the block’s cost.
+     */
+    TWTBlockEnumerationOptionDrainAutoreleasePools = 1 << 0
+};
+
+
 /*! 
  @abstract Protocol that exposes block enumeration methods.
  @discussion The terms used (`Collect`, `Select`, `Inject`, `Detect`, `Reject`) in this class are 
@@ -85,6 +109,43 @@ typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
  */
 - (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block;
 
+/*!
+ @abstract Performs the given block on each element in the collection and adds the results to the specified 
+    collection.
+ @discussion This is like ‑twt_collectWithBlock:, but rather than creating a new collection, it adds the results to 
+    one that the caller supplies. Existing contents of that collection are kept, so a caller that collects 
+    repeatedly can reuse a single collection by removing its objects between uses, avoiding allocating and growing a
+    new collection on every call.
+ @param block The block to invoke against each element of the collection. May not be nil.
+ @param collection The mutable collection to which to add the results, e.g., an NSMutableArray. If the receiver is 
+    a dictionary, this should be a mutable dictionary, in which case each result is set for its key. May not be nil.
+ */
+- (void)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block intoCollection:(id)collection;
+
+/*!
+ @abstract Return a newly created collection that is the result of performing the given block on each element in
+    the original collection, using the specified options.
+ @discussion This is like ‑twt_collectWithBlock:, which is equivalent to invoking this method with no options.
+ @param options The options to use when enumerating the collection.
+ @param block The block to invoke against each element of the collection. May not be nil.
+ @result A new instance of the collection with the results of invoking the block on each element of the original
+    collection.
+ */
+- (id)twt_collectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationCollectBlock)block;
+
+/*!
+ @abstract Returns a dictionary that counts the elements in the collection by the values returned by the block.
+ @discussion This returns the counts of the groups that ‑twt_groupWithBlock: would return, but in a single pass and
+    without building the groups themselves. Given a collection of [2, 3, 6, 7, 9] and a block that returns the
+    element’s integer value modulo 2, this method will return { 0 : 2, 1 : 3 }. If the result of the block is nil,
+    the key in the resulting dictionary will be the NSNull instance. If the collection is a dictionary the item
+    passed to the block is the key.
+ @param block Block that returns the group key that should be used for a given collection element. May not be nil.
+ @result A dictionary whose keys are the return values of the block and whose values are NSNumbers that contain the
+    number of elements for which the block returned that value.
+ */
+- (NSDictionary *)twt_countByBlock:(TWTBlockEnumerationGroupBlock)block;
+
 /*!
  @abstract Return a newly created collection that is the result of flattening each child collection 
     into the top top level element of a single collection.
@@ -99,6 +160,20 @@ typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
  */
 - (id)twt_flatten;
 
+/*!
+ @abstract Return a newly created collection that is the result of flattening child collections up to the
+    specified nesting depth.
+ @discussion This behaves like ‑twt_flatten, which is equivalent to invoking this method with NSUIntegerMax, 
+    except that child collections nested more than maximumDepth levels deep are left intact. Given a collection of 
+    [ [1, [2, 3]], 4 ] and a maximum depth of 1, this would return [1, [2, 3], 4]. A maximum depth of 0 returns a 
+    copy of the receiver. Flattening is iterative and writes directly into the result, so deeply nested collections 
+    neither allocate intermediate collections nor risk overflowing the stack.
+ @param maximumDepth The maximum number of nesting levels to flatten.
+ @result A new instance of the collection with the results of flattening each element into a single 
+    instance of the reciver's class (or an array if the receiver is an NSEnumerator).
+ */
+- (id)twt_flattenWithMaximumDepth:(NSUInteger)maximumDepth;
+
 /*!
  @abstract Passes each entry in the collection to the block and returns the first item for which the 
     block returns YES.
@@ -108,6 +183,19 @@ typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
  */
 - (nullable id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
 
+/*!
+ @abstract Returns a new collection with only the first element in the collection for each distinct value returned
+    by the block.
+ @discussion Values returned by the block are compared using ‑hash and ‑isEqual:, so the block must return objects
+    that are suitable for use as set elements. If the result of the block is nil, the NSNull instance is used
+    instead. Elements of ordered collections keep their relative order. If the collection is a dictionary the item
+    passed to the block is the key, and the result is a dictionary with the entries for the keys that were kept.
+ @param block Block that returns the key by which to compare elements. May not be nil.
+ @result A new instance of the collection (or an array if the receiver is an NSEnumerator) with the first element
+    for each distinct key.
+ */
+- (id)twt_distinctByBlock:(TWTBlockEnumerationGroupBlock)block;
+
 /*!
  @abstract Returns a dictionary that groups elements in the collection by the values returned by the block.
  @discussion Given a collection of [2, 3, 6, 7, 9] and a block that returns the element’s integer value modulo
@@ -122,6 +210,17 @@ typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
  */
 - (NSDictionary *)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block;
 
+/*!
+ @abstract Returns a dictionary that groups elements in the collection by the values returned by the block, using 
+    the specified options.
+ @discussion This is like ‑twt_groupWithBlock:, which is equivalent to invoking this method with no options.
+ @param options The options to use when enumerating the collection.
+ @param block Block that returns the group key that should be used for a given collection element. May not be nil.
+ @result A dictionary whose keys are the return values of the block and whose values are collections of elements
+     for which the block returned that value.
+ */
+- (NSDictionary *)twt_groupWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationGroupBlock)block;
+
 /*!
  @abstract Passes each item in the collection and a memo to the provided block starting with an initial
     object.
@@ -137,6 +236,48 @@ typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
  */
 - (nullable id)twt_injectWithInitialObject:(nullable id)initialObject block:(TWTBlockEnumerationInjectBlock)block;
 
+/*!
+ @abstract Passes each item in the collection and a memo to the provided block starting with an initial object, 
+    using the specified options.
+ @discussion This is like ‑twt_injectWithInitialObject:block:, which is equivalent to invoking this method with no
+    options. When draining autorelease pools, the memo returned by each iteration is retained until the next, so it
+    may safely be autoreleased.
+ @param options The options to use when enumerating the collection.
+ @param initialObject The initial object to pass as a memo to the first iteration of the collection.
+ @param block An inject block that is performed on each element of the collection. May not be nil.
+ @result The final returned value from the last iteration of the collection.
+ */
+- (nullable id)twt_injectWithOptions:(TWTBlockEnumerationOptions)options
+                       initialObject:(nullable id)initialObject
+                               block:(TWTBlockEnumerationInjectBlock)block;
+
+/*!
+ @abstract Passes each item in the collection to the block and returns both the items for which the block returned
+    YES and the items for which it returned NO.
+ @discussion This returns the results of ‑twt_selectWithBlock: and ‑twt_rejectWithBlock: in a single pass, invoking
+    the block only once per item. If the collection is a dictionary the item passed to the block is the key.
+ @param block Predicate block to test items in the collection. May not be nil.
+ @result A two-element array whose first element is a new instance of the collection (or an array if the receiver
+    is an NSEnumerator) with the items that were selected and whose second element is a new instance with the items
+    that were rejected.
+ */
+- (NSArray *)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Passes each item in the collection to the block and adds the items for which the block returned YES to 
+    one collection and the items for which it returned NO to another.
+ @discussion This is like ‑twt_partitionWithBlock:, but adds the items to collections that the caller supplies. 
+    Existing contents of those collections are kept, so they can be reused by removing their objects between uses.
+ @param block Predicate block to test items in the collection. May not be nil.
+ @param selectedCollection The mutable collection to which to add the selected items. If the receiver is a 
+    dictionary, this should be a mutable dictionary. May not be nil.
+ @param rejectedCollection The mutable collection to which to add the rejected items. If the receiver is a
+    dictionary, this should be a mutable dictionary. May not be nil.
+ */
+- (void)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+        intoSelectedCollection:(id)selectedCollection
+            rejectedCollection:(id)rejectedCollection;
+
 /*!
  @abstract Passes each item in the collection to the block and returns a new collection with the items
     that returned YES from the block removed.
@@ -146,6 +287,27 @@ typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
  */
 - (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
 
+/*!
+ @abstract Passes each item in the collection to the block and adds the items for which the block returned NO to 
+    the specified collection.
+ @discussion This is like ‑twt_rejectWithBlock:, but adds the items to a collection that the caller supplies. 
+    Existing contents of that collection are kept, so it can be reused by removing its objects between uses.
+ @param block Predicate block to test items in the collection. May not be nil.
+ @param collection The mutable collection to which to add the items that were not rejected. If the receiver is a
+    dictionary, this should be a mutable dictionary. May not be nil.
+ */
+- (void)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection;
+
+/*!
+ @abstract Passes each item in the collection to the block and returns a new collection with the items that 
+    returned YES from the block removed, using the specified options.
+ @discussion This is like ‑twt_rejectWithBlock:, which is equivalent to invoking this method with no options.
+ @param options The options to use when enumerating the collection.
+ @param block Predicate block to test items in the collection. May not be nil.
+ @result A new instance of a collection with the items that were not rejected.
+ */
+- (id)twt_rejectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block;
+
 /*!
  @abstract Passes each item in the collection to the block and returns a new collection with the items
     for which the block returned YES.
@@ -155,24 +317,198 @@ typedef id _Nullable (^TWTBlockEnumerationInjectBlock)(id memo, id element);
  */
 - (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
 
+/*!
+ @abstract Passes each item in the collection to the block and adds the items for which the block returned YES to 
+    the specified collection.
+ @discussion This is like ‑twt_selectWithBlock:, but adds the items to a collection that the caller supplies. 
+    Existing contents of that collection are kept, so it can be reused by removing its objects between uses.
+ @param block Predicate block to test items in the collection. May not be nil.
+ @param collection The mutable collection to which to add the items that were selected. If the receiver is a
+    dictionary, this should be a mutable dictionary. May not be nil.
+ */
+- (void)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection;
+
+/*!
+ @abstract Passes each item in the collection to the block and returns a new collection with the items for which
+    the block returned YES, using the specified options.
+ @discussion This is like ‑twt_selectWithBlock:, which is equivalent to invoking this method with no options.
+ @param options The options to use when enumerating the collection.
+ @param block Predicate block to test items in the collection. May not be nil.
+ @result A new instance of a collection with the items that were selected.
+ */
+- (id)twt_selectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Returns a uniformly random sample of the elements in the collection.
+ @discussion This is like ‑twt_sampleOfSize:seed:, but uses a random seed, so its result differs from call to call.
+ @param size The maximum number of elements to return.
+ @result A new array of at most size elements chosen at random.
+ */
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size;
+
+/*!
+ @abstract Returns a uniformly random sample of the elements in the collection, chosen using the specified seed.
+ @discussion The sample is chosen with reservoir sampling in a single pass, using O(size) memory, so large 
+    enumerators can be sampled without first being collected into an array. Every subset of size elements is equally
+    likely to be chosen. If the collection has no more than size elements, every element is returned. The random 
+    number generator is fully determined by seed, so the same seed and the same elements in the same enumeration 
+    order always produce the same sample. The order of elements in the result is unspecified. If the collection is a
+    dictionary the result is an array of keys.
+ @param size The maximum number of elements to return.
+ @param seed The seed for the random number generator.
+ @result A new array of at most size elements chosen at random.
+ */
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size seed:(uint64_t)seed;
+
+/*!
+ @abstract Groups the elements in the collection by the values returned by the block and returns a uniformly random
+    sample of each group.
+ @discussion This is like ‑twt_sampleOfSize:groupedByBlock:seed:, but uses a random seed, so its result differs from
+    call to call.
+ @param size The maximum number of elements to return for each group.
+ @param block Block that returns the group key that should be used for a given collection element. May not be nil.
+ @result A dictionary whose keys are the return values of the block and whose values are arrays of at most size
+    elements chosen at random from the elements for which the block returned that value.
+ */
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size groupedByBlock:(TWTBlockEnumerationGroupBlock)block;
+
+/*!
+ @abstract Groups the elements in the collection by the values returned by the block and returns a uniformly random
+    sample of each group, chosen using the specified seed.
+ @discussion This performs stratified sampling: each group is sampled independently with its own reservoir, as 
+    ‑twt_sampleOfSize:seed: samples the whole collection, so rare groups are represented as fully as common ones. It
+    takes a single pass and O(size) memory per group, and invokes the block exactly once per element. Results are 
+    reproducible for the same seed, elements, and enumeration order. If the block returns nil, the element is grouped
+    under NSNull. If the collection is a dictionary the item passed to the block is the key, and the samples are 
+    arrays of keys.
+ @param size The maximum number of elements to return for each group.
+ @param block Block that returns the group key that should be used for a given collection element. May not be nil.
+ @param seed The seed for the random number generator.
+ @result A dictionary whose keys are the return values of the block and whose values are arrays of at most size
+    elements chosen at random from the elements for which the block returned that value.
+ */
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size
+                    groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+                              seed:(uint64_t)seed;
+
+/*!
+ @abstract Returns an array of the elements in the collection sorted in ascending order of the keys returned by the
+    block.
+ @discussion The block is invoked exactly once per element, and the keys are cached for the duration of the sort, 
+    rather than being recomputed for every comparison (the decorate-sort-undecorate pattern). The sort is stable, so 
+    elements of ordered collections with equal keys keep their relative order. Large collections are sorted with a
+    parallel merge sort. If the collection is a dictionary the item passed to the block is the key, and the result is
+    an array of keys.
+ @param block Block that returns the sort key for an element. May not be nil.
+ @result A new array of the collection’s elements in ascending order of their keys.
+ */
+- (NSArray *)twt_sortedByBlock:(TWTBlockEnumerationSortKeyBlock)block;
+
+/*!
+ @abstract Returns an array of the k elements in the collection with the smallest keys returned by the block, in 
+    ascending order of those keys.
+ @discussion This returns the same result as taking the first k elements of ‑twt_sortedByBlock:, but rather than 
+    sorting the whole collection, it keeps the best k elements seen so far in a bounded heap. It thus takes 
+    O(n log k) time and O(k) space, and invokes the block exactly once per element. If the collection is a 
+    dictionary the item passed to the block is the key, and the result is an array of keys.
+ @param k The maximum number of elements to return.
+ @param block Block that returns the sort key for an element. May not be nil.
+ @result A new array of at most k elements in ascending order of their keys.
+ */
+- (NSArray *)twt_topK:(NSUInteger)k byBlock:(TWTBlockEnumerationSortKeyBlock)block;
+
+@end
+
+
+/*!
+ @abstract Protocol that exposes streaming flattening for collections whose flattened form is a sequence of leaves.
+ @discussion Dictionaries flatten by merging child dictionaries’ entries rather than by yielding leaves, so they do 
+    not conform to this protocol.
+ */
+@protocol TWTFlattenedObjectEnumeration <NSObject>
+
+/*!
+ @abstract Returns an enumerator that yields the elements that ‑twt_flattenWithMaximumDepth: would return, one at a
+    time, without materializing the flattened collection.
+ @discussion The enumerator walks the receiver and its child collections with an explicit stack, so each element is
+    produced on demand and enumeration can be abandoned at any point. Neither the receiver nor its child collections
+    may be mutated while the enumerator is in use.
+ @param maximumDepth The maximum number of nesting levels to flatten.
+ @result An enumerator of the flattened elements of the receiver.
+ */
+- (NSEnumerator *)twt_flattenedObjectEnumeratorWithMaximumDepth:(NSUInteger)maximumDepth;
+
 @end
 
 
 #pragma mark
 
-@interface NSArray (TWTBlockEnumeration) <TWTBlockEnumeration>
+@interface NSArray (TWTBlockEnumeration) <TWTBlockEnumeration, TWTFlattenedObjectEnumeration>
+@end
+
+
+/*!
+ The TWTSortedArrays category on NSArray merges and combines arrays that are already sorted. Each method makes a 
+ single linear pass over its inputs, rather than concatenating them and sorting the result. Every input array must
+ be sorted in ascending order according to the comparator; if one is not, the results are undefined.
+ */
+@interface NSArray (TWTSortedArrays)
+
+/*!
+ @abstract Returns an array of the objects in the specified sorted arrays, sorted using the comparator.
+ @discussion The arrays are merged by repeatedly taking the least of their next objects, which are kept in a binary 
+    heap, so merging n objects from k arrays takes O(n log k) comparisons. The merge is stable: objects that compare 
+    equal appear in the order of the arrays that contain them, so the result is the same as that of concatenating the
+    arrays and stably sorting the concatenation.
+ @param arrays The sorted arrays to merge. May not be nil.
+ @param comparator The comparator by which each of the arrays is sorted. May not be nil.
+ @result A new sorted array of every object in the arrays.
+ */
++ (NSArray *)twt_mergeSortedArrays:(NSArray<NSArray *> *)arrays usingComparator:(NSComparator)comparator;
+
+/*!
+ @abstract Returns the sorted union of the receiver and another sorted array.
+ @discussion Objects that compare equal are matched in pairs, one from each array, and each pair appears once in the
+    result, using the receiver’s object. Unmatched objects from either array all appear. This takes O(n + m) time.
+ @param array The sorted array to unite with the receiver. May not be nil.
+ @param comparator The comparator by which the receiver and array are sorted. May not be nil.
+ @result A new sorted array of the objects in either array.
+ */
+- (NSArray *)twt_unionWithSortedArray:(NSArray *)array usingComparator:(NSComparator)comparator;
+
+/*!
+ @abstract Returns the sorted intersection of the receiver and another sorted array.
+ @discussion Objects that compare equal are matched in pairs, one from each array, and each pair appears once in the
+    result, using the receiver’s object. Unmatched objects do not appear. This takes O(n + m) time.
+ @param array The sorted array to intersect with the receiver. May not be nil.
+ @param comparator The comparator by which the receiver and array are sorted. May not be nil.
+ @result A new sorted array of the objects in both arrays.
+ */
+- (NSArray *)twt_intersectionWithSortedArray:(NSArray *)array usingComparator:(NSComparator)comparator;
+
+/*!
+ @abstract Returns the objects in the receiver that are not in another sorted array.
+ @discussion Objects that compare equal are matched in pairs, one from each array, and matched objects do not appear
+    in the result. Unmatched objects from the receiver all appear. This takes O(n + m) time.
+ @param array The sorted array whose objects should be removed from the receiver. May not be nil.
+ @param comparator The comparator by which the receiver and array are sorted. May not be nil.
+ @result A new sorted array of the objects in the receiver that are not in array.
+ */
+- (NSArray *)twt_differenceWithSortedArray:(NSArray *)array usingComparator:(NSComparator)comparator;
+
 @end
 
+
 @interface NSDictionary (TWTBlockEnumeration) <TWTBlockEnumeration>
 @end
 
-@interface NSEnumerator (TWTBlockEnumeration) <TWTBlockEnumeration>
+@interface NSEnumerator (TWTBlockEnumeration) <TWTBlockEnumeration, TWTFlattenedObjectEnumeration>
 @end
 
-@interface NSOrderedSet (TWTBlockEnumeration) <TWTBlockEnumeration>
+@interface NSOrderedSet (TWTBlockEnumeration) <TWTBlockEnumeration, TWTFlattenedObjectEnumeration>
 @end
 
-@interface NSSet (TWTBlockEnumeration) <TWTBlockEnumeration>
+@interface NSSet (TWTBlockEnumeration) <TWTBlockEnumeration, TWTFlattenedObjectEnumeration>
 @end
 
 NS_ASSUME_NONNULL_END
@@ -26,8 +26,500 @@
 
 #import "TWTBlockEnumeration.h"
 
+#import <objc/runtime.h>
+
+
+#pragma mark TWTFlattenedObjectEnumerator
+
+/*!
+ TWTFlattenedObjectEnumerationFrames record the progress of fast enumeration through one collection on a
+ TWTFlattenedObjectEnumerator’s stack.
+ */
+typedef struct _TWTFlattenedObjectEnumerationFrame {
+    NSFastEnumerationState state;
+    __unsafe_unretained id buffer[16];
+    NSUInteger count;
+    NSUInteger index;
+    unsigned long mutations;
+} TWTFlattenedObjectEnumerationFrame;
+
+
+/*!
+ TWTFlattenedObjectEnumerators yield the leaves of a nested collection in depth-first order. Rather than recursing,
+ they keep an explicit stack with one fast enumeration frame per nesting level, so they use constant stack space and
+ allocate nothing per element.
+ */
+@interface TWTFlattenedObjectEnumerator : NSEnumerator
+
+- (instancetype)initWithCollection:(id<NSFastEnumeration>)collection maximumDepth:(NSUInteger)maximumDepth;
+
+@end
+
+
+@implementation TWTFlattenedObjectEnumerator {
+    NSUInteger _maximumDepth;
+
+    // Strong references to the collections being enumerated, parallel to _frames
+    NSMutableArray *_collections;
+
+    // Each frame is allocated separately so that it never moves. Collections may point a frame’s state at the frame’s
+    // own buffer or extra state, so moving it would leave those pointers dangling. Popped frames are kept for reuse
+    TWTFlattenedObjectEnumerationFrame **_frames;
+    NSUInteger _frameCount;
+    NSUInteger _allocatedFrameCount;
+    NSUInteger _frameCapacity;
+}
+
+- (instancetype)initWithCollection:(id<NSFastEnumeration>)collection maximumDepth:(NSUInteger)maximumDepth
+{
+    NSParameterAssert(collection);
+
+    self = [super init];
+    if (self) {
+        _maximumDepth = maximumDepth;
+        _collections = [[NSMutableArray alloc] init];
+        [self pushCollection:collection];
+    }
+
+    return self;
+}
+
+
+- (void)dealloc
+{
+    for (NSUInteger i = 0; i < _allocatedFrameCount; ++i) {
+        free(_frames[i]);
+    }
+
+    free(_frames);
+}
+
+
+- (void)pushCollection:(id<NSFastEnumeration>)collection
+{
+    if (_frameCount == _allocatedFrameCount) {
+        if (_allocatedFrameCount == _frameCapacity) {
+            _frameCapacity = MAX(_frameCapacity * 2, 8);
+            _frames = (TWTFlattenedObjectEnumerationFrame **)realloc(_frames, _frameCapacity * sizeof(TWTFlattenedObjectEnumerationFrame *));
+        }
+
+        _frames[_allocatedFrameCount++] = (TWTFlattenedObjectEnumerationFrame *)malloc(sizeof(TWTFlattenedObjectEnumerationFrame));
+    }
+
+    memset(_frames[_frameCount], 0, sizeof(TWTFlattenedObjectEnumerationFrame));
+    [_collections addObject:collection];
+    ++_frameCount;
+}
+
+
+- (id)nextObject
+{
+    while (_frameCount > 0) {
+        TWTFlattenedObjectEnumerationFrame *frame = _frames[_frameCount - 1];
+        id collection = _collections[_frameCount - 1];
+
+        if (frame->index == frame->count) {
+            BOOL isFirstBatch = frame->state.mutationsPtr == NULL;
+            frame->count = [collection countByEnumeratingWithState:&frame->state objects:frame->buffer count:16];
+            frame->index = 0;
+
+            if (frame->count == 0) {
+                [_collections removeLastObject];
+                --_frameCount;
+                continue;
+            }
+
+            if (isFirstBatch) {
+                frame->mutations = *frame->state.mutationsPtr;
+            }
+        }
+
+        // Mirror for-in’s check that the collection was not mutated during enumeration
+        if (frame->mutations != *frame->state.mutationsPtr) {
+            objc_enumerationMutation(collection);
+        }
+
+        id element = frame->state.itemsPtr[frame->index++];
+
+        // Each frame is one nesting level, so elements of the innermost frame are _frameCount levels deep
+        if (_frameCount <= _maximumDepth && [element respondsToSelector:@selector(countByEnumeratingWithState:objects:count:)]) {
+            [self pushCollection:element];
+            continue;
+        }
+
+        return element;
+    }
+
+    return nil;
+}
+
+@end
+
+
+#pragma mark Sorting by Key
+
+/*!
+ Collections with at least this many elements are sorted by key with a parallel merge sort. Below it, dispatching
+ runs to other cores costs more than it saves.
+ */
+static const NSUInteger kTWTBlockEnumerationParallelSortThreshold = 16384;
+
+/*!
+ Runs of at most this many indexes are sorted with an insertion sort rather than being split further.
+ */
+static const NSUInteger kTWTBlockEnumerationInsertionSortThreshold = 16;
+
+
+/*!
+ Compares the elements at two indexes by their cached keys, breaking ties by index so that sorts are stable.
+ */
+static inline NSComparisonResult TWTCompareKeyedIndexes(NSUInteger index1, NSUInteger index2,
+                                                        __unsafe_unretained id const *keys)
+{
+    NSComparisonResult result = [keys[index1] compare:keys[index2]];
+    if (result != NSOrderedSame || index1 == index2) {
+        return result;
+    }
+
+    return index1 < index2 ? NSOrderedAscending : NSOrderedDescending;
+}
+
+
+/*!
+ Merges the sorted index runs [start, middle) and [middle, end) of source into the same range of destination.
+ */
+static void TWTMergeKeyedIndexes(const NSUInteger *source, NSUInteger *destination,
+                                 NSUInteger start, NSUInteger middle, NSUInteger end,
+                                 __unsafe_unretained id const *keys)
+{
+    NSUInteger left = start;
+    NSUInteger right = middle;
+    for (NSUInteger i = start; i < end; ++i) {
+        if (right >= end || (left < middle && TWTCompareKeyedIndexes(source[left], source[right], keys) != NSOrderedDescending)) {
+            destination[i] = source[left++];
+        } else {
+            destination[i] = source[right++];
+        }
+    }
+}
+
+
+/*!
+ Sorts the count indexes in indexes by their cached keys with a top-down merge sort, using scratch, which must have 
+ room for count indexes, as the merge buffer.
+ */
+static void TWTMergeSortKeyedIndexes(NSUInteger *indexes, NSUInteger *scratch, NSUInteger count,
+                                     __unsafe_unretained id const *keys)
+{
+    if (count <= kTWTBlockEnumerationInsertionSortThreshold) {
+        for (NSUInteger i = 1; i < count; ++i) {
+            NSUInteger index = indexes[i];
+            NSUInteger j = i;
+            for (; j > 0 && TWTCompareKeyedIndexes(indexes[j - 1], index, keys) == NSOrderedDescending; --j) {
+                indexes[j] = indexes[j - 1];
+            }
+
+            indexes[j] = index;
+        }
+
+        return;
+    }
+
+    NSUInteger middle = count / 2;
+    TWTMergeSortKeyedIndexes(indexes, scratch, middle, keys);
+    TWTMergeSortKeyedIndexes(indexes + middle, scratch + middle, count - middle, keys);
+
+    // If the runs are already in order, there’s nothing to merge
+    if (TWTCompareKeyedIndexes(indexes[middle - 1], indexes[middle], keys) != NSOrderedDescending) {
+        return;
+    }
+
+    TWTMergeKeyedIndexes(indexes, scratch, 0, middle, count, keys);
+    memcpy(indexes, scratch, count * sizeof(NSUInteger));
+}
+
+
+/*!
+ Sorts the count indexes in indexes by their cached keys. Large inputs are split into one run per core, which are 
+ sorted concurrently and then merged pairwise, with each level of merges also performed concurrently. Returns 
+ whichever of indexes and scratch holds the sorted indexes.
+ */
+static NSUInteger *TWTSortKeyedIndexes(NSUInteger *indexes, NSUInteger *scratch, NSUInteger count,
+                                       __unsafe_unretained id const *keys)
+{
+    NSUInteger runCount = [[NSProcessInfo processInfo] activeProcessorCount];
+    if (count < kTWTBlockEnumerationParallelSortThreshold || runCount < 2) {
+        TWTMergeSortKeyedIndexes(indexes, scratch, count, keys);
+        return indexes;
+    }
+
+    // Run boundaries are computed rather than stored so that the blocks below needn’t capture a buffer for them
+    NSUInteger (^runStart)(NSUInteger) = ^NSUInteger(NSUInteger run) {
+        return (NSUInteger)((unsigned long long)count * MIN(run, runCount) / runCount);
+    };
+
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_apply(runCount, queue, ^(size_t run) {
+        NSUInteger start = runStart(run);
+        TWTMergeSortKeyedIndexes(indexes + start, scratch + start, runStart(run + 1) - start, keys);
+    });
+
+    // Merge adjacent runs, doubling their width each level. Each level reads from one buffer and writes to the other
+    NSUInteger *source = indexes;
+    NSUInteger *destination = scratch;
+    for (NSUInteger width = 1; width < runCount; width *= 2) {
+        NSUInteger pairCount = (runCount + 2 * width - 1) / (2 * width);
+        dispatch_apply(pairCount, queue, ^(size_t pair) {
+            NSUInteger firstRun = pair * 2 * width;
+            TWTMergeKeyedIndexes(source, destination, runStart(firstRun), runStart(firstRun + width),
+                                 runStart(firstRun + 2 * width), keys);
+        });
+
+        NSUInteger *swap = source;
+        source = destination;
+        destination = swap;
+    }
+
+    return source;
+}
+
+
+/*!
+ Compares two top-k heap entries by their cached keys, breaking ties by the order in which their elements were
+ enumerated.
+ */
+static inline NSComparisonResult TWTCompareKeyedHeapEntries(NSUInteger entry1, NSUInteger entry2,
+                                                            __unsafe_unretained id const *keys,
+                                                            const NSUInteger *ordinals)
+{
+    NSComparisonResult result = [keys[entry1] compare:keys[entry2]];
+    if (result != NSOrderedSame || entry1 == entry2) {
+        return result;
+    }
+
+    return ordinals[entry1] < ordinals[entry2] ? NSOrderedAscending : NSOrderedDescending;
+}
+
+
+/*!
+ Restores the max-heap property of heap after the entry at slot has been added to its end.
+ */
+static void TWTSiftUpKeyedHeapEntry(NSUInteger *heap, NSUInteger slot, __unsafe_unretained id const *keys,
+                                    const NSUInteger *ordinals)
+{
+    while (slot > 0) {
+        NSUInteger parent = (slot - 1) / 2;
+        if (TWTCompareKeyedHeapEntries(heap[parent], heap[slot], keys, ordinals) != NSOrderedAscending) {
+            return;
+        }
+
+        NSUInteger entry = heap[parent];
+        heap[parent] = heap[slot];
+        heap[slot] = entry;
+        slot = parent;
+    }
+}
+
+
+/*!
+ Restores the max-heap property of the first count entries of heap after its root has been replaced.
+ */
+static void TWTSiftDownKeyedHeapRoot(NSUInteger *heap, NSUInteger count, __unsafe_unretained id const *keys,
+                                     const NSUInteger *ordinals)
+{
+    NSUInteger slot = 0;
+    for (;;) {
+        NSUInteger largest = slot;
+        NSUInteger left = 2 * slot + 1;
+        NSUInteger right = left + 1;
+        if (left < count && TWTCompareKeyedHeapEntries(heap[left], heap[largest], keys, ordinals) == NSOrderedDescending) {
+            largest = left;
+        }
+
+        if (right < count && TWTCompareKeyedHeapEntries(heap[right], heap[largest], keys, ordinals) == NSOrderedDescending) {
+            largest = right;
+        }
+
+        if (largest == slot) {
+            return;
+        }
+
+        NSUInteger entry = heap[largest];
+        heap[largest] = heap[slot];
+        heap[slot] = entry;
+        slot = largest;
+    }
+}
+
+
+#pragma mark Sampling
+
+/*!
+ Returns the next value of a SplitMix64 generator, advancing its state. The generator is fast, statistically sound, 
+ and fully determined by its initial state, which makes seeded samples reproducible on every platform.
+ */
+static inline uint64_t TWTBlockEnumerationNextRandomValue(uint64_t *state)
+{
+    uint64_t value = (*state += 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return value ^ (value >> 31);
+}
+
+
+/*!
+ Returns a uniformly distributed random value less than bound. Values below 2^64 mod bound are rejected, so that the
+ remaining range is a multiple of bound and the result has no modulo bias.
+ */
+static inline uint64_t TWTBlockEnumerationRandomValueLessThan(uint64_t *state, uint64_t bound)
+{
+    uint64_t threshold = -bound % bound;
+    uint64_t value;
+    do {
+        value = TWTBlockEnumerationNextRandomValue(state);
+    } while (value < threshold);
+
+    return value % bound;
+}
+
+
+/*!
+ Returns a seed for sampling methods that aren’t given one.
+ */
+static inline uint64_t TWTBlockEnumerationRandomSeed(void)
+{
+    return ((uint64_t)arc4random() << 32) | arc4random();
+}
+
+
+/*!
+ Offers the element at the specified zero-based ordinal of a stream to a reservoir of at most size elements. This is
+ Algorithm R: the first size elements fill the reservoir, and each later element replaces a random one with 
+ probability size / (ordinal + 1), which leaves every element seen so far equally likely to be in the reservoir.
+ */
+static inline void TWTBlockEnumerationOfferElementToReservoir(NSMutableArray *reservoir, NSUInteger size, id element,
+                                                              NSUInteger ordinal, uint64_t *state)
+{
+    if (ordinal < size) {
+        [reservoir addObject:element];
+        return;
+    }
+
+    uint64_t index = TWTBlockEnumerationRandomValueLessThan(state, (uint64_t)ordinal + 1);
+    if (index < size) {
+        reservoir[(NSUInteger)index] = element;
+    }
+}
+
+
 #pragma mark TWTBlockEnumerator
 
+/*!
+ Returns the number of elements in the specified collection, or 0 if it doesn’t know, e.g., because it is an
+ enumerator. This is used to presize result collections.
+ */
+static inline NSUInteger TWTBlockEnumerationCapacityForObject(id object)
+{
+    return [object respondsToSelector:@selector(count)] ? [object count] : 0;
+}
+
+
+/*!
+ The number of elements enumerated in the first autorelease pool when draining autorelease pools. Later chunks double
+ or halve this, between the minimum and maximum below, to keep each chunk close to the target drain interval.
+ */
+static const NSUInteger kTWTBlockEnumerationInitialAutoreleasePoolChunkSize = 1024;
+static const NSUInteger kTWTBlockEnumerationMinimumAutoreleasePoolChunkSize = 16;
+static const NSUInteger kTWTBlockEnumerationMaximumAutoreleasePoolChunkSize = 65536;
+
+/*!
+ How often autorelease pools are drained when draining autorelease pools. This is long enough that pushing and 
+ popping pools costs nothing measurable, but short enough that few temporaries accumulate between drains.
+ */
+static const NSTimeInterval kTWTBlockEnumerationAutoreleasePoolDrainInterval = 0.001;
+
+
+/*!
+ Invokes body with each element of the specified collection. The elements are enumerated in chunks, each inside its
+ own autorelease pool, and the chunk size adapts to the time each chunk takes.
+ */
+static void TWTBlockEnumerationEnumerateObjectsDrainingAutoreleasePools(id<NSFastEnumeration> object,
+                                                                        void (^body)(id element))
+{
+    // Fast enumeration is performed by hand so that it can be suspended between pools. Objects in the buffer may 
+    // be kept alive only by the pool that was in place when they were fetched, so pools are only drained once every
+    // fetched object has been processed
+    NSFastEnumerationState state = { 0 };
+    __unsafe_unretained id buffer[16];
+    unsigned long mutations = 0;
+    BOOL recordedMutations = NO;
+
+    NSProcessInfo *processInfo = [NSProcessInfo processInfo];
+    NSUInteger chunkSize = kTWTBlockEnumerationInitialAutoreleasePoolChunkSize;
+    BOOL finished = NO;
+    while (!finished) {
+        NSTimeInterval startTime = processInfo.systemUptime;
+
+        @autoreleasepool {
+            NSUInteger enumeratedCount = 0;
+            while (enumeratedCount < chunkSize) {
+                NSUInteger count = [object countByEnumeratingWithState:&state objects:buffer count:16];
+                if (count == 0) {
+                    finished = YES;
+                    break;
+                } else if (!recordedMutations) {
+                    mutations = *state.mutationsPtr;
+                    recordedMutations = YES;
+                }
+
+                for (NSUInteger i = 0; i < count; ++i) {
+                    if (*state.mutationsPtr != mutations) {
+                        objc_enumerationMutation(object);
+                    }
+
+                    body(state.itemsPtr[i]);
+                }
+
+                enumeratedCount += count;
+            }
+        }
+
+        NSTimeInterval elapsedTime = processInfo.systemUptime - startTime;
+        if (elapsedTime < kTWTBlockEnumerationAutoreleasePoolDrainInterval / 2) {
+            chunkSize = MIN(chunkSize * 2, kTWTBlockEnumerationMaximumAutoreleasePoolChunkSize);
+        } else if (elapsedTime > kTWTBlockEnumerationAutoreleasePoolDrainInterval * 2) {
+            chunkSize = MAX(chunkSize / 2, kTWTBlockEnumerationMinimumAutoreleasePoolChunkSize);
+        }
+    }
+}
+
+
+/*!
+ Executes the braced statements passed as the last argument once for each element of object, with the element in a
+ variable with the specified name. If options include TWTBlockEnumerationOptionDrainAutoreleasePools, the statements
+ become the body of a block passed to TWTBlockEnumerationEnumerateObjectsDrainingAutoreleasePools. Otherwise, they are
+ the body of a plain fast enumeration loop, so that the default path makes no block invocation per element. Because 
+ the statements may run in either context, they must not return, break, or continue, and variables they assign must
+ be declared __block.
+ */
+#define TWTBlockEnumerationForEachElement(element, object, options, ...) \
+    if ((options) & TWTBlockEnumerationOptionDrainAutoreleasePools) { \
+        TWTBlockEnumerationEnumerateObjectsDrainingAutoreleasePools((object), ^(id element) __VA_ARGS__); \
+    } else { \
+        for (id element in (object)) __VA_ARGS__ \
+    }
+
+
+/*!
+ Boxes a count from an unboxed count dictionary and adds it to the NSMutableDictionary context. This is a
+ CFDictionaryApplierFunction.
+ */
+static void TWTBlockEnumerationAddBoxedCount(const void *key, const void *value, void *context)
+{
+    [(__bridge NSMutableDictionary *)context setObject:@((NSUInteger)(uintptr_t)value) forKey:(__bridge id)key];
+}
+
+
 /*!
  TWTBlockEnumerator does all the work of performing block enumerations for the Foundation collection classes.
  It assumes that it is collecting for array-like objects that respond to -addObject: or dictionary-like objects
@@ -35,353 +527,1586 @@
  */
 @interface TWTBlockEnumerator : NSObject
 
-+ (id)performCollectOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationCollectBlock)block;
-+ (id)performDictionaryFlattenOnObject:(NSDictionary *)dictionary;
-+ (id)performCollectionFlattenOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass;
++ (id)performCollectOnObject:(id <NSFastEnumeration>)object
+      resultsCollectionClass:(Class)collectionClass
+                     options:(TWTBlockEnumerationOptions)options
+                       block:(TWTBlockEnumerationCollectBlock)block;
++ (void)performCollectOnObject:(id <NSFastEnumeration>)object
+                intoCollection:(id)collection
+                       options:(TWTBlockEnumerationOptions)options
+                         block:(TWTBlockEnumerationCollectBlock)block;
++ (NSDictionary *)performCountOnObject:(id <NSFastEnumeration>)object block:(TWTBlockEnumerationGroupBlock)block;
++ (id)performDictionaryFlattenOnObject:(NSDictionary *)dictionary maximumDepth:(NSUInteger)maximumDepth;
++ (id)performCollectionFlattenOnObject:(id <NSFastEnumeration>)object
+                resultsCollectionClass:(Class)collectionClass
+                          maximumDepth:(NSUInteger)maximumDepth;
 + (id)performDetectOnObject:(id <NSFastEnumeration>)object block:(TWTBlockEnumerationPredicateBlock)block;
-+ (NSDictionary *)performGroupOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationGroupBlock)block;
-+ (id)performInjectOnObject:(id <NSFastEnumeration>)object initialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block;
-+ (id)performRejectOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationPredicateBlock)block;
-+ (id)performSelectOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationPredicateBlock)block;
++ (id)performDistinctOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationGroupBlock)block;
++ (NSDictionary *)performGroupOnObject:(id <NSFastEnumeration>)object
+                resultsCollectionClass:(Class)collectionClass
+                               options:(TWTBlockEnumerationOptions)options
+                                 block:(TWTBlockEnumerationGroupBlock)block;
++ (id)performInjectOnObject:(id <NSFastEnumeration>)object
+              initialObject:(id)initialObject
+                    options:(TWTBlockEnumerationOptions)options
+                      block:(TWTBlockEnumerationInjectBlock)block;
++ (NSArray *)performPartitionOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationPredicateBlock)block;
++ (void)performPartitionOnObject:(id <NSFastEnumeration>)object
+              selectedCollection:(id)selectedCollection
+              rejectedCollection:(id)rejectedCollection
+                         options:(TWTBlockEnumerationOptions)options
+                           block:(TWTBlockEnumerationPredicateBlock)block;
++ (id)performRejectOnObject:(id <NSFastEnumeration>)object
+     resultsCollectionClass:(Class)collectionClass
+                    options:(TWTBlockEnumerationOptions)options
+                      block:(TWTBlockEnumerationPredicateBlock)block;
++ (id)performSelectOnObject:(id <NSFastEnumeration>)object
+     resultsCollectionClass:(Class)collectionClass
+                    options:(TWTBlockEnumerationOptions)options
+                      block:(TWTBlockEnumerationPredicateBlock)block;
++ (NSArray *)performSampleOnObject:(id <NSFastEnumeration>)object size:(NSUInteger)size seed:(uint64_t)seed;
++ (NSDictionary *)performSampleOnObject:(id <NSFastEnumeration>)object
+                                   size:(NSUInteger)size
+                             groupBlock:(TWTBlockEnumerationGroupBlock)block
+                                   seed:(uint64_t)seed;
++ (NSArray *)performSortOnObject:(id <NSFastEnumeration>)object block:(TWTBlockEnumerationSortKeyBlock)block;
++ (NSArray *)performTopKOnObject:(id <NSFastEnumeration>)object count:(NSUInteger)k block:(TWTBlockEnumerationSortKeyBlock)block;
 
 @end
 
 
-#pragma mark -
+#pragma mark -
+
+@implementation TWTBlockEnumerator
+
++ (id)performCollectOnObject:(id <NSFastEnumeration>)object
+      resultsCollectionClass:(Class)collectionClass
+                     options:(TWTBlockEnumerationOptions)options
+                       block:(TWTBlockEnumerationCollectBlock)block
+{
+    NSParameterAssert(collectionClass);
+
+    id collection = [[collectionClass alloc] initWithCapacity:TWTBlockEnumerationCapacityForObject(object)];
+    [self performCollectOnObject:object intoCollection:collection options:options block:block];
+    return collection;
+}
+
+
++ (void)performCollectOnObject:(id <NSFastEnumeration>)object
+                intoCollection:(id)collection
+                       options:(TWTBlockEnumerationOptions)options
+                         block:(TWTBlockEnumerationCollectBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(collection);
+    NSParameterAssert(block);
+
+    BOOL respondsToSetObjectForKey = [collection respondsToSelector:@selector(setObject:forKey:)];
+    TWTBlockEnumerationForEachElement(element, object, options, {
+        id result = block(element);
+        if (!result) {
+            result = [NSNull null];
+        }
+        
+        if (respondsToSetObjectForKey) {
+            [collection setObject:result forKey:element];
+        } else {
+            [collection addObject:result];
+        }
+    });
+}
+
+
++ (NSDictionary *)performCountOnObject:(id <NSFastEnumeration>)object block:(TWTBlockEnumerationGroupBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    // Keep counts unboxed while counting so that incrementing one allocates nothing, and box each once at the end
+    CFMutableDictionaryRef counts = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    for (id element in object) {
+        id groupKey = block(element);
+        if (!groupKey) {
+            groupKey = [NSNull null];
+        }
+
+        uintptr_t count = (uintptr_t)CFDictionaryGetValue(counts, (__bridge const void *)groupKey);
+        CFDictionarySetValue(counts, (__bridge const void *)groupKey, (const void *)(count + 1));
+    }
+
+    NSMutableDictionary *boxedCounts = [[NSMutableDictionary alloc] initWithCapacity:CFDictionaryGetCount(counts)];
+    CFDictionaryApplyFunction(counts, TWTBlockEnumerationAddBoxedCount, (__bridge void *)boxedCounts);
+    CFRelease(counts);
+
+    return boxedCounts;
+}
+
+
++ (id)performDictionaryFlattenOnObject:(NSDictionary *)dictionary maximumDepth:(NSUInteger)maximumDepth
+{
+    NSParameterAssert(dictionary);
+
+    NSMutableDictionary *flattenedDictionary = [[NSMutableDictionary alloc] initWithCapacity:dictionary.count];
+
+    // Rather than recursing into child dictionaries and merging their flattened copies, keep an explicit stack of the
+    // dictionaries being enumerated and write every entry directly into the result
+    NSMutableArray *dictionaries = [[NSMutableArray alloc] initWithObjects:dictionary, nil];
+    NSMutableArray *keyEnumerators = [[NSMutableArray alloc] initWithObjects:[dictionary keyEnumerator], nil];
+
+    while (dictionaries.count > 0) {
+        id key = [keyEnumerators.lastObject nextObject];
+        if (!key) {
+            [dictionaries removeLastObject];
+            [keyEnumerators removeLastObject];
+            continue;
+        }
+
+        id result = [dictionaries.lastObject objectForKey:key];
+        if (dictionaries.count <= maximumDepth && [result respondsToSelector:@selector(objectForKey:)]) {
+            [dictionaries addObject:result];
+            [keyEnumerators addObject:[result keyEnumerator]];
+        } else {
+            [flattenedDictionary setObject:result forKey:key];
+        }
+    }
+
+    return flattenedDictionary;
+}
+
+
++ (id)performCollectionFlattenOnObject:(id <NSFastEnumeration>)collection
+                resultsCollectionClass:(Class)collectionClass
+                          maximumDepth:(NSUInteger)maximumDepth
+{
+    NSParameterAssert(collection);
+    NSParameterAssert(collectionClass);
+
+    // The receiver’s count is a lower bound on the flattened count unless it contains empty child collections
+    NSUInteger capacity = TWTBlockEnumerationCapacityForObject(collection);
+    id flattenedCollection = [[collectionClass alloc] initWithCapacity:capacity];
+
+    TWTFlattenedObjectEnumerator *enumerator = [[TWTFlattenedObjectEnumerator alloc] initWithCollection:collection
+                                                                                            maximumDepth:maximumDepth];
+    id element = nil;
+    while ((element = [enumerator nextObject])) {
+        [flattenedCollection addObject:element];
+    }
+
+    return flattenedCollection;
+}
+
+
++ (id)performDetectOnObject:(id <NSFastEnumeration>)object block:(TWTBlockEnumerationPredicateBlock)block;
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+    
+    id collection = object;
+    BOOL respondsToObjectForKey = [[collection class] instancesRespondToSelector:@selector(objectForKey:)];
+    
+    for (id element in collection) {
+        if (block(element)) {
+            if (respondsToObjectForKey) {
+                return [collection objectForKey:element];
+            } else {
+                return element;
+            }
+        }
+    }
+
+    return nil;
+}
+
+
++ (id)performDistinctOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationGroupBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(collectionClass);
+    NSParameterAssert(block);
+
+    NSUInteger capacity = TWTBlockEnumerationCapacityForObject(object);
+    id collection = [[collectionClass alloc] initWithCapacity:capacity];
+    NSMutableSet *keys = [[NSMutableSet alloc] initWithCapacity:capacity];
+
+    BOOL respondsToSetObjectForKey = [collection respondsToSelector:@selector(setObject:forKey:)];
+    for (id element in object) {
+        id key = block(element);
+        if (!key) {
+            key = [NSNull null];
+        }
+
+        // Adding the key and checking whether the set grew takes one hash lookup rather than two
+        NSUInteger keyCount = keys.count;
+        [keys addObject:key];
+        if (keys.count == keyCount) {
+            continue;
+        }
+
+        if (respondsToSetObjectForKey) {
+            [collection setObject:[(id)object objectForKey:element] forKey:element];
+        } else {
+            [collection addObject:element];
+        }
+    }
+
+    return collection;
+}
+
+
++ (NSDictionary *)performGroupOnObject:(id <NSFastEnumeration>)object
+                resultsCollectionClass:(Class)collectionClass
+                               options:(TWTBlockEnumerationOptions)options
+                                 block:(TWTBlockEnumerationGroupBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(collectionClass);
+    NSParameterAssert(block);
+
+    NSMutableDictionary *groups = [[NSMutableDictionary alloc] init];
+
+    id collection = object;
+    BOOL respondsToSetObjectForKey = [collectionClass instancesRespondToSelector:@selector(setObject:forKey:)];
+
+    // If the collection class responds to setObject:forKey:, the collection must respond to objectForKey:
+    NSAssert(!respondsToSetObjectForKey || [collection respondsToSelector:@selector(objectForKey:)],
+             @"Only collections that respond to -objectForKey: may have resultsCollectionClasses that respond to -setObject:forKey:");
+
+    TWTBlockEnumerationForEachElement(element, collection, options, {
+        id<NSCopying> groupKey = block(element);
+        if (!groupKey) {
+            groupKey = [NSNull null];
+        }
+
+        id group = groups[groupKey];
+        if (!group) {
+            group = [[collectionClass alloc] init];
+            groups[groupKey] = group;
+        }
+
+        if (respondsToSetObjectForKey) {
+            [group setObject:[collection objectForKey:element] forKey:element];
+        } else {
+            [group addObject:element];
+        }
+    });
+
+    return groups;
+}
+
+
++ (id)performInjectOnObject:(id <NSFastEnumeration>)object
+              initialObject:(id)initialObject
+                    options:(TWTBlockEnumerationOptions)options
+                      block:(TWTBlockEnumerationInjectBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    // total is strong, so it survives the autorelease pool in which it was returned
+    __block id total = initialObject;
+    TWTBlockEnumerationForEachElement(element, object, options, {
+        total = block(total, element);
+    });
+
+    return total;
+}
+
+
++ (NSArray *)performPartitionOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(collectionClass);
+
+    // Either half may end up with every element
+    NSUInteger capacity = TWTBlockEnumerationCapacityForObject(object);
+    id selectedCollection = [[collectionClass alloc] initWithCapacity:capacity];
+    id rejectedCollection = [[collectionClass alloc] initWithCapacity:capacity];
+    [self performPartitionOnObject:object
+                selectedCollection:selectedCollection
+                rejectedCollection:rejectedCollection
+                           options:0
+                             block:block];
+
+    return @[ selectedCollection, rejectedCollection ];
+}
+
+
++ (void)performPartitionOnObject:(id <NSFastEnumeration>)object
+              selectedCollection:(id)selectedCollection
+              rejectedCollection:(id)rejectedCollection
+                         options:(TWTBlockEnumerationOptions)options
+                           block:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(selectedCollection || rejectedCollection);
+    NSParameterAssert(block);
+
+    BOOL respondsToSetObjectForKey = [(selectedCollection ?: rejectedCollection) respondsToSelector:@selector(setObject:forKey:)];
+    TWTBlockEnumerationForEachElement(element, object, options, {
+        // Elements whose collection is nil are dropped
+        id collection = block(element) ? selectedCollection : rejectedCollection;
+        if (collection && respondsToSetObjectForKey) {
+            [collection setObject:[(id)object objectForKey:element] forKey:element];
+        } else if (collection) {
+            [collection addObject:element];
+        }
+    });
+}
+
+
++ (id)performRejectOnObject:(id <NSFastEnumeration>)object
+     resultsCollectionClass:(Class)collectionClass
+                    options:(TWTBlockEnumerationOptions)options
+                      block:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(collectionClass);
+
+    id collection = [[collectionClass alloc] initWithCapacity:TWTBlockEnumerationCapacityForObject(object)];
+    [self performPartitionOnObject:object selectedCollection:nil rejectedCollection:collection options:options block:block];
+    return collection;
+}
+
+
++ (id)performSelectOnObject:(id <NSFastEnumeration>)object
+     resultsCollectionClass:(Class)collectionClass
+                    options:(TWTBlockEnumerationOptions)options
+                      block:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(collectionClass);
+
+    id collection = [[collectionClass alloc] initWithCapacity:TWTBlockEnumerationCapacityForObject(object)];
+    [self performPartitionOnObject:object selectedCollection:collection rejectedCollection:nil options:options block:block];
+    return collection;
+}
+
+
++ (NSArray *)performSampleOnObject:(id <NSFastEnumeration>)object size:(NSUInteger)size seed:(uint64_t)seed
+{
+    NSParameterAssert(object);
+
+    if (size == 0) {
+        return @[];
+    }
+
+    // Enumerators have no count, so rather than allocating for size elements up front, let the reservoir grow
+    NSMutableArray *reservoir = [[NSMutableArray alloc] initWithCapacity:MIN(size, (NSUInteger)1024)];
+    uint64_t state = seed;
+    NSUInteger ordinal = 0;
+    for (id element in object) {
+        TWTBlockEnumerationOfferElementToReservoir(reservoir, size, element, ordinal++, &state);
+    }
+
+    return reservoir;
+}
+
+
++ (NSDictionary *)performSampleOnObject:(id <NSFastEnumeration>)object
+                                   size:(NSUInteger)size
+                             groupBlock:(TWTBlockEnumerationGroupBlock)block
+                                   seed:(uint64_t)seed
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    // Each group has its own reservoir and unboxed count of elements seen, but all groups draw from one generator, so
+    // the samples depend only on the seed and the order of the elements
+    NSMutableDictionary *reservoirs = [[NSMutableDictionary alloc] init];
+    CFMutableDictionaryRef counts = CFDictionaryCreateMutable(kCFAllocatorDefault, 0, &kCFTypeDictionaryKeyCallBacks, NULL);
+    uint64_t state = seed;
+    for (id element in object) {
+        id groupKey = block(element);
+        if (!groupKey) {
+            groupKey = [NSNull null];
+        }
+
+        NSMutableArray *reservoir = reservoirs[groupKey];
+        if (!reservoir) {
+            reservoir = [[NSMutableArray alloc] initWithCapacity:MIN(size, (NSUInteger)16)];
+            reservoirs[groupKey] = reservoir;
+        }
+
+        uintptr_t count = (uintptr_t)CFDictionaryGetValue(counts, (__bridge const void *)groupKey);
+        CFDictionarySetValue(counts, (__bridge const void *)groupKey, (const void *)(count + 1));
+        TWTBlockEnumerationOfferElementToReservoir(reservoir, size, element, count, &state);
+    }
+
+    CFRelease(counts);
+    return reservoirs;
+}
+
+
++ (NSArray *)performSortOnObject:(id <NSFastEnumeration>)object block:(TWTBlockEnumerationSortKeyBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    // Decorate: compute every element’s key exactly once
+    NSUInteger capacity = TWTBlockEnumerationCapacityForObject(object);
+    NSMutableArray *elements = [[NSMutableArray alloc] initWithCapacity:capacity];
+    NSMutableArray *keys = [[NSMutableArray alloc] initWithCapacity:capacity];
+    for (id element in object) {
+        id key = block(element);
+        NSAssert(key, @"Sort key block returned nil for element %@", element);
+        [elements addObject:element];
+        [keys addObject:key];
+    }
+
+    NSUInteger count = elements.count;
+    if (count < 2) {
+        return [elements copy];
+    }
+
+    // Sort: order a permutation of indexes by the keys, which the keys array keeps alive throughout
+    __unsafe_unretained id *keyBuffer = (__unsafe_unretained id *)calloc(count, sizeof(id));
+    NSUInteger *indexes = calloc(count, sizeof(NSUInteger));
+    NSUInteger *scratch = calloc(count, sizeof(NSUInteger));
+    [keys getObjects:keyBuffer range:NSMakeRange(0, count)];
+    for (NSUInteger i = 0; i < count; ++i) {
+        indexes[i] = i;
+    }
+
+    NSUInteger *sortedIndexes = TWTSortKeyedIndexes(indexes, scratch, count, keyBuffer);
+
+    // Undecorate: gather the elements in sorted order
+    __unsafe_unretained id *sortedElements = keyBuffer;
+    for (NSUInteger i = 0; i < count; ++i) {
+        sortedElements[i] = elements[sortedIndexes[i]];
+    }
+
+    NSArray *sortedArray = [[NSArray alloc] initWithObjects:sortedElements count:count];
+
+    free(keyBuffer);
+    free(indexes);
+    free(scratch);
+    return sortedArray;
+}
+
+
++ (NSArray *)performTopKOnObject:(id <NSFastEnumeration>)object count:(NSUInteger)k block:(TWTBlockEnumerationSortKeyBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    NSUInteger count = TWTBlockEnumerationCapacityForObject(object);
+    if (count > 0 && k >= count) {
+        return [self performSortOnObject:object block:block];
+    } else if (k == 0) {
+        return @[];
+    }
+
+    // The heap is a max-heap of entries for the best k elements seen so far, so its root is the entry that the next 
+    // better element evicts. Entries index into elements, keys, and ordinals, and are reused when evicted. Enumerators
+    // have no count, so rather than allocating for k entries up front, the buffers grow as needed
+    NSUInteger capacity = MIN(k, (NSUInteger)1024);
+    NSMutableArray *elements = [[NSMutableArray alloc] initWithCapacity:capacity];
+    NSMutableArray *keys = [[NSMutableArray alloc] initWithCapacity:capacity];
+    __unsafe_unretained id *keyBuffer = (__unsafe_unretained id *)calloc(capacity, sizeof(id));
+    NSUInteger *ordinals = calloc(capacity, sizeof(NSUInteger));
+    NSUInteger *heap = calloc(capacity, sizeof(NSUInteger));
+
+    NSUInteger heapCount = 0;
+    NSUInteger ordinal = 0;
+    for (id element in object) {
+        id key = block(element);
+        NSAssert(key, @"Sort key block returned nil for element %@", element);
+
+        if (heapCount < k) {
+            if (heapCount == capacity) {
+                capacity = MIN(k, capacity * 2);
+                keyBuffer = (__unsafe_unretained id *)realloc(keyBuffer, capacity * sizeof(id));
+                ordinals = realloc(ordinals, capacity * sizeof(NSUInteger));
+                heap = realloc(heap, capacity * sizeof(NSUInteger));
+            }
+
+            [elements addObject:element];
+            [keys addObject:key];
+            keyBuffer[heapCount] = key;
+            ordinals[heapCount] = ordinal;
+            heap[heapCount] = heapCount;
+            TWTSiftUpKeyedHeapEntry(heap, heapCount++, keyBuffer, ordinals);
+        } else if ([key compare:keyBuffer[heap[0]]] == NSOrderedAscending) {
+            // Ties with the root lose, since the root’s element was enumerated first
+            NSUInteger entry = heap[0];
+            elements[entry] = element;
+            keys[entry] = key;
+            keyBuffer[entry] = key;
+            ordinals[entry] = ordinal;
+            TWTSiftDownKeyedHeapRoot(heap, heapCount, keyBuffer, ordinals);
+        }
+
+        ++ordinal;
+    }
+
+    // Heap sort the survivors in place: repeatedly move the root to the end of the heap and shrink it
+    for (NSUInteger count = heapCount; count > 1; --count) {
+        NSUInteger entry = heap[0];
+        heap[0] = heap[count - 1];
+        heap[count - 1] = entry;
+        TWTSiftDownKeyedHeapRoot(heap, count - 1, keyBuffer, ordinals);
+    }
+
+    NSMutableArray *topElements = [[NSMutableArray alloc] initWithCapacity:heapCount];
+    for (NSUInteger i = 0; i < heapCount; ++i) {
+        [topElements addObject:elements[heap[i]]];
+    }
+
+    free(keyBuffer);
+    free(ordinals);
+    free(heap);
+    return topElements;
+}
+
+@end
+
+
+#pragma mark - Arrays
+
+@implementation NSArray (TWTBlockEnumeration)
+
+- (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    return [self twt_collectWithOptions:0 block:block];
+}
+
+
+- (id)twt_collectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationCollectBlock)block
+{
+    return [TWTBlockEnumerator performCollectOnObject:self
+                               resultsCollectionClass:[NSMutableArray class]
+                                              options:options
+                                                block:block];
+}
+
+
+- (void)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block intoCollection:(id)collection
+{
+    [TWTBlockEnumerator performCollectOnObject:self intoCollection:collection options:0 block:block];
+}
+
+
+- (NSDictionary *)twt_countByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performCountOnObject:self block:block];
+}
+
+
+- (id)twt_flatten
+{
+    return [self twt_flattenWithMaximumDepth:NSUIntegerMax];
+}
+
+
+- (id)twt_flattenWithMaximumDepth:(NSUInteger)maximumDepth
+{
+    return [TWTBlockEnumerator performCollectionFlattenOnObject:self
+                                         resultsCollectionClass:[NSMutableArray class]
+                                                   maximumDepth:maximumDepth];
+}
+
+
+- (NSEnumerator *)twt_flattenedObjectEnumeratorWithMaximumDepth:(NSUInteger)maximumDepth
+{
+    return [[TWTFlattenedObjectEnumerator alloc] initWithCollection:self maximumDepth:maximumDepth];
+}
+
+
+- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+}
+
+
+- (id)twt_distinctByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performDistinctOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+}
+
+
+- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [self twt_groupWithOptions:0 block:block];
+}
+
+
+- (NSDictionary *)twt_groupWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performGroupOnObject:self
+                             resultsCollectionClass:[NSMutableArray class]
+                                            options:options
+                                              block:block];
+}
+
+
+- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+{
+    return [self twt_injectWithOptions:0 initialObject:initialObject block:block];
+}
+
+
+- (id)twt_injectWithOptions:(TWTBlockEnumerationOptions)options
+              initialObject:(id)initialObject
+                      block:(TWTBlockEnumerationInjectBlock)block
+{
+    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject options:options block:block];
+}
+
+
+- (NSArray *)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performPartitionOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+}
+
+
+- (void)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+        intoSelectedCollection:(id)selectedCollection
+            rejectedCollection:(id)rejectedCollection
+{
+    NSParameterAssert(selectedCollection);
+    NSParameterAssert(rejectedCollection);
+    [TWTBlockEnumerator performPartitionOnObject:self
+                              selectedCollection:selectedCollection
+                              rejectedCollection:rejectedCollection
+                                         options:0
+                                           block:block];
+}
+
+
+- (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_rejectWithOptions:0 block:block];
+}
+
+
+- (id)twt_rejectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performRejectOnObject:self
+                              resultsCollectionClass:[NSMutableArray class]
+                                             options:options
+                                               block:block];
+}
+
+
+- (void)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
+{
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:nil rejectedCollection:collection options:0 block:block];
+}
+
+
+- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_selectWithOptions:0 block:block];
+}
+
+
+- (id)twt_selectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performSelectOnObject:self
+                              resultsCollectionClass:[NSMutableArray class]
+                                             options:options
+                                               block:block];
+}
+
+
+- (void)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
+{
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:collection rejectedCollection:nil options:0 block:block];
+}
+
+
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size
+{
+    return [self twt_sampleOfSize:size seed:TWTBlockEnumerationRandomSeed()];
+}
+
+
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size seed:(uint64_t)seed
+{
+    return [TWTBlockEnumerator performSampleOnObject:self size:size seed:seed];
+}
+
+
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [self twt_sampleOfSize:size groupedByBlock:block seed:TWTBlockEnumerationRandomSeed()];
+}
+
+
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size
+                    groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+                              seed:(uint64_t)seed
+{
+    return [TWTBlockEnumerator performSampleOnObject:self size:size groupBlock:block seed:seed];
+}
+
+
+- (NSArray *)twt_sortedByBlock:(TWTBlockEnumerationSortKeyBlock)block
+{
+    return [TWTBlockEnumerator performSortOnObject:self block:block];
+}
+
+
+- (NSArray *)twt_topK:(NSUInteger)k byBlock:(TWTBlockEnumerationSortKeyBlock)block
+{
+    return [TWTBlockEnumerator performTopKOnObject:self count:k block:block];
+}
+
+@end
+
+
+#pragma mark - Sorted Arrays
+
+/*!
+ Options for TWTCombineSortedArrays that specify which objects to keep. Objects that compare equal are matched in 
+ pairs, one from each array.
+ */
+typedef NS_OPTIONS(NSUInteger, TWTSortedArrayCombination) {
+    /*! Objects in the first array with no match in the second are kept. */
+    TWTSortedArrayCombinationUnmatchedFirst = 1 << 0,
+
+    /*! Objects in the second array with no match in the first are kept. */
+    TWTSortedArrayCombinationUnmatchedSecond = 1 << 1,
+
+    /*! The first array’s object from each matched pair is kept. */
+    TWTSortedArrayCombinationMatched = 1 << 2
+};
+
+
+/*!
+ Walks two sorted arrays in lockstep, keeping the objects specified by combination. Union, intersection, and 
+ difference are each a different combination.
+ */
+static NSArray *TWTCombineSortedArrays(NSArray *firstArray, NSArray *secondArray, NSComparator comparator,
+                                       TWTSortedArrayCombination combination)
+{
+    NSCParameterAssert(secondArray);
+    NSCParameterAssert(comparator);
+
+    BOOL keepsUnmatchedFirst = (combination & TWTSortedArrayCombinationUnmatchedFirst) != 0;
+    BOOL keepsUnmatchedSecond = (combination & TWTSortedArrayCombinationUnmatchedSecond) != 0;
+    BOOL keepsMatched = (combination & TWTSortedArrayCombinationMatched) != 0;
+
+    NSUInteger firstCount = firstArray.count;
+    NSUInteger secondCount = secondArray.count;
+
+    // Presize for the largest possible result
+    NSUInteger capacity = (keepsUnmatchedFirst ? firstCount : 0) + (keepsUnmatchedSecond ? secondCount : 0);
+    NSMutableArray *result = [[NSMutableArray alloc] initWithCapacity:capacity > 0 ? capacity : MIN(firstCount, secondCount)];
+
+    NSUInteger firstIndex = 0;
+    NSUInteger secondIndex = 0;
+    while (firstIndex < firstCount && secondIndex < secondCount) {
+        id firstObject = firstArray[firstIndex];
+        id secondObject = secondArray[secondIndex];
+
+        NSComparisonResult comparisonResult = comparator(firstObject, secondObject);
+        if (comparisonResult == NSOrderedAscending) {
+            if (keepsUnmatchedFirst) {
+                [result addObject:firstObject];
+            }
+
+            ++firstIndex;
+        } else if (comparisonResult == NSOrderedDescending) {
+            if (keepsUnmatchedSecond) {
+                [result addObject:secondObject];
+            }
+
+            ++secondIndex;
+        } else {
+            if (keepsMatched) {
+                [result addObject:firstObject];
+            }
+
+            ++firstIndex;
+            ++secondIndex;
+        }
+    }
+
+    // Whatever remains of either array is unmatched
+    for (; keepsUnmatchedFirst && firstIndex < firstCount; ++firstIndex) {
+        [result addObject:firstArray[firstIndex]];
+    }
+
+    for (; keepsUnmatchedSecond && secondIndex < secondCount; ++secondIndex) {
+        [result addObject:secondArray[secondIndex]];
+    }
+
+    return result;
+}
+
+
+/*!
+ Compares two entries of a k-way merge heap by their arrays’ next objects, breaking ties by array index so that the
+ merge is stable.
+ */
+static inline NSComparisonResult TWTCompareMergeHeapEntries(NSUInteger arrayIndex1, NSUInteger arrayIndex2,
+                                                            __unsafe_unretained id const *heads, NSComparator comparator)
+{
+    NSComparisonResult result = comparator(heads[arrayIndex1], heads[arrayIndex2]);
+    if (result != NSOrderedSame || arrayIndex1 == arrayIndex2) {
+        return result;
+    }
+
+    return arrayIndex1 < arrayIndex2 ? NSOrderedAscending : NSOrderedDescending;
+}
+
+
+/*!
+ Restores the min-heap property of the first count entries of a k-way merge heap below the specified slot.
+ */
+static void TWTSiftDownMergeHeapEntry(NSUInteger *heap, NSUInteger count, NSUInteger slot,
+                                      __unsafe_unretained id const *heads, NSComparator comparator)
+{
+    for (;;) {
+        NSUInteger least = slot;
+        NSUInteger left = 2 * slot + 1;
+        NSUInteger right = left + 1;
+        if (left < count && TWTCompareMergeHeapEntries(heap[left], heap[least], heads, comparator) == NSOrderedAscending) {
+            least = left;
+        }
+
+        if (right < count && TWTCompareMergeHeapEntries(heap[right], heap[least], heads, comparator) == NSOrderedAscending) {
+            least = right;
+        }
+
+        if (least == slot) {
+            return;
+        }
+
+        NSUInteger entry = heap[least];
+        heap[least] = heap[slot];
+        heap[slot] = entry;
+        slot = least;
+    }
+}
+
+
+@implementation NSArray (TWTSortedArrays)
+
++ (NSArray *)twt_mergeSortedArrays:(NSArray<NSArray *> *)arrays usingComparator:(NSComparator)comparator
+{
+    NSParameterAssert(arrays);
+    NSParameterAssert(comparator);
+
+    NSUInteger arrayCount = arrays.count;
+    NSUInteger totalCount = 0;
+    for (NSArray *array in arrays) {
+        totalCount += array.count;
+    }
+
+    if (totalCount == 0) {
+        return @[];
+    } else if (arrayCount == 1) {
+        return [arrays.firstObject copy];
+    }
+
+    // The heap holds the index of each array with objects left to merge, ordered by each array’s next object, which
+    // is cached in heads. The arrays keep every object alive, so none of the buffers retain their contents
+    __unsafe_unretained NSArray **arrayBuffer = (__unsafe_unretained NSArray **)calloc(arrayCount, sizeof(NSArray *));
+    __unsafe_unretained id *heads = (__unsafe_unretained id *)calloc(arrayCount, sizeof(id));
+    __unsafe_unretained id *mergedObjects = (__unsafe_unretained id *)calloc(totalCount, sizeof(id));
+    NSUInteger *positions = calloc(arrayCount, sizeof(NSUInteger));
+    NSUInteger *heap = calloc(arrayCount, sizeof(NSUInteger));
+
+    [arrays getObjects:arrayBuffer range:NSMakeRange(0, arrayCount)];
+
+    NSUInteger heapCount = 0;
+    for (NSUInteger arrayIndex = 0; arrayIndex < arrayCount; ++arrayIndex) {
+        if (arrayBuffer[arrayIndex].count > 0) {
+            heads[arrayIndex] = arrayBuffer[arrayIndex][0];
+            heap[heapCount++] = arrayIndex;
+        }
+    }
+
+    for (NSUInteger slot = heapCount / 2; slot > 0; --slot) {
+        TWTSiftDownMergeHeapEntry(heap, heapCount, slot - 1, heads, comparator);
+    }
+
+    NSUInteger mergedCount = 0;
+    while (heapCount > 0) {
+        NSUInteger arrayIndex = heap[0];
+        NSArray *array = arrayBuffer[arrayIndex];
+        NSUInteger position = positions[arrayIndex];
+
+        // Once only one array remains, the rest of it can be copied without comparisons
+        if (heapCount == 1) {
+            NSRange remainingRange = NSMakeRange(position, array.count - position);
+            [array getObjects:mergedObjects + mergedCount range:remainingRange];
+            mergedCount += remainingRange.length;
+            break;
+        }
+
+        mergedObjects[mergedCount++] = heads[arrayIndex];
+        positions[arrayIndex] = ++position;
+        if (position < array.count) {
+            heads[arrayIndex] = array[position];
+        } else {
+            heap[0] = heap[--heapCount];
+        }
+
+        TWTSiftDownMergeHeapEntry(heap, heapCount, 0, heads, comparator);
+    }
+
+    NSArray *mergedArray = [[NSArray alloc] initWithObjects:mergedObjects count:mergedCount];
+
+    free(arrayBuffer);
+    free(heads);
+    free(mergedObjects);
+    free(positions);
+    free(heap);
+    return mergedArray;
+}
+
+
+- (NSArray *)twt_unionWithSortedArray:(NSArray *)array usingComparator:(NSComparator)comparator
+{
+    return TWTCombineSortedArrays(self, array, comparator, TWTSortedArrayCombinationUnmatchedFirst |
+                                  TWTSortedArrayCombinationUnmatchedSecond | TWTSortedArrayCombinationMatched);
+}
+
+
+- (NSArray *)twt_intersectionWithSortedArray:(NSArray *)array usingComparator:(NSComparator)comparator
+{
+    return TWTCombineSortedArrays(self, array, comparator, TWTSortedArrayCombinationMatched);
+}
+
+
+- (NSArray *)twt_differenceWithSortedArray:(NSArray *)array usingComparator:(NSComparator)comparator
+{
+    return TWTCombineSortedArrays(self, array, comparator, TWTSortedArrayCombinationUnmatchedFirst);
+}
+
+@end
+
+
+#pragma mark - Dictionaries
+
+@implementation NSDictionary (TWTBlockEnumeration)
+
+- (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    return [self twt_collectWithOptions:0 block:block];
+}
+
+
+- (id)twt_collectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationCollectBlock)block
+{
+    return [TWTBlockEnumerator performCollectOnObject:self
+                               resultsCollectionClass:[NSMutableDictionary class]
+                                              options:options
+                                                block:block];
+}
+
+
+- (void)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block intoCollection:(id)collection
+{
+    [TWTBlockEnumerator performCollectOnObject:self intoCollection:collection options:0 block:block];
+}
+
+
+- (NSDictionary *)twt_countByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performCountOnObject:self block:block];
+}
+
+
+- (id)twt_flatten
+{
+    return [self twt_flattenWithMaximumDepth:NSUIntegerMax];
+}
+
+
+- (id)twt_flattenWithMaximumDepth:(NSUInteger)maximumDepth
+{
+    return [TWTBlockEnumerator performDictionaryFlattenOnObject:self maximumDepth:maximumDepth];
+}
+
+
+- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+}
+
+
+- (id)twt_distinctByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performDistinctOnObject:self resultsCollectionClass:[NSMutableDictionary class] block:block];
+}
+
+
+- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [self twt_groupWithOptions:0 block:block];
+}
+
+
+- (NSDictionary *)twt_groupWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performGroupOnObject:self
+                             resultsCollectionClass:[NSMutableDictionary class]
+                                            options:options
+                                              block:block];
+}
+
+
+- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+{
+    return [self twt_injectWithOptions:0 initialObject:initialObject block:block];
+}
+
+
+- (id)twt_injectWithOptions:(TWTBlockEnumerationOptions)options
+              initialObject:(id)initialObject
+                      block:(TWTBlockEnumerationInjectBlock)block
+{
+    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject options:options block:block];
+}
+
+
+- (NSArray *)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performPartitionOnObject:self resultsCollectionClass:[NSMutableDictionary class] block:block];
+}
+
+
+- (void)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+        intoSelectedCollection:(id)selectedCollection
+            rejectedCollection:(id)rejectedCollection
+{
+    NSParameterAssert(selectedCollection);
+    NSParameterAssert(rejectedCollection);
+    [TWTBlockEnumerator performPartitionOnObject:self
+                              selectedCollection:selectedCollection
+                              rejectedCollection:rejectedCollection
+                                         options:0
+                                           block:block];
+}
+
+
+- (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_rejectWithOptions:0 block:block];
+}
+
+
+- (id)twt_rejectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performRejectOnObject:self
+                              resultsCollectionClass:[NSMutableDictionary class]
+                                             options:options
+                                               block:block];
+}
+
+
+- (void)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
+{
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:nil rejectedCollection:collection options:0 block:block];
+}
+
+
+- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_selectWithOptions:0 block:block];
+}
+
+
+- (id)twt_selectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performSelectOnObject:self
+                              resultsCollectionClass:[NSMutableDictionary class]
+                                             options:options
+                                               block:block];
+}
+
+
+- (void)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
+{
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:collection rejectedCollection:nil options:0 block:block];
+}
+
+
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size
+{
+    return [self twt_sampleOfSize:size seed:TWTBlockEnumerationRandomSeed()];
+}
+
+
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size seed:(uint64_t)seed
+{
+    return [TWTBlockEnumerator performSampleOnObject:self size:size seed:seed];
+}
+
+
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [self twt_sampleOfSize:size groupedByBlock:block seed:TWTBlockEnumerationRandomSeed()];
+}
+
+
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size
+                    groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+                              seed:(uint64_t)seed
+{
+    return [TWTBlockEnumerator performSampleOnObject:self size:size groupBlock:block seed:seed];
+}
+
+
+- (NSArray *)twt_sortedByBlock:(TWTBlockEnumerationSortKeyBlock)block
+{
+    return [TWTBlockEnumerator performSortOnObject:self block:block];
+}
+
+
+- (NSArray *)twt_topK:(NSUInteger)k byBlock:(TWTBlockEnumerationSortKeyBlock)block
+{
+    return [TWTBlockEnumerator performTopKOnObject:self count:k block:block];
+}
+
+@end
+
+
+#pragma mark - Enumerators
+
+@implementation NSEnumerator (TWTBlockEnumeration)
+
+- (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    return [self twt_collectWithOptions:0 block:block];
+}
+
+
+- (id)twt_collectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationCollectBlock)block
+{
+    return [TWTBlockEnumerator performCollectOnObject:self
+                               resultsCollectionClass:[NSMutableArray class]
+                                              options:options
+                                                block:block];
+}
+
+
+- (void)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block intoCollection:(id)collection
+{
+    [TWTBlockEnumerator performCollectOnObject:self intoCollection:collection options:0 block:block];
+}
+
+
+- (NSDictionary *)twt_countByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performCountOnObject:self block:block];
+}
+
+
+- (id)twt_flatten
+{
+    return [self twt_flattenWithMaximumDepth:NSUIntegerMax];
+}
+
+
+- (id)twt_flattenWithMaximumDepth:(NSUInteger)maximumDepth
+{
+    return [TWTBlockEnumerator performCollectionFlattenOnObject:self
+                                         resultsCollectionClass:[NSMutableArray class]
+                                                   maximumDepth:maximumDepth];
+}
+
+
+- (NSEnumerator *)twt_flattenedObjectEnumeratorWithMaximumDepth:(NSUInteger)maximumDepth
+{
+    return [[TWTFlattenedObjectEnumerator alloc] initWithCollection:self maximumDepth:maximumDepth];
+}
+
+
+- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+}
+
+
+- (id)twt_distinctByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performDistinctOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+}
+
+
+- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [self twt_groupWithOptions:0 block:block];
+}
 
-@implementation TWTBlockEnumerator
 
-+ (id)performCollectOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationCollectBlock)block;
+- (NSDictionary *)twt_groupWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationGroupBlock)block
 {
-    NSParameterAssert(object);
-    NSParameterAssert(collectionClass);
-    NSParameterAssert(block);
-
-    id collection = [[collectionClass alloc] init];
+    return [TWTBlockEnumerator performGroupOnObject:self
+                             resultsCollectionClass:[NSMutableArray class]
+                                            options:options
+                                              block:block];
+}
 
-    BOOL respondsToSetObjectForKey = [collection respondsToSelector:@selector(setObject:forKey:)];
-    for (id element in object) {
-        id result = block(element);
-        if (!result) {
-            result = [NSNull null];
-        }
-        
-        if (respondsToSetObjectForKey) {
-            [collection setObject:result forKey:element];
-        } else {
-            [collection addObject:result];
-        }
-    }
 
-    return collection;
+- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+{
+    return [self twt_injectWithOptions:0 initialObject:initialObject block:block];
 }
 
 
-+ (id)performDictionaryFlattenOnObject:(NSDictionary *)dictionary
+- (id)twt_injectWithOptions:(TWTBlockEnumerationOptions)options
+              initialObject:(id)initialObject
+                      block:(TWTBlockEnumerationInjectBlock)block
 {
-    NSParameterAssert(dictionary);
-    
-    NSMutableDictionary *flattenedDictionary = [[NSMutableDictionary alloc] init];
-    
-    for (id<NSCopying> key in dictionary) {
-        id result = dictionary[key];
-        
-        if ([result respondsToSelector:@selector(objectForKey:)]) {
-            [flattenedDictionary addEntriesFromDictionary:[self performDictionaryFlattenOnObject:result]];
-        }
-        else {
-            [flattenedDictionary setObject:result forKey:key];
-        }
-    }
-    
-    return flattenedDictionary;
+    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject options:options block:block];
 }
 
 
-+ (id)performCollectionFlattenOnObject:(id <NSFastEnumeration>)collection resultsCollectionClass:collectionClass
+- (NSArray *)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
 {
-    NSParameterAssert(collection);
-    NSParameterAssert(collectionClass);
-    
-    id flattenedCollection = [[collectionClass alloc] init];
+    return [TWTBlockEnumerator performPartitionOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+}
 
-    for (id element in collection) {
-        if ([element respondsToSelector:@selector(countByEnumeratingWithState:objects:count:)]) {
-            [flattenedCollection addObjectsFromArray:[self performCollectionFlattenOnObject:element resultsCollectionClass:[NSMutableArray class]]];
-        }
-        else {
-            [flattenedCollection addObject:element];
-        }
-    }
-    
-    return flattenedCollection;
+
+- (void)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+        intoSelectedCollection:(id)selectedCollection
+            rejectedCollection:(id)rejectedCollection
+{
+    NSParameterAssert(selectedCollection);
+    NSParameterAssert(rejectedCollection);
+    [TWTBlockEnumerator performPartitionOnObject:self
+                              selectedCollection:selectedCollection
+                              rejectedCollection:rejectedCollection
+                                         options:0
+                                           block:block];
 }
 
 
-+ (id)performDetectOnObject:(id <NSFastEnumeration>)object block:(TWTBlockEnumerationPredicateBlock)block;
+- (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
 {
-    NSParameterAssert(object);
-    NSParameterAssert(block);
-    
-    id collection = object;
-    BOOL respondsToObjectForKey = [[collection class] instancesRespondToSelector:@selector(objectForKey:)];
-    
-    for (id element in collection) {
-        if (block(element)) {
-            if (respondsToObjectForKey) {
-                return [collection objectForKey:element];
-            } else {
-                return element;
-            }
-        }
-    }
+    return [self twt_rejectWithOptions:0 block:block];
+}
 
-    return nil;
+
+- (id)twt_rejectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performRejectOnObject:self
+                              resultsCollectionClass:[NSMutableArray class]
+                                             options:options
+                                               block:block];
 }
 
 
-+ (NSDictionary *)performGroupOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationGroupBlock)block
+- (void)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
 {
-    NSParameterAssert(object);
-    NSParameterAssert(collectionClass);
-    NSParameterAssert(block);
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:nil rejectedCollection:collection options:0 block:block];
+}
 
-    NSMutableDictionary *groups = [[NSMutableDictionary alloc] init];
 
-    id collection = object;
-    BOOL respondsToSetObjectForKey = [collectionClass instancesRespondToSelector:@selector(setObject:forKey:)];
+- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_selectWithOptions:0 block:block];
+}
 
-    // If the collection class responds to setObject:forKey:, the collection must respond to objectForKey:
-    NSAssert(!respondsToSetObjectForKey || [collection respondsToSelector:@selector(objectForKey:)],
-             @"Only collections that respond to -objectForKey: may have resultsCollectionClasses that respond to -setObject:forKey:");
 
-    for (id element in collection) {
-        id<NSCopying> groupKey = block(element);
-        if (!groupKey) {
-            groupKey = [NSNull null];
-        }
+- (id)twt_selectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performSelectOnObject:self
+                              resultsCollectionClass:[NSMutableArray class]
+                                             options:options
+                                               block:block];
+}
 
-        id group = groups[groupKey];
-        if (!group) {
-            group = [[collectionClass alloc] init];
-            groups[groupKey] = group;
-        }
 
-        if (respondsToSetObjectForKey) {
-            [group setObject:[collection objectForKey:element] forKey:element];
-        } else {
-            [group addObject:element];
-        }
-    }
+- (void)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
+{
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:collection rejectedCollection:nil options:0 block:block];
+}
 
-    return groups;
+
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size
+{
+    return [self twt_sampleOfSize:size seed:TWTBlockEnumerationRandomSeed()];
 }
 
 
-+ (id)performInjectOnObject:(id <NSFastEnumeration>)object initialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block;
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size seed:(uint64_t)seed
 {
-    NSParameterAssert(object);
-    NSParameterAssert(block);
+    return [TWTBlockEnumerator performSampleOnObject:self size:size seed:seed];
+}
 
-    id total = initialObject;
-    for (id element in object) {
-        total = block(total, element);
-    }
 
-    return total;
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [self twt_sampleOfSize:size groupedByBlock:block seed:TWTBlockEnumerationRandomSeed()];
 }
 
 
-+ (id)performRejectOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationPredicateBlock)block;
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size
+                    groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+                              seed:(uint64_t)seed
 {
-    return [self performSelectOnObject:object resultsCollectionClass:collectionClass block:^BOOL(id element) {
-        return !block(element);
-    }];
+    return [TWTBlockEnumerator performSampleOnObject:self size:size groupBlock:block seed:seed];
 }
 
 
-+ (id)performSelectOnObject:(id <NSFastEnumeration>)object resultsCollectionClass:(Class)collectionClass block:(TWTBlockEnumerationPredicateBlock)block;
+- (NSArray *)twt_sortedByBlock:(TWTBlockEnumerationSortKeyBlock)block
 {
-    NSParameterAssert(object);
-    NSParameterAssert(collectionClass);
-    NSParameterAssert(block);
+    return [TWTBlockEnumerator performSortOnObject:self block:block];
+}
 
-    id collection = [[collectionClass alloc] init];
-    
-    BOOL respondsToSetObjectForKey = [collection respondsToSelector:@selector(setObject:forKey:)];
-    for (id element in object) {
-        if (block(element)) {
-            if (respondsToSetObjectForKey) {
-                [collection setObject:[(id)object objectForKey:element] forKey:element];
-            } else {
-                [collection addObject:element];
-            }
-        }
-    }
 
-    return collection;
+- (NSArray *)twt_topK:(NSUInteger)k byBlock:(TWTBlockEnumerationSortKeyBlock)block
+{
+    return [TWTBlockEnumerator performTopKOnObject:self count:k block:block];
 }
 
 @end
 
 
-#pragma mark - Arrays
+#pragma mark - Ordered Sets
 
-@implementation NSArray (TWTBlockEnumeration)
+@implementation NSOrderedSet (TWTBlockEnumeration)
 
 - (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
 {
-    return [TWTBlockEnumerator performCollectOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [self twt_collectWithOptions:0 block:block];
 }
 
 
-- (id)twt_flatten
+- (id)twt_collectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationCollectBlock)block
 {
-    return [TWTBlockEnumerator performCollectionFlattenOnObject:self resultsCollectionClass:[NSMutableArray class]];
+    return [TWTBlockEnumerator performCollectOnObject:self
+                               resultsCollectionClass:[NSMutableOrderedSet class]
+                                              options:options
+                                                block:block];
 }
 
 
-- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (void)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block intoCollection:(id)collection
 {
-    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+    [TWTBlockEnumerator performCollectOnObject:self intoCollection:collection options:0 block:block];
 }
 
 
-- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
+- (NSDictionary *)twt_countByBlock:(TWTBlockEnumerationGroupBlock)block
 {
-    return [TWTBlockEnumerator performGroupOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [TWTBlockEnumerator performCountOnObject:self block:block];
 }
 
 
-- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+- (id)twt_flatten
 {
-    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject block:block];
+    return [self twt_flattenWithMaximumDepth:NSUIntegerMax];
 }
 
 
-- (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (id)twt_flattenWithMaximumDepth:(NSUInteger)maximumDepth
 {
-    return [TWTBlockEnumerator performRejectOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [TWTBlockEnumerator performCollectionFlattenOnObject:self
+                                         resultsCollectionClass:[NSMutableOrderedSet class]
+                                                   maximumDepth:maximumDepth];
 }
 
 
-- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (NSEnumerator *)twt_flattenedObjectEnumeratorWithMaximumDepth:(NSUInteger)maximumDepth
 {
-    return [TWTBlockEnumerator performSelectOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [[TWTFlattenedObjectEnumerator alloc] initWithCollection:self maximumDepth:maximumDepth];
 }
 
-@end
+
+- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+}
 
 
-#pragma mark - Dictionaries
+- (id)twt_distinctByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performDistinctOnObject:self resultsCollectionClass:[NSMutableOrderedSet class] block:block];
+}
 
-@implementation NSDictionary (TWTBlockEnumeration)
 
-- (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
+- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
 {
-    return [TWTBlockEnumerator performCollectOnObject:self resultsCollectionClass:[NSMutableDictionary class] block:block];
+    return [self twt_groupWithOptions:0 block:block];
 }
 
 
-- (id)twt_flatten
+- (NSDictionary *)twt_groupWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationGroupBlock)block
 {
-    return [TWTBlockEnumerator performDictionaryFlattenOnObject:self];
+    return [TWTBlockEnumerator performGroupOnObject:self
+                             resultsCollectionClass:[NSMutableOrderedSet class]
+                                            options:options
+                                              block:block];
 }
 
 
-- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
 {
-    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+    return [self twt_injectWithOptions:0 initialObject:initialObject block:block];
 }
 
 
-- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
+- (id)twt_injectWithOptions:(TWTBlockEnumerationOptions)options
+              initialObject:(id)initialObject
+                      block:(TWTBlockEnumerationInjectBlock)block
 {
-    return [TWTBlockEnumerator performGroupOnObject:self resultsCollectionClass:[NSMutableDictionary class] block:block];
+    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject options:options block:block];
 }
 
 
-- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+- (NSArray *)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
 {
-    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject block:block];
+    return [TWTBlockEnumerator performPartitionOnObject:self resultsCollectionClass:[NSMutableOrderedSet class] block:block];
+}
+
+
+- (void)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+        intoSelectedCollection:(id)selectedCollection
+            rejectedCollection:(id)rejectedCollection
+{
+    NSParameterAssert(selectedCollection);
+    NSParameterAssert(rejectedCollection);
+    [TWTBlockEnumerator performPartitionOnObject:self
+                              selectedCollection:selectedCollection
+                              rejectedCollection:rejectedCollection
+                                         options:0
+                                           block:block];
 }
 
 
 - (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
 {
-    return [TWTBlockEnumerator performRejectOnObject:self resultsCollectionClass:[NSMutableDictionary class] block:block];
+    return [self twt_rejectWithOptions:0 block:block];
 }
 
 
-- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (id)twt_rejectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
 {
-    return [TWTBlockEnumerator performSelectOnObject:self resultsCollectionClass:[NSMutableDictionary class] block:block];
+    return [TWTBlockEnumerator performRejectOnObject:self
+                              resultsCollectionClass:[NSMutableOrderedSet class]
+                                             options:options
+                                               block:block];
 }
 
-@end
+
+- (void)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
+{
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:nil rejectedCollection:collection options:0 block:block];
+}
 
 
-#pragma mark - Enumerators
+- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_selectWithOptions:0 block:block];
+}
 
-@implementation NSEnumerator (TWTBlockEnumeration)
 
-- (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
+- (id)twt_selectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
 {
-    return [TWTBlockEnumerator performCollectOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [TWTBlockEnumerator performSelectOnObject:self
+                              resultsCollectionClass:[NSMutableOrderedSet class]
+                                             options:options
+                                               block:block];
 }
 
 
-- (id)twt_flatten
+- (void)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
 {
-    return [TWTBlockEnumerator performCollectionFlattenOnObject:self resultsCollectionClass:[NSMutableArray class]];
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:collection rejectedCollection:nil options:0 block:block];
 }
 
 
-- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size
 {
-    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+    return [self twt_sampleOfSize:size seed:TWTBlockEnumerationRandomSeed()];
 }
 
 
-- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size seed:(uint64_t)seed
 {
-    return [TWTBlockEnumerator performGroupOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [TWTBlockEnumerator performSampleOnObject:self size:size seed:seed];
 }
 
 
-- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size groupedByBlock:(TWTBlockEnumerationGroupBlock)block
 {
-    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject block:block];
+    return [self twt_sampleOfSize:size groupedByBlock:block seed:TWTBlockEnumerationRandomSeed()];
 }
 
 
-- (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size
+                    groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+                              seed:(uint64_t)seed
 {
-    return [TWTBlockEnumerator performRejectOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [TWTBlockEnumerator performSampleOnObject:self size:size groupBlock:block seed:seed];
 }
 
 
-- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (NSArray *)twt_sortedByBlock:(TWTBlockEnumerationSortKeyBlock)block
 {
-    return [TWTBlockEnumerator performSelectOnObject:self resultsCollectionClass:[NSMutableArray class] block:block];
+    return [TWTBlockEnumerator performSortOnObject:self block:block];
+}
+
+
+- (NSArray *)twt_topK:(NSUInteger)k byBlock:(TWTBlockEnumerationSortKeyBlock)block
+{
+    return [TWTBlockEnumerator performTopKOnObject:self count:k block:block];
 }
 
 @end
 
 
-#pragma mark - Ordered Sets
+#pragma mark - Sets
 
-@implementation NSOrderedSet (TWTBlockEnumeration)
+@implementation NSSet (TWTBlockEnumeration)
 
 - (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
 {
-    return [TWTBlockEnumerator performCollectOnObject:self resultsCollectionClass:[NSMutableOrderedSet class] block:block];
+    return [self twt_collectWithOptions:0 block:block];
+}
+
+
+- (id)twt_collectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationCollectBlock)block
+{
+    return [TWTBlockEnumerator performCollectOnObject:self
+                               resultsCollectionClass:[NSMutableSet class]
+                                              options:options
+                                                block:block];
+}
+
+
+- (void)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block intoCollection:(id)collection
+{
+    [TWTBlockEnumerator performCollectOnObject:self intoCollection:collection options:0 block:block];
+}
+
+
+- (NSDictionary *)twt_countByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performCountOnObject:self block:block];
 }
 
 
 - (id)twt_flatten
 {
-    return [TWTBlockEnumerator performCollectionFlattenOnObject:self resultsCollectionClass:[NSMutableOrderedSet class]];
+    return [self twt_flattenWithMaximumDepth:NSUIntegerMax];
+}
+
+
+- (id)twt_flattenWithMaximumDepth:(NSUInteger)maximumDepth
+{
+    return [TWTBlockEnumerator performCollectionFlattenOnObject:self
+                                         resultsCollectionClass:[NSMutableSet class]
+                                                   maximumDepth:maximumDepth];
+}
+
+
+- (NSEnumerator *)twt_flattenedObjectEnumeratorWithMaximumDepth:(NSUInteger)maximumDepth
+{
+    return [[TWTFlattenedObjectEnumerator alloc] initWithCollection:self maximumDepth:maximumDepth];
 }
 
 
@@ -391,75 +2116,140 @@
 }
 
 
+- (id)twt_distinctByBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performDistinctOnObject:self resultsCollectionClass:[NSMutableSet class] block:block];
+}
+
+
 - (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
 {
-    return [TWTBlockEnumerator performGroupOnObject:self resultsCollectionClass:[NSMutableOrderedSet class] block:block];
+    return [self twt_groupWithOptions:0 block:block];
+}
+
+
+- (NSDictionary *)twt_groupWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationGroupBlock)block
+{
+    return [TWTBlockEnumerator performGroupOnObject:self
+                             resultsCollectionClass:[NSMutableSet class]
+                                            options:options
+                                              block:block];
 }
 
 
 - (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
 {
-    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject block:block];
+    return [self twt_injectWithOptions:0 initialObject:initialObject block:block];
+}
+
+
+- (id)twt_injectWithOptions:(TWTBlockEnumerationOptions)options
+              initialObject:(id)initialObject
+                      block:(TWTBlockEnumerationInjectBlock)block
+{
+    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject options:options block:block];
+}
+
+
+- (NSArray *)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [TWTBlockEnumerator performPartitionOnObject:self resultsCollectionClass:[NSMutableSet class] block:block];
+}
+
+
+- (void)twt_partitionWithBlock:(TWTBlockEnumerationPredicateBlock)block
+        intoSelectedCollection:(id)selectedCollection
+            rejectedCollection:(id)rejectedCollection
+{
+    NSParameterAssert(selectedCollection);
+    NSParameterAssert(rejectedCollection);
+    [TWTBlockEnumerator performPartitionOnObject:self
+                              selectedCollection:selectedCollection
+                              rejectedCollection:rejectedCollection
+                                         options:0
+                                           block:block];
 }
 
 
 - (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
 {
-    return [TWTBlockEnumerator performRejectOnObject:self resultsCollectionClass:[NSMutableOrderedSet class] block:block];
+    return [self twt_rejectWithOptions:0 block:block];
 }
 
 
-- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (id)twt_rejectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
 {
-    return [TWTBlockEnumerator performSelectOnObject:self resultsCollectionClass:[NSMutableOrderedSet class] block:block];
+    return [TWTBlockEnumerator performRejectOnObject:self
+                              resultsCollectionClass:[NSMutableSet class]
+                                             options:options
+                                               block:block];
 }
 
-@end
 
+- (void)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
+{
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:nil rejectedCollection:collection options:0 block:block];
+}
 
-#pragma mark - Sets
 
-@implementation NSSet (TWTBlockEnumeration)
+- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_selectWithOptions:0 block:block];
+}
 
-- (id)twt_collectWithBlock:(TWTBlockEnumerationCollectBlock)block
+
+- (id)twt_selectWithOptions:(TWTBlockEnumerationOptions)options block:(TWTBlockEnumerationPredicateBlock)block
 {
-    return [TWTBlockEnumerator performCollectOnObject:self resultsCollectionClass:[NSMutableSet class] block:block];
+    return [TWTBlockEnumerator performSelectOnObject:self
+                              resultsCollectionClass:[NSMutableSet class]
+                                             options:options
+                                               block:block];
 }
 
 
-- (id)twt_flatten
+- (void)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block intoCollection:(id)collection
 {
-    return [TWTBlockEnumerator performCollectionFlattenOnObject:self resultsCollectionClass:[NSMutableSet class]];
+    NSParameterAssert(collection);
+    [TWTBlockEnumerator performPartitionOnObject:self selectedCollection:collection rejectedCollection:nil options:0 block:block];
 }
 
 
-- (id)twt_detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size
 {
-    return [TWTBlockEnumerator performDetectOnObject:self block:block];
+    return [self twt_sampleOfSize:size seed:TWTBlockEnumerationRandomSeed()];
 }
 
 
-- (id)twt_groupWithBlock:(TWTBlockEnumerationGroupBlock)block
+- (NSArray *)twt_sampleOfSize:(NSUInteger)size seed:(uint64_t)seed
 {
-    return [TWTBlockEnumerator performGroupOnObject:self resultsCollectionClass:[NSMutableSet class] block:block];
+    return [TWTBlockEnumerator performSampleOnObject:self size:size seed:seed];
 }
 
 
-- (id)twt_injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size groupedByBlock:(TWTBlockEnumerationGroupBlock)block
 {
-    return [TWTBlockEnumerator performInjectOnObject:self initialObject:initialObject block:block];
+    return [self twt_sampleOfSize:size groupedByBlock:block seed:TWTBlockEnumerationRandomSeed()];
 }
 
 
-- (id)twt_rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (NSDictionary *)twt_sampleOfSize:(NSUInteger)size
+                    groupedByBlock:(TWTBlockEnumerationGroupBlock)block
+                              seed:(uint64_t)seed
 {
-    return [TWTBlockEnumerator performRejectOnObject:self resultsCollectionClass:[NSMutableSet class] block:block];
+    return [TWTBlockEnumerator performSampleOnObject:self size:size groupBlock:block seed:seed];
 }
 
 
-- (id)twt_selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+- (NSArray *)twt_sortedByBlock:(TWTBlockEnumerationSortKeyBlock)block
+{
+    return [TWTBlockEnumerator performSortOnObject:self block:block];
+}
+
+
+- (NSArray *)twt_topK:(NSUInteger)k byBlock:(TWTBlockEnumerationSortKeyBlock)block
 {
-    return [TWTBlockEnumerator performSelectOnObject:self resultsCollectionClass:[NSMutableSet class] block:block];
+    return [TWTBlockEnumerator performTopKOnObject:self count:k block:block];
 }
 
 @end
@@ -0,0 +1,212 @@
+//
+//  TWTConcurrentBlockEnumeration.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTBlockEnumeration.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ Collections with fewer elements than this are enumerated serially by the concurrent block enumeration methods, since
+ the cost of dispatching work to other cores outweighs any benefit.
+ */
+extern const NSUInteger kTWTConcurrentBlockEnumerationSerialThreshold;
+
+
+/*!
+ @abstract Type for blocks that combine two partial results of a reduction into one.
+ @discussion This block type is used for concurrent reduce operations. It must be associative, i.e., combining a with
+     the combination of b and c must be equivalent to combining the combination of a and b with c. It need not be
+     commutative; the partial result of earlier elements is always the first parameter.
+ @param partialResult The partial result of reducing some run of elements.
+ @param nextPartialResult The partial result of reducing the run of elements immediately following those of 
+     partialResult.
+ @result The result of reducing both runs of elements.
+ */
+typedef id _Nullable (^TWTBlockEnumerationCombineBlock)(id _Nullable partialResult, id _Nullable nextPartialResult);
+
+/*!
+ @abstract Type for blocks that return a new, empty mutable accumulator.
+ @discussion This block type is used for concurrent reduce operations with mutable accumulators.
+ @result A new accumulator, e.g., an empty mutable set.
+ */
+typedef id _Nonnull (^TWTBlockEnumerationAccumulatorBlock)(void);
+
+/*!
+ @abstract Type for blocks that add an element to a mutable accumulator in place.
+ @discussion This block type is used for concurrent reduce operations with mutable accumulators.
+ @param accumulator The accumulator to modify.
+ @param element The element being enumerated.
+ */
+typedef void (^TWTBlockEnumerationAccumulateBlock)(id accumulator, id element);
+
+/*!
+ @abstract Type for blocks that merge one mutable accumulator into another in place.
+ @discussion This block type is used for concurrent reduce operations with mutable accumulators. Like 
+     TWTBlockEnumerationCombineBlock, it must be associative but need not be commutative.
+ @param accumulator The accumulator of some run of elements. This is modified to include nextAccumulator.
+ @param nextAccumulator The accumulator of the run of elements immediately following those of accumulator.
+ */
+typedef void (^TWTBlockEnumerationMergeBlock)(id accumulator, id nextAccumulator);
+
+
+/*!
+ @abstract Protocol that exposes concurrent counterparts of the TWTBlockEnumeration methods.
+ @discussion These methods split the receiver into fixed-size chunks and process the chunks on multiple cores, then 
+     combine the per-chunk results in the receiver’s order. They return the same results as their serial 
+     counterparts, but the block is invoked concurrently on multiple threads and in no particular order, so it must 
+     be thread-safe and free of order-dependent side effects. They are worthwhile when the receiver is large or the
+     block is expensive; receivers with fewer than kTWTConcurrentBlockEnumerationSerialThreshold elements are 
+     enumerated serially on the calling thread. 
+ 
+     Unordered collections and enumerators are first copied into an array, which is then processed concurrently. 
+     In every case, the calling thread blocks until all elements have been processed.
+ */
+@protocol TWTConcurrentBlockEnumeration <TWTBlockEnumeration>
+
+/*!
+ @abstract Concurrently performs the given block on each element in the receiver and returns a collection of the 
+     results.
+ @discussion This returns the same result as ‑twt_collectWithBlock:.
+ @param block The block to invoke against each element of the collection. May be invoked concurrently. May not be nil.
+ @result A new instance of the collection with the results of invoking the block on each element of the original 
+     collection.
+ */
+- (id)twt_concurrentCollectWithBlock:(TWTBlockEnumerationCollectBlock)block;
+
+/*!
+ @abstract Concurrently passes elements in the receiver to the block until it returns YES, and returns the first 
+     element for which it did.
+ @discussion This returns the same result as ‑twt_detectWithBlock:. Workers share an atomic match index, and stop 
+     as soon as they reach an element beyond the lowest match found so far, so elements after the match are mostly
+     not tested. For ordered collections, i.e., arrays, ordered sets, and enumerators, the lowest-index match is 
+     returned even if a later match was found first. Unordered collections have no first element, so for them this
+     behaves like ‑twt_concurrentDetectAnyWithBlock:.
+ @param block Predicate block to test elements in the collection. May be invoked concurrently. May not be nil.
+ @result The first element for which the block returns YES, or nil if there is no such element.
+ */
+- (nullable id)twt_concurrentDetectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Concurrently passes elements in the receiver to the block until it returns YES, and returns whichever
+     element for which it did was found first.
+ @discussion This relaxes ‑twt_concurrentDetectWithBlock: for cases in which any match will do. Every worker stops as
+     soon as any worker finds a match, so it tests fewer elements, but the element it returns may differ from run to
+     run when there are multiple matches.
+ @param block Predicate block to test elements in the collection. May be invoked concurrently. May not be nil.
+ @result An element for which the block returns YES, or nil if there is no such element.
+ */
+- (nullable id)twt_concurrentDetectAnyWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Concurrently groups the elements in the receiver by the values returned by the block.
+ @discussion This returns the same result as ‑twt_groupWithBlock:, including the relative order of elements within
+     each group. Each worker groups its own chunk of the receiver into a private partial map, with no locking or
+     sharing between workers. The partial maps are split by key hash so that they can also be merged concurrently,
+     one hash partition per worker, in the receiver’s order.
+ @param block Block that returns the group key that should be used for a given collection element. May be invoked
+     concurrently. May not be nil.
+ @result A dictionary whose keys are the return values of the block and whose values are collections of elements
+     for which the block returned that value.
+ */
+- (NSDictionary *)twt_concurrentGroupWithBlock:(TWTBlockEnumerationGroupBlock)block;
+
+/*!
+ @abstract Reduces the elements of the receiver to a single value by reducing chunks of it concurrently and then
+     combining the chunks’ partial results in a balanced tree.
+ @discussion Each chunk is reduced like ‑twt_injectWithInitialObject:block:, starting with identity as the memo. 
+     Adjacent partial results are then combined pairwise, with each level of the tree combined concurrently, until one
+     result remains. The result is the same as that of ‑twt_injectWithInitialObject:block: as long as the reduction 
+     is associative and identity is an identity for it, e.g., 0 for sums or the empty set for set unions. Because 
+     identity is shared by every chunk, it should be immutable.
+ @param identity The identity value of the reduction. This is the result if the receiver is empty.
+ @param block The block to invoke for each element and the current memo. May be invoked concurrently. May not be nil.
+ @param combiner The block to combine adjacent partial results. May be invoked concurrently. May not be nil.
+ @result The result of the reduction.
+ */
+- (nullable id)twt_reduceWithIdentity:(nullable id)identity
+                                block:(TWTBlockEnumerationInjectBlock)block
+                             combiner:(TWTBlockEnumerationCombineBlock)combiner;
+
+/*!
+ @abstract Reduces the elements of the receiver into mutable accumulators concurrently and merges the accumulators 
+     in a balanced tree.
+ @discussion This is like ‑twt_reduceWithIdentity:block:combiner:, but rather than allocating a new memo for every
+     element, each chunk creates a single accumulator and the block modifies it in place. Adjacent accumulators are
+     then merged in place until one remains.
+ @param accumulatorBlock The block that returns a new, empty accumulator. This is invoked once per chunk. May not be
+     nil.
+ @param block The block to add an element to an accumulator. May be invoked concurrently, but never concurrently on
+     the same accumulator. May not be nil.
+ @param merger The block to merge adjacent accumulators. May be invoked concurrently, but never concurrently on the 
+     same accumulators. May not be nil.
+ @result The accumulator that contains every element of the receiver.
+ */
+- (id)twt_reduceWithAccumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                               block:(TWTBlockEnumerationAccumulateBlock)block
+                              merger:(TWTBlockEnumerationMergeBlock)merger;
+
+/*!
+ @abstract Concurrently passes each element in the receiver to the block and returns a collection of the elements for
+     which the block returned NO.
+ @discussion This returns the same result as ‑twt_rejectWithBlock:.
+ @param block Predicate block to test elements in the collection. May be invoked concurrently. May not be nil.
+ @result A new instance of the collection with the elements that were not rejected.
+ */
+- (id)twt_concurrentRejectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Concurrently passes each element in the receiver to the block and returns a collection of the elements for
+     which the block returned YES.
+ @discussion This returns the same result as ‑twt_selectWithBlock:.
+ @param block Predicate block to test elements in the collection. May be invoked concurrently. May not be nil.
+ @result A new instance of the collection with the elements that were selected.
+ */
+- (id)twt_concurrentSelectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+@end
+
+
+#pragma mark
+
+@interface NSArray (TWTConcurrentBlockEnumeration) <TWTConcurrentBlockEnumeration>
+@end
+
+@interface NSDictionary (TWTConcurrentBlockEnumeration) <TWTConcurrentBlockEnumeration>
+@end
+
+@interface NSEnumerator (TWTConcurrentBlockEnumeration) <TWTConcurrentBlockEnumeration>
+@end
+
+@interface NSOrderedSet (TWTConcurrentBlockEnumeration) <TWTConcurrentBlockEnumeration>
+@end
+
+@interface NSSet (TWTConcurrentBlockEnumeration) <TWTConcurrentBlockEnumeration>
+@end
+
+NS_ASSUME_NONNULL_END
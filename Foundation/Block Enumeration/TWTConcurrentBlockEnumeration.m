@@ -0,0 +1,842 @@
+//
+//  TWTConcurrentBlockEnumeration.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTConcurrentBlockEnumeration.h"
+
+#import <stdatomic.h>
+
+
+const NSUInteger kTWTConcurrentBlockEnumerationSerialThreshold = 2048;
+
+// Each chunk’s object pointers take up 8 KB, which fits comfortably in L1 alongside the block’s working set
+enum {
+    kTWTConcurrentBlockEnumerationChunkSize = 1024
+};
+
+
+#pragma mark TWTConcurrentBlockEnumerator
+
+/*!
+ TWTConcurrentBlockEnumerator does the work of concurrent block enumerations. It operates on indexed collections, i.e.,
+ NSArrays and NSOrderedSets, and returns its results as arrays in the collection’s order. The categories below convert
+ their receivers to and results from arrays as needed.
+ */
+@interface TWTConcurrentBlockEnumerator : NSObject
+
++ (NSMutableArray *)performCollectOnIndexedObject:(id)object block:(TWTBlockEnumerationCollectBlock)block;
++ (NSUInteger)performDetectOnIndexedObject:(id)object block:(TWTBlockEnumerationPredicateBlock)block ordered:(BOOL)ordered;
++ (NSMutableDictionary *)performGroupOnIndexedObject:(id)object
+                                               block:(TWTBlockEnumerationGroupBlock)block
+                                 groupTransformBlock:(id (^)(NSMutableArray *group))groupTransformBlock;
++ (NSMutableArray *)performSelectOnIndexedObject:(id)object block:(TWTBlockEnumerationPredicateBlock)block;
++ (id)performReduceOnIndexedObject:(id)object
+                          identity:(id)identity
+                             block:(TWTBlockEnumerationInjectBlock)block
+                          combiner:(TWTBlockEnumerationCombineBlock)combiner;
++ (id)performAccumulateOnIndexedObject:(id)object
+                      accumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                                 block:(TWTBlockEnumerationAccumulateBlock)block
+                                merger:(TWTBlockEnumerationMergeBlock)merger;
++ (id)performSerialAccumulateOnObject:(id<NSFastEnumeration>)object
+                     accumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                                block:(TWTBlockEnumerationAccumulateBlock)block;
+
+@end
+
+
+@implementation TWTConcurrentBlockEnumerator
+
+/*!
+ @abstract Splits the indexed collection into chunks and invokes the block once per chunk, concurrently.
+ @param object An NSArray or NSOrderedSet.
+ @param block The block to invoke for each chunk. It is passed the index of the chunk, the chunk’s objects, and the
+     range of the collection that the chunk covers.
+ */
++ (void)enumerateChunksOfIndexedObject:(id)object
+                            usingBlock:(void (^)(NSUInteger chunkIndex, __unsafe_unretained id const *objects, NSRange range))block
+{
+    NSUInteger count = [object count];
+    NSUInteger chunkCount = (count + kTWTConcurrentBlockEnumerationChunkSize - 1) / kTWTConcurrentBlockEnumerationChunkSize;
+
+    dispatch_apply(chunkCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t chunkIndex) {
+        @autoreleasepool {
+            NSUInteger location = chunkIndex * kTWTConcurrentBlockEnumerationChunkSize;
+            NSRange range = NSMakeRange(location, MIN(kTWTConcurrentBlockEnumerationChunkSize, count - location));
+
+            __unsafe_unretained id objects[kTWTConcurrentBlockEnumerationChunkSize];
+            [object getObjects:objects range:range];
+            block(chunkIndex, objects, range);
+        }
+    });
+}
+
+
++ (NSMutableArray *)performCollectOnIndexedObject:(id)object block:(TWTBlockEnumerationCollectBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    // Each chunk writes its results directly into its own range of a shared buffer, so no merging is needed
+    NSUInteger count = [object count];
+    __strong id *results = (__strong id *)calloc(count, sizeof(id));
+
+    [self enumerateChunksOfIndexedObject:object usingBlock:^(NSUInteger chunkIndex, __unsafe_unretained id const *objects, NSRange range) {
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            id result = block(objects[i]);
+            results[range.location + i] = result ? result : [NSNull null];
+        }
+    }];
+
+    NSMutableArray *collection = [[NSMutableArray alloc] initWithObjects:results count:count];
+
+    for (NSUInteger i = 0; i < count; ++i) {
+        results[i] = nil;
+    }
+
+    free(results);
+    return collection;
+}
+
+
++ (NSUInteger)performDetectOnIndexedObject:(id)object block:(TWTBlockEnumerationPredicateBlock)block ordered:(BOOL)ordered
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    // The lowest index at which any worker has found a match. Ordered detects only need to keep going while they are
+    // below it, since only a lower match could change the result; unordered detects can stop as soon as it is set.
+    // dispatch_apply is synchronous, so workers can safely share it through a pointer to the stack
+    _Atomic(NSUInteger) matchIndex = NSNotFound;
+    _Atomic(NSUInteger) *sharedMatchIndex = &matchIndex;
+
+    [self enumerateChunksOfIndexedObject:object usingBlock:^(NSUInteger chunkIndex, __unsafe_unretained id const *objects, NSRange range) {
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            NSUInteger index = range.location + i;
+            NSUInteger currentMatchIndex = atomic_load_explicit(sharedMatchIndex, memory_order_relaxed);
+            if (ordered ? currentMatchIndex < index : currentMatchIndex != NSNotFound) {
+                return;
+            }
+
+            if (block(objects[i])) {
+                // Lower the match index to ours unless another worker has already found a better match
+                while ((ordered ? index < currentMatchIndex : currentMatchIndex == NSNotFound) &&
+                       !atomic_compare_exchange_weak(sharedMatchIndex, &currentMatchIndex, index)) {
+                }
+
+                return;
+            }
+        }
+    }];
+
+    return atomic_load(&matchIndex);
+}
+
+
++ (NSMutableDictionary *)performGroupOnIndexedObject:(id)object
+                                               block:(TWTBlockEnumerationGroupBlock)block
+                                 groupTransformBlock:(id (^)(NSMutableArray *))groupTransformBlock
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    // Grouping is dominated by dictionary lookups rather than by the block, so rather than using many small chunks, we
+    // use a few large ones per worker. This keeps the number of partial groups, and thus the merge work, low when
+    // there are few distinct keys.
+    NSUInteger count = [object count];
+    NSUInteger partitionCount = MAX([[NSProcessInfo processInfo] activeProcessorCount], 1);
+    NSUInteger chunkCount = MIN(partitionCount * 4, (count + kTWTConcurrentBlockEnumerationChunkSize - 1) / kTWTConcurrentBlockEnumerationChunkSize);
+    NSUInteger chunkLength = (count + chunkCount - 1) / chunkCount;
+
+    // Each chunk has one partial map per hash partition, laid out as
+    // partialGroups[chunkIndex * partitionCount + partition]
+    __strong NSMutableDictionary **partialGroups = (__strong NSMutableDictionary **)calloc(chunkCount * partitionCount,
+                                                                                          sizeof(NSMutableDictionary *));
+
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    dispatch_apply(chunkCount, queue, ^(size_t chunkIndex) {
+        @autoreleasepool {
+            __strong NSMutableDictionary **chunkGroups = partialGroups + chunkIndex * partitionCount;
+            for (NSUInteger partition = 0; partition < partitionCount; ++partition) {
+                chunkGroups[partition] = [[NSMutableDictionary alloc] init];
+            }
+
+            NSUInteger chunkEnd = MIN((chunkIndex + 1) * chunkLength, count);
+            __unsafe_unretained id objects[kTWTConcurrentBlockEnumerationChunkSize];
+            for (NSUInteger location = chunkIndex * chunkLength; location < chunkEnd; location += kTWTConcurrentBlockEnumerationChunkSize) {
+                NSRange range = NSMakeRange(location, MIN(kTWTConcurrentBlockEnumerationChunkSize, chunkEnd - location));
+                [object getObjects:objects range:range];
+
+                for (NSUInteger i = 0; i < range.length; ++i) {
+                    id groupKey = block(objects[i]);
+                    if (!groupKey) {
+                        groupKey = [NSNull null];
+                    }
+
+                    NSMutableDictionary *groups = chunkGroups[[groupKey hash] % partitionCount];
+                    NSMutableArray *group = groups[groupKey];
+                    if (!group) {
+                        group = [[NSMutableArray alloc] init];
+                        groups[groupKey] = group;
+                    }
+
+                    [group addObject:objects[i]];
+                }
+            }
+        }
+    });
+
+    // Equal keys have equal hashes, so every partial group for a given key is in the same partition. Each partition
+    // can thus be merged independently. Merging in chunk order preserves the receiver’s order within each group.
+    __strong NSMutableDictionary **mergedGroups = (__strong NSMutableDictionary **)calloc(partitionCount, sizeof(NSMutableDictionary *));
+    dispatch_apply(partitionCount, queue, ^(size_t partition) {
+        @autoreleasepool {
+            NSMutableDictionary *groups = partialGroups[partition];
+            partialGroups[partition] = nil;
+
+            for (NSUInteger chunkIndex = 1; chunkIndex < chunkCount; ++chunkIndex) {
+                NSUInteger partialIndex = chunkIndex * partitionCount + partition;
+                [partialGroups[partialIndex] enumerateKeysAndObjectsUsingBlock:^(id groupKey, NSMutableArray *partialGroup, BOOL *stop) {
+                    NSMutableArray *group = groups[groupKey];
+                    if (group) {
+                        [group addObjectsFromArray:partialGroup];
+                    } else {
+                        groups[groupKey] = partialGroup;
+                    }
+                }];
+
+                partialGroups[partialIndex] = nil;
+            }
+
+            if (groupTransformBlock) {
+                for (id groupKey in groups.allKeys) {
+                    groups[groupKey] = groupTransformBlock(groups[groupKey]);
+                }
+            }
+
+            mergedGroups[partition] = groups;
+        }
+    });
+
+    free(partialGroups);
+
+    NSUInteger groupCount = 0;
+    for (NSUInteger partition = 0; partition < partitionCount; ++partition) {
+        groupCount += mergedGroups[partition].count;
+    }
+
+    NSMutableDictionary *groups = [[NSMutableDictionary alloc] initWithCapacity:groupCount];
+    for (NSUInteger partition = 0; partition < partitionCount; ++partition) {
+        [groups addEntriesFromDictionary:mergedGroups[partition]];
+        mergedGroups[partition] = nil;
+    }
+
+    free(mergedGroups);
+    return groups;
+}
+
+
++ (NSMutableArray *)performSelectOnIndexedObject:(id)object block:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+
+    NSUInteger count = [object count];
+    NSUInteger chunkCount = (count + kTWTConcurrentBlockEnumerationChunkSize - 1) / kTWTConcurrentBlockEnumerationChunkSize;
+    __strong NSMutableArray **chunkResults = (__strong NSMutableArray **)calloc(chunkCount, sizeof(NSMutableArray *));
+
+    [self enumerateChunksOfIndexedObject:object usingBlock:^(NSUInteger chunkIndex, __unsafe_unretained id const *objects, NSRange range) {
+        NSMutableArray *selectedObjects = [[NSMutableArray alloc] init];
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            if (block(objects[i])) {
+                [selectedObjects addObject:objects[i]];
+            }
+        }
+
+        chunkResults[chunkIndex] = selectedObjects;
+    }];
+
+    // Concatenate the chunks in order
+    NSUInteger selectedCount = 0;
+    for (NSUInteger i = 0; i < chunkCount; ++i) {
+        selectedCount += chunkResults[i].count;
+    }
+
+    NSMutableArray *collection = [[NSMutableArray alloc] initWithCapacity:selectedCount];
+    for (NSUInteger i = 0; i < chunkCount; ++i) {
+        [collection addObjectsFromArray:chunkResults[i]];
+        chunkResults[i] = nil;
+    }
+
+    free(chunkResults);
+    return collection;
+}
+
+
+/*!
+ @abstract Combines the specified partial results pairwise in a balanced tree.
+ @discussion Each level of the tree combines its pairs concurrently. Pairs are always combined in order, so the
+     combiner need not be commutative. The partial results buffer is nilled out as it is consumed.
+ @param partialResults The partial results, in the order of the elements from which they were derived.
+ @param count The number of partial results. Must be at least 1.
+ @param combiner The block to combine adjacent partial results.
+ @result The combination of all the partial results.
+ */
++ (id)combinePartialResults:(__strong id *)partialResults count:(NSUInteger)count combiner:(TWTBlockEnumerationCombineBlock)combiner
+{
+    NSParameterAssert(count > 0);
+
+    // At each level, the result at index i absorbs the result at index i + stride
+    for (NSUInteger stride = 1; stride < count; stride *= 2) {
+        NSUInteger pairCount = (count - stride + 2 * stride - 1) / (2 * stride);
+        dispatch_apply(pairCount, dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^(size_t pairIndex) {
+            @autoreleasepool {
+                NSUInteger i = pairIndex * 2 * stride;
+                partialResults[i] = combiner(partialResults[i], partialResults[i + stride]);
+                partialResults[i + stride] = nil;
+            }
+        });
+    }
+
+    id result = partialResults[0];
+    partialResults[0] = nil;
+    return result;
+}
+
+
++ (id)performReduceOnIndexedObject:(id)object
+                          identity:(id)identity
+                             block:(TWTBlockEnumerationInjectBlock)block
+                          combiner:(TWTBlockEnumerationCombineBlock)combiner
+{
+    NSParameterAssert(object);
+    NSParameterAssert(block);
+    NSParameterAssert(combiner);
+
+    NSUInteger chunkCount = ([object count] + kTWTConcurrentBlockEnumerationChunkSize - 1) / kTWTConcurrentBlockEnumerationChunkSize;
+    if (chunkCount == 0) {
+        return identity;
+    }
+
+    __strong id *partialResults = (__strong id *)calloc(chunkCount, sizeof(id));
+
+    [self enumerateChunksOfIndexedObject:object usingBlock:^(NSUInteger chunkIndex, __unsafe_unretained id const *objects, NSRange range) {
+        id memoObject = identity;
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            memoObject = block(memoObject, objects[i]);
+        }
+
+        partialResults[chunkIndex] = memoObject;
+    }];
+
+    id result = [self combinePartialResults:partialResults count:chunkCount combiner:combiner];
+    free(partialResults);
+    return result;
+}
+
+
++ (id)performAccumulateOnIndexedObject:(id)object
+                      accumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                                 block:(TWTBlockEnumerationAccumulateBlock)block
+                                merger:(TWTBlockEnumerationMergeBlock)merger
+{
+    NSParameterAssert(object);
+    NSParameterAssert(accumulatorBlock);
+    NSParameterAssert(block);
+    NSParameterAssert(merger);
+
+    NSUInteger chunkCount = ([object count] + kTWTConcurrentBlockEnumerationChunkSize - 1) / kTWTConcurrentBlockEnumerationChunkSize;
+    if (chunkCount == 0) {
+        return accumulatorBlock();
+    }
+
+    __strong id *accumulators = (__strong id *)calloc(chunkCount, sizeof(id));
+
+    [self enumerateChunksOfIndexedObject:object usingBlock:^(NSUInteger chunkIndex, __unsafe_unretained id const *objects, NSRange range) {
+        id accumulator = accumulatorBlock();
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            block(accumulator, objects[i]);
+        }
+
+        accumulators[chunkIndex] = accumulator;
+    }];
+
+    id result = [self combinePartialResults:accumulators count:chunkCount combiner:^id(id accumulator, id nextAccumulator) {
+        merger(accumulator, nextAccumulator);
+        return accumulator;
+    }];
+
+    free(accumulators);
+    return result;
+}
+
+
++ (id)performSerialAccumulateOnObject:(id<NSFastEnumeration>)object
+                     accumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                                block:(TWTBlockEnumerationAccumulateBlock)block
+{
+    NSParameterAssert(object);
+    NSParameterAssert(accumulatorBlock);
+    NSParameterAssert(block);
+
+    id accumulator = accumulatorBlock();
+    for (id element in object) {
+        block(accumulator, element);
+    }
+
+    return accumulator;
+}
+
+@end
+
+
+#pragma mark - Arrays
+
+@implementation NSArray (TWTConcurrentBlockEnumeration)
+
+- (id)twt_concurrentCollectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_collectWithBlock:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performCollectOnIndexedObject:self block:block];
+}
+
+
+- (id)twt_concurrentDetectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_detectWithBlock:block];
+    }
+
+    NSUInteger index = [TWTConcurrentBlockEnumerator performDetectOnIndexedObject:self block:block ordered:YES];
+    return index != NSNotFound ? self[index] : nil;
+}
+
+
+- (id)twt_concurrentDetectAnyWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_detectWithBlock:block];
+    }
+
+    NSUInteger index = [TWTConcurrentBlockEnumerator performDetectOnIndexedObject:self block:block ordered:NO];
+    return index != NSNotFound ? self[index] : nil;
+}
+
+
+- (NSDictionary *)twt_concurrentGroupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_groupWithBlock:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performGroupOnIndexedObject:self block:block groupTransformBlock:nil];
+}
+
+
+- (id)twt_reduceWithIdentity:(id)identity block:(TWTBlockEnumerationInjectBlock)block combiner:(TWTBlockEnumerationCombineBlock)combiner
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_injectWithInitialObject:identity block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performReduceOnIndexedObject:self identity:identity block:block combiner:combiner];
+}
+
+
+- (id)twt_reduceWithAccumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                               block:(TWTBlockEnumerationAccumulateBlock)block
+                              merger:(TWTBlockEnumerationMergeBlock)merger
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [TWTConcurrentBlockEnumerator performSerialAccumulateOnObject:self accumulatorBlock:accumulatorBlock block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performAccumulateOnIndexedObject:self
+                                                         accumulatorBlock:accumulatorBlock
+                                                                    block:block
+                                                                   merger:merger];
+}
+
+
+- (id)twt_concurrentRejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(block);
+    return [self twt_concurrentSelectWithBlock:^BOOL(id element) {
+        return !block(element);
+    }];
+}
+
+
+- (id)twt_concurrentSelectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_selectWithBlock:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performSelectOnIndexedObject:self block:block];
+}
+
+@end
+
+
+#pragma mark - Dictionaries
+
+@implementation NSDictionary (TWTConcurrentBlockEnumeration)
+
+- (id)twt_concurrentCollectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_collectWithBlock:block];
+    }
+
+    NSArray *keys = self.allKeys;
+    NSArray *values = [TWTConcurrentBlockEnumerator performCollectOnIndexedObject:keys block:block];
+    return [[NSMutableDictionary alloc] initWithObjects:values forKeys:keys];
+}
+
+
+- (id)twt_concurrentDetectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_concurrentDetectAnyWithBlock:block];
+}
+
+
+- (id)twt_concurrentDetectAnyWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_detectWithBlock:block];
+    }
+
+    NSArray *keys = self.allKeys;
+    NSUInteger index = [TWTConcurrentBlockEnumerator performDetectOnIndexedObject:keys block:block ordered:NO];
+    return index != NSNotFound ? self[keys[index]] : nil;
+}
+
+
+- (NSDictionary *)twt_concurrentGroupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_groupWithBlock:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performGroupOnIndexedObject:self.allKeys block:block groupTransformBlock:^id(NSMutableArray *keys) {
+        return [[NSMutableDictionary alloc] initWithObjects:[self objectsForKeys:keys notFoundMarker:[NSNull null]] forKeys:keys];
+    }];
+}
+
+
+- (id)twt_reduceWithIdentity:(id)identity block:(TWTBlockEnumerationInjectBlock)block combiner:(TWTBlockEnumerationCombineBlock)combiner
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_injectWithInitialObject:identity block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performReduceOnIndexedObject:self.allKeys identity:identity block:block combiner:combiner];
+}
+
+
+- (id)twt_reduceWithAccumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                               block:(TWTBlockEnumerationAccumulateBlock)block
+                              merger:(TWTBlockEnumerationMergeBlock)merger
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [TWTConcurrentBlockEnumerator performSerialAccumulateOnObject:self accumulatorBlock:accumulatorBlock block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performAccumulateOnIndexedObject:self.allKeys
+                                                         accumulatorBlock:accumulatorBlock
+                                                                    block:block
+                                                                   merger:merger];
+}
+
+
+- (id)twt_concurrentRejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(block);
+    return [self twt_concurrentSelectWithBlock:^BOOL(id element) {
+        return !block(element);
+    }];
+}
+
+
+- (id)twt_concurrentSelectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_selectWithBlock:block];
+    }
+
+    NSArray *selectedKeys = [TWTConcurrentBlockEnumerator performSelectOnIndexedObject:self.allKeys block:block];
+    NSArray *selectedValues = [self objectsForKeys:selectedKeys notFoundMarker:[NSNull null]];
+    return [[NSMutableDictionary alloc] initWithObjects:selectedValues forKeys:selectedKeys];
+}
+
+@end
+
+
+#pragma mark - Enumerators
+
+@implementation NSEnumerator (TWTConcurrentBlockEnumeration)
+
+- (id)twt_concurrentCollectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    return [self.allObjects twt_concurrentCollectWithBlock:block];
+}
+
+
+- (id)twt_concurrentDetectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self.allObjects twt_concurrentDetectWithBlock:block];
+}
+
+
+- (id)twt_concurrentDetectAnyWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self.allObjects twt_concurrentDetectAnyWithBlock:block];
+}
+
+
+- (NSDictionary *)twt_concurrentGroupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    return [self.allObjects twt_concurrentGroupWithBlock:block];
+}
+
+
+- (id)twt_reduceWithIdentity:(id)identity block:(TWTBlockEnumerationInjectBlock)block combiner:(TWTBlockEnumerationCombineBlock)combiner
+{
+    return [self.allObjects twt_reduceWithIdentity:identity block:block combiner:combiner];
+}
+
+
+- (id)twt_reduceWithAccumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                               block:(TWTBlockEnumerationAccumulateBlock)block
+                              merger:(TWTBlockEnumerationMergeBlock)merger
+{
+    return [self.allObjects twt_reduceWithAccumulatorBlock:accumulatorBlock block:block merger:merger];
+}
+
+
+- (id)twt_concurrentRejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self.allObjects twt_concurrentRejectWithBlock:block];
+}
+
+
+- (id)twt_concurrentSelectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self.allObjects twt_concurrentSelectWithBlock:block];
+}
+
+@end
+
+
+#pragma mark - Ordered Sets
+
+@implementation NSOrderedSet (TWTConcurrentBlockEnumeration)
+
+- (id)twt_concurrentCollectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_collectWithBlock:block];
+    }
+
+    NSArray *results = [TWTConcurrentBlockEnumerator performCollectOnIndexedObject:self block:block];
+    return [[NSMutableOrderedSet alloc] initWithArray:results];
+}
+
+
+- (id)twt_concurrentDetectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_detectWithBlock:block];
+    }
+
+    NSUInteger index = [TWTConcurrentBlockEnumerator performDetectOnIndexedObject:self block:block ordered:YES];
+    return index != NSNotFound ? self[index] : nil;
+}
+
+
+- (id)twt_concurrentDetectAnyWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_detectWithBlock:block];
+    }
+
+    NSUInteger index = [TWTConcurrentBlockEnumerator performDetectOnIndexedObject:self block:block ordered:NO];
+    return index != NSNotFound ? self[index] : nil;
+}
+
+
+- (NSDictionary *)twt_concurrentGroupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_groupWithBlock:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performGroupOnIndexedObject:self block:block groupTransformBlock:^id(NSMutableArray *group) {
+        return [[NSMutableOrderedSet alloc] initWithArray:group];
+    }];
+}
+
+
+- (id)twt_reduceWithIdentity:(id)identity block:(TWTBlockEnumerationInjectBlock)block combiner:(TWTBlockEnumerationCombineBlock)combiner
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_injectWithInitialObject:identity block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performReduceOnIndexedObject:self identity:identity block:block combiner:combiner];
+}
+
+
+- (id)twt_reduceWithAccumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                               block:(TWTBlockEnumerationAccumulateBlock)block
+                              merger:(TWTBlockEnumerationMergeBlock)merger
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [TWTConcurrentBlockEnumerator performSerialAccumulateOnObject:self accumulatorBlock:accumulatorBlock block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performAccumulateOnIndexedObject:self
+                                                         accumulatorBlock:accumulatorBlock
+                                                                    block:block
+                                                                   merger:merger];
+}
+
+
+- (id)twt_concurrentRejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(block);
+    return [self twt_concurrentSelectWithBlock:^BOOL(id element) {
+        return !block(element);
+    }];
+}
+
+
+- (id)twt_concurrentSelectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_selectWithBlock:block];
+    }
+
+    NSArray *selectedObjects = [TWTConcurrentBlockEnumerator performSelectOnIndexedObject:self block:block];
+    return [[NSMutableOrderedSet alloc] initWithArray:selectedObjects];
+}
+
+@end
+
+
+#pragma mark - Sets
+
+@implementation NSSet (TWTConcurrentBlockEnumeration)
+
+- (id)twt_concurrentCollectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_collectWithBlock:block];
+    }
+
+    NSArray *results = [TWTConcurrentBlockEnumerator performCollectOnIndexedObject:self.allObjects block:block];
+    return [[NSMutableSet alloc] initWithArray:results];
+}
+
+
+- (id)twt_concurrentDetectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    return [self twt_concurrentDetectAnyWithBlock:block];
+}
+
+
+- (id)twt_concurrentDetectAnyWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_detectWithBlock:block];
+    }
+
+    NSArray *objects = self.allObjects;
+    NSUInteger index = [TWTConcurrentBlockEnumerator performDetectOnIndexedObject:objects block:block ordered:NO];
+    return index != NSNotFound ? objects[index] : nil;
+}
+
+
+- (NSDictionary *)twt_concurrentGroupWithBlock:(TWTBlockEnumerationGroupBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_groupWithBlock:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performGroupOnIndexedObject:self.allObjects block:block groupTransformBlock:^id(NSMutableArray *group) {
+        return [[NSMutableSet alloc] initWithArray:group];
+    }];
+}
+
+
+- (id)twt_reduceWithIdentity:(id)identity block:(TWTBlockEnumerationInjectBlock)block combiner:(TWTBlockEnumerationCombineBlock)combiner
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_injectWithInitialObject:identity block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performReduceOnIndexedObject:self.allObjects identity:identity block:block combiner:combiner];
+}
+
+
+- (id)twt_reduceWithAccumulatorBlock:(TWTBlockEnumerationAccumulatorBlock)accumulatorBlock
+                               block:(TWTBlockEnumerationAccumulateBlock)block
+                              merger:(TWTBlockEnumerationMergeBlock)merger
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [TWTConcurrentBlockEnumerator performSerialAccumulateOnObject:self accumulatorBlock:accumulatorBlock block:block];
+    }
+
+    return [TWTConcurrentBlockEnumerator performAccumulateOnIndexedObject:self.allObjects
+                                                         accumulatorBlock:accumulatorBlock
+                                                                    block:block
+                                                                   merger:merger];
+}
+
+
+- (id)twt_concurrentRejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(block);
+    return [self twt_concurrentSelectWithBlock:^BOOL(id element) {
+        return !block(element);
+    }];
+}
+
+
+- (id)twt_concurrentSelectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    if (self.count < kTWTConcurrentBlockEnumerationSerialThreshold) {
+        return [self twt_selectWithBlock:block];
+    }
+
+    NSArray *selectedObjects = [TWTConcurrentBlockEnumerator performSelectOnIndexedObject:self.allObjects block:block];
+    return [[NSMutableSet alloc] initWithArray:selectedObjects];
+}
+
+@end
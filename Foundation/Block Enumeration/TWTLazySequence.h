@@ -0,0 +1,178 @@
+//
+//  TWTLazySequence.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTBlockEnumeration.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TWTLazySequences are lazily evaluated chains of block enumeration operators over a collection. Intermediate 
+ operators like ‑selectWithBlock: and ‑collectWithBlock: do no work; they only record themselves and return a new 
+ sequence. When a terminal operation like ‑detectWithBlock: or ‑allObjects is invoked, the entire chain is fused into
+ a single pass over the underlying collection. Each element flows through every operator before the next element is
+ read, no intermediate collections are allocated, and enumeration stops as soon as the terminal operation has its 
+ answer.
+ 
+ For example, ‑[[[array.twt_lazySequence selectWithBlock:…] collectWithBlock:…] firstObject] invokes the select 
+ block only until an element passes, invokes the collect block exactly once, and allocates no intermediate collections.
+ 
+ Sequences are immutable, and each terminal operation re-evaluates the chain from the beginning of the collection. 
+ Sequences over NSEnumerators can only be evaluated once, since enumerators cannot be rewound. As with the 
+ TWTBlockEnumeration methods, sequences over dictionaries enumerate their keys.
+ */
+@interface TWTLazySequence : NSObject
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created sequence that enumerates the specified collection.
+ @param collection The collection to enumerate. May not be nil.
+ @result An initialized sequence.
+ */
+- (instancetype)initWithCollection:(id<NSFastEnumeration>)collection NS_DESIGNATED_INITIALIZER;
+
+#pragma mark Intermediate Operations
+
+/*!
+ @abstract Returns a sequence of the results of invoking the block on each element of the receiver.
+ @discussion As with ‑twt_collectWithBlock:, nil results are replaced with the NSNull instance.
+ @param block The block to invoke on each element. May not be nil.
+ @result A new lazy sequence.
+ */
+- (TWTLazySequence *)collectWithBlock:(TWTBlockEnumerationCollectBlock)block;
+
+/*!
+ @abstract Returns a sequence of the elements of the receiver for which the block returns NO.
+ @param block Predicate block to test elements. May not be nil.
+ @result A new lazy sequence.
+ */
+- (TWTLazySequence *)rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Returns a sequence of the elements of the receiver for which the block returns YES.
+ @param block Predicate block to test elements. May not be nil.
+ @result A new lazy sequence.
+ */
+- (TWTLazySequence *)selectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Returns a sequence of at most the first count elements of the receiver.
+ @discussion Enumeration of the underlying collection stops once count elements have passed through.
+ @param count The maximum number of elements.
+ @result A new lazy sequence.
+ */
+- (TWTLazySequence *)take:(NSUInteger)count;
+
+#pragma mark Terminal Operations
+
+/*!
+ @abstract Evaluates the sequence and returns its elements.
+ @result An array containing the elements of the sequence.
+ */
+- (NSArray *)allObjects;
+
+/*!
+ @abstract Evaluates the sequence and returns its number of elements.
+ @result The number of elements in the sequence.
+ */
+- (NSUInteger)count;
+
+/*!
+ @abstract Evaluates the sequence until the block returns YES for an element.
+ @param block Predicate block to test elements. May not be nil.
+ @result The first element for which the block returns YES, or nil if there is no such element.
+ */
+- (nullable id)detectWithBlock:(TWTBlockEnumerationPredicateBlock)block;
+
+/*!
+ @abstract Evaluates the sequence until it produces its first element.
+ @result The first element of the sequence, or nil if it is empty.
+ */
+- (nullable id)firstObject;
+
+/*!
+ @abstract Evaluates the sequence, passing each element to the block.
+ @param block The block to invoke for each element. Setting its stop parameter to YES ends evaluation. May not be nil.
+ */
+- (void)enumerateObjectsUsingBlock:(void (^)(id object, BOOL *stop))block;
+
+/*!
+ @abstract Evaluates the sequence, passing each element and a memo to the block.
+ @discussion This behaves like ‑twt_injectWithInitialObject:block:.
+ @param initialObject The memo to pass to the first invocation of the block.
+ @param block The block to invoke for each element. May not be nil.
+ @result The value returned by the last invocation of the block, or initialObject if the sequence is empty.
+ */
+- (nullable id)injectWithInitialObject:(nullable id)initialObject block:(TWTBlockEnumerationInjectBlock)block;
+
+@end
+
+
+#pragma mark
+
+@interface NSArray (TWTLazySequence)
+
+/*! Returns a lazy sequence that enumerates the receiver. */
+- (TWTLazySequence *)twt_lazySequence;
+
+@end
+
+
+@interface NSDictionary (TWTLazySequence)
+
+/*! Returns a lazy sequence that enumerates the receiver’s keys. */
+- (TWTLazySequence *)twt_lazySequence;
+
+@end
+
+
+@interface NSEnumerator (TWTLazySequence)
+
+/*! Returns a lazy sequence that enumerates the receiver’s remaining objects. It may only be evaluated once. */
+- (TWTLazySequence *)twt_lazySequence;
+
+@end
+
+
+@interface NSOrderedSet (TWTLazySequence)
+
+/*! Returns a lazy sequence that enumerates the receiver. */
+- (TWTLazySequence *)twt_lazySequence;
+
+@end
+
+
+@interface NSSet (TWTLazySequence)
+
+/*! Returns a lazy sequence that enumerates the receiver. */
+- (TWTLazySequence *)twt_lazySequence;
+
+@end
+
+NS_ASSUME_NONNULL_END
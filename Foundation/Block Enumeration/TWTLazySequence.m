@@ -0,0 +1,320 @@
+//
+//  TWTLazySequence.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTLazySequence.h"
+
+
+/*!
+ A sink receives the elements of an evaluating sequence one at a time. It returns YES if evaluation should continue
+ and NO if it should stop.
+ */
+typedef BOOL (^TWTLazySequenceSink)(id element);
+
+/*!
+ A stage is a recorded intermediate operation. When a sequence is evaluated, each stage wraps the sink downstream of
+ it in a new sink that performs the operation, so that the whole chain collapses into one sink per element.
+ */
+typedef TWTLazySequenceSink (^TWTLazySequenceStage)(TWTLazySequenceSink downstream);
+
+
+#pragma mark
+
+@interface TWTLazySequence ()
+
+/*! The collection that the root of the chain enumerates. */
+@property (nonatomic, strong, readonly) id<NSFastEnumeration> collection;
+
+/*! The sequence whose elements feed into this one’s stage, or nil if this sequence is the root of the chain. */
+@property (nonatomic, strong, readonly) TWTLazySequence *upstream;
+
+/*! The stage this sequence adds to its upstream sequence, or nil if this sequence is the root of the chain. */
+@property (nonatomic, copy, readonly) TWTLazySequenceStage stage;
+
+/*!
+ @abstract Evaluates the sequence, passing its elements to the specified sink until either the collection is
+     exhausted or some sink in the chain returns NO.
+ @param sink The terminal sink.
+ */
+- (void)evaluateWithSink:(TWTLazySequenceSink)sink;
+
+@end
+
+
+@implementation TWTLazySequence
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return nil;
+}
+
+
+- (instancetype)initWithCollection:(id<NSFastEnumeration>)collection
+{
+    NSParameterAssert(collection);
+
+    self = [super init];
+    if (self) {
+        _collection = collection;
+    }
+
+    return self;
+}
+
+
+- (instancetype)initWithUpstream:(TWTLazySequence *)upstream stage:(TWTLazySequenceStage)stage
+{
+    self = [self initWithCollection:upstream.collection];
+    if (self) {
+        _upstream = upstream;
+        _stage = [stage copy];
+    }
+
+    return self;
+}
+
+
+- (NSString *)description
+{
+    NSUInteger stageCount = 0;
+    for (TWTLazySequence *sequence = self; sequence.upstream; sequence = sequence.upstream) {
+        ++stageCount;
+    }
+
+    return [NSString stringWithFormat:@"<%@: %p collectionClass=%@ stageCount=%lu>", self.class, self,
+            [(id)self.collection class], (unsigned long)stageCount];
+}
+
+
+- (void)evaluateWithSink:(TWTLazySequenceSink)sink
+{
+    // Wrap the terminal sink in each stage from the end of the chain back to its root
+    for (TWTLazySequence *sequence = self; sequence.upstream; sequence = sequence.upstream) {
+        sink = sequence.stage(sink);
+    }
+
+    for (id element in self.collection) {
+        if (!sink(element)) {
+            break;
+        }
+    }
+}
+
+
+#pragma mark - Intermediate Operations
+
+- (TWTLazySequence *)collectWithBlock:(TWTBlockEnumerationCollectBlock)block
+{
+    NSParameterAssert(block);
+    return [[TWTLazySequence alloc] initWithUpstream:self stage:^TWTLazySequenceSink(TWTLazySequenceSink downstream) {
+        return ^BOOL(id element) {
+            id result = block(element);
+            return downstream(result ? result : [NSNull null]);
+        };
+    }];
+}
+
+
+- (TWTLazySequence *)rejectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(block);
+    return [self selectWithBlock:^BOOL(id element) {
+        return !block(element);
+    }];
+}
+
+
+- (TWTLazySequence *)selectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(block);
+    return [[TWTLazySequence alloc] initWithUpstream:self stage:^TWTLazySequenceSink(TWTLazySequenceSink downstream) {
+        return ^BOOL(id element) {
+            return block(element) ? downstream(element) : YES;
+        };
+    }];
+}
+
+
+- (TWTLazySequence *)take:(NSUInteger)count
+{
+    return [[TWTLazySequence alloc] initWithUpstream:self stage:^TWTLazySequenceSink(TWTLazySequenceSink downstream) {
+        // The counter is created anew for each evaluation
+        __block NSUInteger remainingCount = count;
+        return ^BOOL(id element) {
+            if (remainingCount == 0) {
+                return NO;
+            }
+
+            --remainingCount;
+
+            // Stop as soon as the last element has passed rather than waiting to read one more
+            return downstream(element) && remainingCount > 0;
+        };
+    }];
+}
+
+
+#pragma mark - Terminal Operations
+
+- (NSArray *)allObjects
+{
+    NSMutableArray *objects = [[NSMutableArray alloc] init];
+    [self evaluateWithSink:^BOOL(id element) {
+        [objects addObject:element];
+        return YES;
+    }];
+
+    return objects;
+}
+
+
+- (NSUInteger)count
+{
+    __block NSUInteger count = 0;
+    [self evaluateWithSink:^BOOL(id element) {
+        ++count;
+        return YES;
+    }];
+
+    return count;
+}
+
+
+- (id)detectWithBlock:(TWTBlockEnumerationPredicateBlock)block
+{
+    NSParameterAssert(block);
+
+    __block id detectedObject = nil;
+    [self evaluateWithSink:^BOOL(id element) {
+        if (block(element)) {
+            detectedObject = element;
+            return NO;
+        }
+
+        return YES;
+    }];
+
+    return detectedObject;
+}
+
+
+- (id)firstObject
+{
+    __block id firstObject = nil;
+    [self evaluateWithSink:^BOOL(id element) {
+        firstObject = element;
+        return NO;
+    }];
+
+    return firstObject;
+}
+
+
+- (void)enumerateObjectsUsingBlock:(void (^)(id, BOOL *))block
+{
+    NSParameterAssert(block);
+    [self evaluateWithSink:^BOOL(id element) {
+        BOOL stop = NO;
+        block(element, &stop);
+        return !stop;
+    }];
+}
+
+
+- (id)injectWithInitialObject:(id)initialObject block:(TWTBlockEnumerationInjectBlock)block
+{
+    NSParameterAssert(block);
+
+    __block id memoObject = initialObject;
+    [self evaluateWithSink:^BOOL(id element) {
+        memoObject = block(memoObject, element);
+        return YES;
+    }];
+
+    return memoObject;
+}
+
+@end
+
+
+#pragma mark - Arrays
+
+@implementation NSArray (TWTLazySequence)
+
+- (TWTLazySequence *)twt_lazySequence
+{
+    return [[TWTLazySequence alloc] initWithCollection:self];
+}
+
+@end
+
+
+#pragma mark - Dictionaries
+
+@implementation NSDictionary (TWTLazySequence)
+
+- (TWTLazySequence *)twt_lazySequence
+{
+    return [[TWTLazySequence alloc] initWithCollection:self];
+}
+
+@end
+
+
+#pragma mark - Enumerators
+
+@implementation NSEnumerator (TWTLazySequence)
+
+- (TWTLazySequence *)twt_lazySequence
+{
+    return [[TWTLazySequence alloc] initWithCollection:self];
+}
+
+@end
+
+
+#pragma mark - Ordered Sets
+
+@implementation NSOrderedSet (TWTLazySequence)
+
+- (TWTLazySequence *)twt_lazySequence
+{
+    return [[TWTLazySequence alloc] initWithCollection:self];
+}
+
+@end
+
+
+#pragma mark - Sets
+
+@implementation NSSet (TWTLazySequence)
+
+- (TWTLazySequence *)twt_lazySequence
+{
+    return [[TWTLazySequence alloc] initWithCollection:self];
+}
+
+@end
@@ -0,0 +1,97 @@
+//
+//  TWTWindowedEnumeration.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTBlockEnumeration.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ @abstract Protocol that exposes lazy chunked, windowed, and zipped enumeration of a collection.
+ @discussion Each method returns an enumerator that produces its arrays on demand, so batching a collection never 
+    materializes the batches all at once. For arrays and ordered sets, the arrays produced are views of ranges of the 
+    receiver rather than copies, so each one takes constant extra memory regardless of its size. Such collections must
+    not be mutated while the enumerator or any array it produced is in use. Other collections, including enumerators,
+    have no indexed storage to view, so their chunks and windows are copied out of a buffer of at most one window’s 
+    worth of elements. As with the TWTBlockEnumeration methods, dictionaries are enumerated by key.
+ 
+    The enumerators are themselves NSEnumerators, so the TWTBlockEnumeration methods can be used on them, e.g., to
+    upload each chunk of an array with ‑twt_detectWithBlock: and stop at the first failure.
+ */
+@protocol TWTWindowedEnumeration <NSObject>
+
+/*!
+ @abstract Returns an enumerator of consecutive, non-overlapping arrays of size elements from the receiver.
+ @discussion Given a collection of [1, 2, 3, 4, 5] and a size of 2, the enumerator produces [1, 2], [3, 4], and [5].
+    The last array has fewer than size elements if the receiver’s count is not a multiple of size.
+ @param size The maximum number of elements in each chunk. Must be greater than 0.
+ @result An enumerator of arrays of elements from the receiver.
+ */
+- (NSEnumerator<NSArray *> *)twt_chunksOfSize:(NSUInteger)size;
+
+/*!
+ @abstract Returns an enumerator of every run of size consecutive elements from the receiver.
+ @discussion Given a collection of [1, 2, 3, 4] and a size of 3, the enumerator produces [1, 2, 3] and [2, 3, 4]. If 
+    the receiver has fewer than size elements, the enumerator produces nothing.
+ @param size The number of elements in each window. Must be greater than 0.
+ @result An enumerator of arrays of elements from the receiver.
+ */
+- (NSEnumerator<NSArray *> *)twt_slidingWindowOfSize:(NSUInteger)size;
+
+/*!
+ @abstract Returns an enumerator of pairs of corresponding elements from the receiver and another collection.
+ @discussion Given collections [1, 2, 3] and [a, b], the enumerator produces [1, a] and [2, b]. Both collections are 
+    enumerated in lockstep, and the enumerator ends when either is exhausted. If collection is a dictionary, its keys
+    are enumerated.
+ @param collection The collection whose elements should be paired with the receiver’s. May not be nil.
+ @result An enumerator of two-element arrays whose first element is from the receiver and whose second element is 
+    from collection.
+ */
+- (NSEnumerator<NSArray *> *)twt_zipWith:(id<TWTBlockEnumeration>)collection;
+
+@end
+
+
+#pragma mark
+
+@interface NSArray (TWTWindowedEnumeration) <TWTWindowedEnumeration>
+@end
+
+@interface NSDictionary (TWTWindowedEnumeration) <TWTWindowedEnumeration>
+@end
+
+@interface NSEnumerator (TWTWindowedEnumeration) <TWTWindowedEnumeration>
+@end
+
+@interface NSOrderedSet (TWTWindowedEnumeration) <TWTWindowedEnumeration>
+@end
+
+@interface NSSet (TWTWindowedEnumeration) <TWTWindowedEnumeration>
+@end
+
+NS_ASSUME_NONNULL_END
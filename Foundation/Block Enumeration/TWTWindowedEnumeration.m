@@ -0,0 +1,446 @@
+//
+//  TWTWindowedEnumeration.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTWindowedEnumeration.h"
+
+
+#pragma mark TWTSubarray
+
+/*!
+ TWTSubarrays are views of a range of another array. They retain the array, but do not copy its elements.
+ */
+@interface TWTSubarray : NSArray
+
+- (instancetype)initWithArray:(NSArray *)array range:(NSRange)range;
+
+@end
+
+
+@implementation TWTSubarray {
+    NSArray *_array;
+    NSRange _range;
+}
+
+- (instancetype)initWithArray:(NSArray *)array range:(NSRange)range
+{
+    NSParameterAssert(array);
+    NSParameterAssert(NSMaxRange(range) <= array.count);
+
+    self = [super init];
+    if (self) {
+        _array = array;
+        _range = range;
+    }
+
+    return self;
+}
+
+
+- (NSUInteger)count
+{
+    return _range.length;
+}
+
+
+- (id)objectAtIndex:(NSUInteger)index
+{
+    if (index >= _range.length) {
+        [NSException raise:NSRangeException format:@"*** -[%@ %@]: index %lu beyond bounds [0 .. %ld]", self.class,
+         NSStringFromSelector(_cmd), (unsigned long)index, (long)_range.length - 1];
+    }
+
+    return [_array objectAtIndex:_range.location + index];
+}
+
+
+- (void)getObjects:(__unsafe_unretained id [])objects range:(NSRange)range
+{
+    if (NSMaxRange(range) > _range.length) {
+        [NSException raise:NSRangeException format:@"*** -[%@ %@]: range %@ extends beyond bounds [0 .. %ld]",
+         self.class, NSStringFromSelector(_cmd), NSStringFromRange(range), (long)_range.length - 1];
+    }
+
+    [_array getObjects:objects range:NSMakeRange(_range.location + range.location, range.length)];
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    // Copies should neither change when the underlying array does nor keep it alive
+    return [[NSArray allocWithZone:zone] initWithArray:self];
+}
+
+@end
+
+
+#pragma mark - TWTIndexedWindowEnumerator
+
+/*!
+ TWTIndexedWindowEnumerators produce windows of an array as TWTSubarrays. Each window starts step elements after the
+ previous one, so windows are chunks when step equals size and overlap when it is smaller.
+ */
+@interface TWTIndexedWindowEnumerator : NSEnumerator
+
+- (instancetype)initWithArray:(NSArray *)array
+                         size:(NSUInteger)size
+                         step:(NSUInteger)step
+         allowsPartialWindows:(BOOL)allowsPartialWindows;
+
+@end
+
+
+@implementation TWTIndexedWindowEnumerator {
+    NSArray *_array;
+    NSUInteger _size;
+    NSUInteger _step;
+    BOOL _allowsPartialWindows;
+    NSUInteger _location;
+}
+
+- (instancetype)initWithArray:(NSArray *)array
+                         size:(NSUInteger)size
+                         step:(NSUInteger)step
+         allowsPartialWindows:(BOOL)allowsPartialWindows
+{
+    NSParameterAssert(array);
+    NSParameterAssert(size > 0);
+    NSParameterAssert(step > 0);
+
+    self = [super init];
+    if (self) {
+        _array = array;
+        _size = size;
+        _step = step;
+        _allowsPartialWindows = allowsPartialWindows;
+    }
+
+    return self;
+}
+
+
+- (id)nextObject
+{
+    NSUInteger count = _array.count;
+    if (_location >= count) {
+        return nil;
+    }
+
+    NSUInteger length = MIN(_size, count - _location);
+    if (length < _size && !_allowsPartialWindows) {
+        _location = count;
+        return nil;
+    }
+
+    TWTSubarray *window = [[TWTSubarray alloc] initWithArray:_array range:NSMakeRange(_location, length)];
+    _location += MIN(_step, count - _location);
+    return window;
+}
+
+@end
+
+
+#pragma mark - TWTBufferedWindowEnumerator
+
+/*!
+ TWTBufferedWindowEnumerators produce windows of the objects of an enumerator. Since enumerators have no indexed
+ storage, they buffer one window’s worth of objects and produce a copy of the buffer for each window.
+ */
+@interface TWTBufferedWindowEnumerator : NSEnumerator
+
+- (instancetype)initWithEnumerator:(NSEnumerator *)enumerator
+                              size:(NSUInteger)size
+                              step:(NSUInteger)step
+              allowsPartialWindows:(BOOL)allowsPartialWindows;
+
+@end
+
+
+@implementation TWTBufferedWindowEnumerator {
+    NSEnumerator *_enumerator;
+    NSMutableArray *_buffer;
+    NSUInteger _size;
+    NSUInteger _step;
+    BOOL _allowsPartialWindows;
+    BOOL _producedWindow;
+}
+
+- (instancetype)initWithEnumerator:(NSEnumerator *)enumerator
+                              size:(NSUInteger)size
+                              step:(NSUInteger)step
+              allowsPartialWindows:(BOOL)allowsPartialWindows
+{
+    NSParameterAssert(enumerator);
+    NSParameterAssert(size > 0);
+    NSParameterAssert(step > 0);
+
+    self = [super init];
+    if (self) {
+        _enumerator = enumerator;
+        _buffer = [[NSMutableArray alloc] initWithCapacity:size];
+        _size = size;
+        _step = step;
+        _allowsPartialWindows = allowsPartialWindows;
+    }
+
+    return self;
+}
+
+
+- (id)nextObject
+{
+    // Slide past the previous window
+    if (_producedWindow) {
+        [_buffer removeObjectsInRange:NSMakeRange(0, MIN(_step, _buffer.count))];
+    }
+
+    // Once the enumerator is exhausted, it’s released so that it won’t be asked for more objects
+    while (_enumerator && _buffer.count < _size) {
+        id object = [_enumerator nextObject];
+        if (!object) {
+            _enumerator = nil;
+            break;
+        }
+
+        [_buffer addObject:object];
+    }
+
+    if (_buffer.count == 0 || (_buffer.count < _size && !_allowsPartialWindows)) {
+        [_buffer removeAllObjects];
+        return nil;
+    }
+
+    _producedWindow = YES;
+    return [_buffer copy];
+}
+
+@end
+
+
+#pragma mark - TWTZipEnumerator
+
+/*!
+ TWTZipEnumerators produce pairs of corresponding objects from two enumerators until either is exhausted.
+ */
+@interface TWTZipEnumerator : NSEnumerator
+
+- (instancetype)initWithEnumerator:(NSEnumerator *)enumerator otherEnumerator:(NSEnumerator *)otherEnumerator;
+
+@end
+
+
+@implementation TWTZipEnumerator {
+    NSEnumerator *_enumerator;
+    NSEnumerator *_otherEnumerator;
+}
+
+- (instancetype)initWithEnumerator:(NSEnumerator *)enumerator otherEnumerator:(NSEnumerator *)otherEnumerator
+{
+    NSParameterAssert(enumerator);
+    NSParameterAssert(otherEnumerator);
+
+    self = [super init];
+    if (self) {
+        _enumerator = enumerator;
+        _otherEnumerator = otherEnumerator;
+    }
+
+    return self;
+}
+
+
+- (id)nextObject
+{
+    id object = [_enumerator nextObject];
+    id otherObject = object ? [_otherEnumerator nextObject] : nil;
+    if (!otherObject) {
+        _enumerator = nil;
+        _otherEnumerator = nil;
+        return nil;
+    }
+
+    return @[ object, otherObject ];
+}
+
+@end
+
+
+#pragma mark -
+
+/*!
+ Returns an enumerator of the elements that the TWTBlockEnumeration methods would pass to their blocks for the 
+ specified collection, i.e., its keys if it is a dictionary and its objects otherwise.
+ */
+static NSEnumerator *TWTWindowedEnumerationEnumeratorForCollection(id collection)
+{
+    NSCParameterAssert(collection);
+
+    if ([collection isKindOfClass:[NSEnumerator class]]) {
+        return collection;
+    } else if ([collection respondsToSelector:@selector(keyEnumerator)]) {
+        return [collection keyEnumerator];
+    }
+
+    return [collection objectEnumerator];
+}
+
+
+#pragma mark - Arrays
+
+@implementation NSArray (TWTWindowedEnumeration)
+
+- (NSEnumerator<NSArray *> *)twt_chunksOfSize:(NSUInteger)size
+{
+    return [[TWTIndexedWindowEnumerator alloc] initWithArray:self size:size step:size allowsPartialWindows:YES];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_slidingWindowOfSize:(NSUInteger)size
+{
+    return [[TWTIndexedWindowEnumerator alloc] initWithArray:self size:size step:1 allowsPartialWindows:NO];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_zipWith:(id<TWTBlockEnumeration>)collection
+{
+    return [[TWTZipEnumerator alloc] initWithEnumerator:[self objectEnumerator]
+                                        otherEnumerator:TWTWindowedEnumerationEnumeratorForCollection(collection)];
+}
+
+@end
+
+
+#pragma mark - Dictionaries
+
+@implementation NSDictionary (TWTWindowedEnumeration)
+
+- (NSEnumerator<NSArray *> *)twt_chunksOfSize:(NSUInteger)size
+{
+    return [[TWTBufferedWindowEnumerator alloc] initWithEnumerator:[self keyEnumerator]
+                                                              size:size
+                                                              step:size
+                                              allowsPartialWindows:YES];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_slidingWindowOfSize:(NSUInteger)size
+{
+    return [[TWTBufferedWindowEnumerator alloc] initWithEnumerator:[self keyEnumerator]
+                                                              size:size
+                                                              step:1
+                                              allowsPartialWindows:NO];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_zipWith:(id<TWTBlockEnumeration>)collection
+{
+    return [[TWTZipEnumerator alloc] initWithEnumerator:[self keyEnumerator]
+                                        otherEnumerator:TWTWindowedEnumerationEnumeratorForCollection(collection)];
+}
+
+@end
+
+
+#pragma mark - Enumerators
+
+@implementation NSEnumerator (TWTWindowedEnumeration)
+
+- (NSEnumerator<NSArray *> *)twt_chunksOfSize:(NSUInteger)size
+{
+    return [[TWTBufferedWindowEnumerator alloc] initWithEnumerator:self size:size step:size allowsPartialWindows:YES];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_slidingWindowOfSize:(NSUInteger)size
+{
+    return [[TWTBufferedWindowEnumerator alloc] initWithEnumerator:self size:size step:1 allowsPartialWindows:NO];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_zipWith:(id<TWTBlockEnumeration>)collection
+{
+    return [[TWTZipEnumerator alloc] initWithEnumerator:self
+                                        otherEnumerator:TWTWindowedEnumerationEnumeratorForCollection(collection)];
+}
+
+@end
+
+
+#pragma mark - Ordered Sets
+
+@implementation NSOrderedSet (TWTWindowedEnumeration)
+
+// -array returns a proxy for the ordered set rather than a copy, so windows of it are views of the ordered set
+
+- (NSEnumerator<NSArray *> *)twt_chunksOfSize:(NSUInteger)size
+{
+    return [[TWTIndexedWindowEnumerator alloc] initWithArray:self.array size:size step:size allowsPartialWindows:YES];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_slidingWindowOfSize:(NSUInteger)size
+{
+    return [[TWTIndexedWindowEnumerator alloc] initWithArray:self.array size:size step:1 allowsPartialWindows:NO];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_zipWith:(id<TWTBlockEnumeration>)collection
+{
+    return [[TWTZipEnumerator alloc] initWithEnumerator:[self objectEnumerator]
+                                        otherEnumerator:TWTWindowedEnumerationEnumeratorForCollection(collection)];
+}
+
+@end
+
+
+#pragma mark - Sets
+
+@implementation NSSet (TWTWindowedEnumeration)
+
+- (NSEnumerator<NSArray *> *)twt_chunksOfSize:(NSUInteger)size
+{
+    return [[TWTBufferedWindowEnumerator alloc] initWithEnumerator:[self objectEnumerator]
+                                                              size:size
+                                                              step:size
+                                              allowsPartialWindows:YES];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_slidingWindowOfSize:(NSUInteger)size
+{
+    return [[TWTBufferedWindowEnumerator alloc] initWithEnumerator:[self objectEnumerator]
+                                                              size:size
+                                                              step:1
+                                              allowsPartialWindows:NO];
+}
+
+
+- (NSEnumerator<NSArray *> *)twt_zipWith:(id<TWTBlockEnumeration>)collection
+{
+    return [[TWTZipEnumerator alloc] initWithEnumerator:[self objectEnumerator]
+                                        otherEnumerator:TWTWindowedEnumerationEnumeratorForCollection(collection)];
+}
+
+@end
@@ -0,0 +1,147 @@
+//
+//  TWTBoundedOperationQueue.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The error domain for errors generated by TWTBoundedOperationQueue.
+ */
+extern NSString *const kTWTBoundedOperationQueueErrorDomain;
+
+typedef NS_ENUM(NSInteger, TWTBoundedOperationQueueError) {
+    /*! Indicates that an operation was rejected because the queue was at capacity. */
+    TWTBoundedOperationQueueErrorFull
+};
+
+
+/*!
+ The policies a bounded operation queue can apply when an operation is added while the queue is at capacity.
+ */
+typedef NS_ENUM(NSInteger, TWTBoundedOperationQueueOverflowPolicy) {
+    /*! The adding thread blocks until space is available. */
+    TWTBoundedOperationQueueOverflowPolicyBlock,
+
+    /*! The operation is rejected with a TWTBoundedOperationQueueErrorFull error. */
+    TWTBoundedOperationQueueOverflowPolicyFail,
+
+    /*!
+     The oldest operation that has not started executing is cancelled and removed from the queue’s accounting to make
+     room. If every operation in the queue is already executing, the new operation is rejected as with 
+     TWTBoundedOperationQueueOverflowPolicyFail.
+     */
+    TWTBoundedOperationQueueOverflowPolicyDropOldest
+};
+
+
+/*!
+ TWTBoundedOperationQueues apply backpressure to producers that add operations faster than they can be executed. The
+ queue admits at most a fixed number of operations at a time, counting every operation that has been added but has 
+ not yet finished, and applies its overflow policy when that capacity is reached. Admitted operations are executed on
+ an underlying NSOperationQueue.
+ 
+ Producers that can’t block or drop work can use ‑tryAddOperation:spaceAvailableHandler: to be notified 
+ asynchronously when there is room to try again.
+ 
+ The queue’s depth and high-water mark are available so that pipelines can be sized based on observed load.
+ */
+@interface TWTBoundedOperationQueue : NSObject
+
+/*! The underlying operation queue on which admitted operations execute. */
+@property (nonatomic, strong, readonly) NSOperationQueue *operationQueue;
+
+/*! The maximum number of unfinished operations the queue admits. */
+@property (nonatomic, assign, readonly) NSUInteger capacity;
+
+/*! The policy applied by ‑addOperation:error: when the queue is at capacity. */
+@property (nonatomic, assign, readonly) TWTBoundedOperationQueueOverflowPolicy overflowPolicy;
+
+/*! The number of admitted operations that have not yet finished or been dropped. */
+@property (nonatomic, assign, readonly) NSUInteger depth;
+
+/*! The largest depth the queue has reached. */
+@property (nonatomic, assign, readonly) NSUInteger highWaterMark;
+
+/*! The number of operations that were cancelled to make room under TWTBoundedOperationQueueOverflowPolicyDropOldest. */
+@property (nonatomic, assign, readonly) NSUInteger droppedOperationCount;
+
+/*! The number of operations that were rejected because the queue was at capacity. */
+@property (nonatomic, assign, readonly) NSUInteger rejectedOperationCount;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly created bounded queue that executes its operations on a new operation queue.
+ @param capacity The maximum number of unfinished operations. Must be positive.
+ @param overflowPolicy The policy to apply when an operation is added while the queue is at capacity.
+ @result An initialized bounded queue.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity overflowPolicy:(TWTBoundedOperationQueueOverflowPolicy)overflowPolicy;
+
+/*!
+ @abstract Initializes a newly created bounded queue that executes its operations on the specified queue.
+ @discussion Only operations added through the bounded queue count toward its capacity.
+ @param capacity The maximum number of unfinished operations. Must be positive.
+ @param overflowPolicy The policy to apply when an operation is added while the queue is at capacity.
+ @param operationQueue The queue on which to execute operations. May not be nil.
+ @result An initialized bounded queue.
+ */
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+                  overflowPolicy:(TWTBoundedOperationQueueOverflowPolicy)overflowPolicy
+                  operationQueue:(NSOperationQueue *)operationQueue NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Adds an operation to the queue, applying the queue’s overflow policy if it is at capacity.
+ @discussion With TWTBoundedOperationQueueOverflowPolicyBlock, this method does not return until the operation has 
+     been admitted, so it must not be invoked from a thread that operations in the queue need in order to finish.
+ @param operation The operation to add. May not be nil.
+ @param error On return, contains an error if the operation was rejected.
+ @result Whether the operation was admitted.
+ */
+- (BOOL)addOperation:(NSOperation *)operation error:(NSError *__autoreleasing *)error;
+
+/*!
+ @abstract Adds an operation to the queue if it has space, without ever blocking or dropping other operations.
+ @discussion If the operation is rejected, the handler is invoked asynchronously on a global dispatch queue once 
+     an operation finishes and the queue is below capacity. Every waiting handler is invoked at that point, so a 
+     handler that tries again may find the queue full once more and should be prepared to wait again.
+ @param operation The operation to add. May not be nil.
+ @param spaceAvailableHandler The block to invoke when space becomes available if the operation is rejected. May be 
+     nil.
+ @result Whether the operation was admitted.
+ */
+- (BOOL)tryAddOperation:(NSOperation *)operation spaceAvailableHandler:(nullable dispatch_block_t)spaceAvailableHandler;
+
+/*!
+ @abstract Blocks the calling thread until every admitted operation has finished or been dropped.
+ */
+- (void)waitUntilAllOperationsAreFinished;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,273 @@
+//
+//  TWTBoundedOperationQueue.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTBoundedOperationQueue.h"
+
+#import <pthread.h>
+
+#import "NSOperation+TWTFinishHandler.h"
+
+
+NSString *const kTWTBoundedOperationQueueErrorDomain = @"TWTBoundedOperationQueueErrorDomain";
+
+
+@implementation TWTBoundedOperationQueue {
+    // Guards every ivar below. _condition is broadcast whenever the depth decreases.
+    pthread_mutex_t _lock;
+    pthread_cond_t _condition;
+
+    // Admitted operations that have not finished or been dropped, oldest first
+    NSMutableOrderedSet<NSOperation *> *_operations;
+    NSMutableArray<dispatch_block_t> *_spaceAvailableHandlers;
+
+    NSUInteger _highWaterMark;
+    NSUInteger _droppedOperationCount;
+    NSUInteger _rejectedOperationCount;
+}
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity overflowPolicy:(TWTBoundedOperationQueueOverflowPolicy)overflowPolicy
+{
+    return [self initWithCapacity:capacity overflowPolicy:overflowPolicy operationQueue:[[NSOperationQueue alloc] init]];
+}
+
+
+- (instancetype)initWithCapacity:(NSUInteger)capacity
+                  overflowPolicy:(TWTBoundedOperationQueueOverflowPolicy)overflowPolicy
+                  operationQueue:(NSOperationQueue *)operationQueue
+{
+    NSParameterAssert(capacity > 0);
+    NSParameterAssert(operationQueue);
+
+    self = [super init];
+    if (self) {
+        _capacity = capacity;
+        _overflowPolicy = overflowPolicy;
+        _operationQueue = operationQueue;
+
+        pthread_mutex_init(&_lock, NULL);
+        pthread_cond_init(&_condition, NULL);
+        _operations = [[NSMutableOrderedSet alloc] initWithCapacity:capacity];
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_cond_destroy(&_condition);
+    pthread_mutex_destroy(&_lock);
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p capacity=%lu depth=%lu highWaterMark=%lu>",
+            self.class, self, (unsigned long)self.capacity, (unsigned long)self.depth, (unsigned long)self.highWaterMark];
+}
+
+
+#pragma mark Counters
+
+- (NSUInteger)depth
+{
+    pthread_mutex_lock(&_lock);
+    NSUInteger depth = _operations.count;
+    pthread_mutex_unlock(&_lock);
+    return depth;
+}
+
+
+- (NSUInteger)highWaterMark
+{
+    pthread_mutex_lock(&_lock);
+    NSUInteger highWaterMark = _highWaterMark;
+    pthread_mutex_unlock(&_lock);
+    return highWaterMark;
+}
+
+
+- (NSUInteger)droppedOperationCount
+{
+    pthread_mutex_lock(&_lock);
+    NSUInteger droppedOperationCount = _droppedOperationCount;
+    pthread_mutex_unlock(&_lock);
+    return droppedOperationCount;
+}
+
+
+- (NSUInteger)rejectedOperationCount
+{
+    pthread_mutex_lock(&_lock);
+    NSUInteger rejectedOperationCount = _rejectedOperationCount;
+    pthread_mutex_unlock(&_lock);
+    return rejectedOperationCount;
+}
+
+
+#pragma mark Adding Operations
+
+- (BOOL)addOperation:(NSOperation *)operation error:(NSError *__autoreleasing *)error
+{
+    NSParameterAssert(operation);
+
+    NSOperation *droppedOperation = nil;
+
+    pthread_mutex_lock(&_lock);
+    if (_operations.count >= _capacity) {
+        switch (_overflowPolicy) {
+            case TWTBoundedOperationQueueOverflowPolicyBlock:
+                while (_operations.count >= _capacity) {
+                    pthread_cond_wait(&_condition, &_lock);
+                }
+                break;
+            case TWTBoundedOperationQueueOverflowPolicyDropOldest:
+                droppedOperation = [self dropOldestPendingOperation];
+                break;
+            case TWTBoundedOperationQueueOverflowPolicyFail:
+                break;
+        }
+    }
+
+    BOOL admitted = [self admitOperationIfPossible:operation];
+    pthread_mutex_unlock(&_lock);
+
+    // Cancel outside the lock, since cancelling can synchronously finish the operation and invoke our finish handler
+    [droppedOperation cancel];
+
+    if (!admitted) {
+        if (error) {
+            *error = [NSError errorWithDomain:kTWTBoundedOperationQueueErrorDomain code:TWTBoundedOperationQueueErrorFull userInfo:nil];
+        }
+
+        return NO;
+    }
+
+    [self enqueueOperation:operation];
+    return YES;
+}
+
+
+- (BOOL)tryAddOperation:(NSOperation *)operation spaceAvailableHandler:(dispatch_block_t)spaceAvailableHandler
+{
+    NSParameterAssert(operation);
+
+    pthread_mutex_lock(&_lock);
+    BOOL admitted = [self admitOperationIfPossible:operation];
+    if (!admitted && spaceAvailableHandler) {
+        if (!_spaceAvailableHandlers) {
+            _spaceAvailableHandlers = [[NSMutableArray alloc] init];
+        }
+
+        [_spaceAvailableHandlers addObject:[spaceAvailableHandler copy]];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (admitted) {
+        [self enqueueOperation:operation];
+    }
+
+    return admitted;
+}
+
+
+// Must be called with the lock held
+- (BOOL)admitOperationIfPossible:(NSOperation *)operation
+{
+    if (_operations.count >= _capacity) {
+        ++_rejectedOperationCount;
+        return NO;
+    }
+
+    [_operations addObject:operation];
+    _highWaterMark = MAX(_highWaterMark, _operations.count);
+    return YES;
+}
+
+
+// Must be called with the lock held. Returns the dropped operation, which the caller should cancel after unlocking.
+- (NSOperation *)dropOldestPendingOperation
+{
+    NSUInteger index = [_operations indexOfObjectPassingTest:^BOOL(NSOperation *operation, NSUInteger index, BOOL *stop) {
+        return !operation.isExecuting && !operation.isFinished;
+    }];
+
+    if (index == NSNotFound) {
+        return nil;
+    }
+
+    NSOperation *operation = _operations[index];
+    [_operations removeObjectAtIndex:index];
+    ++_droppedOperationCount;
+    return operation;
+}
+
+
+- (void)enqueueOperation:(NSOperation *)operation
+{
+    __weak typeof(self) weakSelf = self;
+    [operation twt_addFinishHandler:^(NSOperation *operation) {
+        [weakSelf operationDidFinish:operation];
+    }];
+
+    [self.operationQueue addOperation:operation];
+}
+
+
+- (void)operationDidFinish:(NSOperation *)operation
+{
+    pthread_mutex_lock(&_lock);
+
+    // Dropped operations were removed from the accounting when they were dropped
+    if (![_operations containsObject:operation]) {
+        pthread_mutex_unlock(&_lock);
+        return;
+    }
+
+    [_operations removeObject:operation];
+    pthread_cond_broadcast(&_condition);
+
+    NSArray<dispatch_block_t> *spaceAvailableHandlers = _spaceAvailableHandlers;
+    _spaceAvailableHandlers = nil;
+    pthread_mutex_unlock(&_lock);
+
+    for (dispatch_block_t spaceAvailableHandler in spaceAvailableHandlers) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), spaceAvailableHandler);
+    }
+}
+
+
+#pragma mark Waiting
+
+- (void)waitUntilAllOperationsAreFinished
+{
+    pthread_mutex_lock(&_lock);
+    while (_operations.count > 0) {
+        pthread_cond_wait(&_condition, &_lock);
+    }
+    pthread_mutex_unlock(&_lock);
+}
+
+@end
@@ -0,0 +1,217 @@
+//
+//  TWTFuture.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTAsynchronousOperation.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The error domain for errors generated by TWTFuture.
+ */
+extern NSString *const kTWTFutureErrorDomain;
+
+/*!
+ userInfo key for the errors of every input future when a future created by +any: fails. The value is an NSArray of
+ NSErrors in the same order as the input futures.
+ */
+extern NSString *const kTWTFutureUnderlyingErrorsKey;
+
+typedef NS_ENUM(NSInteger, TWTFutureError) {
+    /*! Indicates that the future, or a future it depends on, was cancelled. */
+    TWTFutureErrorCancelled,
+
+    /*! Indicates that every input of a future created by +any: failed. */
+    TWTFutureErrorAllFailed
+};
+
+
+/*!
+ @abstract Type for blocks that resolve a future.
+ @discussion Only the first invocation of a resolve block has any effect.
+ @param result The future’s result. Ignored if error is non-nil.
+ @param error The error that occurred, or nil if the work succeeded.
+ */
+typedef void (^TWTFutureResolveBlock)(id _Nullable result, NSError * _Nullable error);
+
+/*!
+ @abstract Type for blocks that perform the work of an operation-backed future.
+ @discussion The block must eventually invoke resolveBlock exactly once. Doing so also finishes the operation, so the
+     block should not invoke ‑finishOperationExecution itself.
+ @param operation The operation executing the block.
+ @param resolveBlock The block to invoke with the work’s result.
+ */
+typedef void (^TWTFutureOperationBlock)(TWTAsynchronousOperation *operation, TWTFutureResolveBlock resolveBlock);
+
+
+/*!
+ TWTFutures represent the eventual result of asynchronous work. A future starts out pending and is resolved exactly
+ once, either by succeeding with a result, failing with an error, or being cancelled.
+ 
+ Rather than blocking a thread until a future is resolved, clients chain continuations onto it using ‑then:, ‑map:,
+ ‑flatMap:, +all:, and +any:. Each of these returns a new future and never blocks. Continuations are invoked on the
+ thread that resolves the future they’re waiting on, or immediately on the calling thread if that future is already
+ resolved, so they should be short. Expensive work belongs in an operation-backed future, which can be returned from a
+ ‑flatMap: block.
+ 
+ Errors and cancellation propagate through ‑map: and ‑flatMap: without invoking their blocks. Cancelling a future 
+ cancels the operation that backs it, if any, and every future derived from it. Cancellation also propagates 
+ upstream: cancelling a future returned by a chaining method cancels the futures it was derived from, so work whose
+ result nobody is waiting for stops.
+ */
+@interface TWTFuture : NSObject
+
+/*! Whether the future has been resolved. */
+@property (nonatomic, assign, readonly, getter = isResolved) BOOL resolved;
+
+/*! Whether the future was cancelled. Cancelled futures are resolved with a TWTFutureErrorCancelled error. */
+@property (nonatomic, assign, readonly, getter = isCancelled) BOOL cancelled;
+
+/*! The future’s result. nil if the future is pending or failed. */
+@property (nonatomic, strong, readonly, nullable) id result;
+
+/*! The future’s error. nil if the future is pending or succeeded. */
+@property (nonatomic, strong, readonly, nullable) NSError *error;
+
+/*!
+ The operation that resolves the future, or nil if the future is not backed by an operation. This can be used to make
+ other operations depend on the future’s work.
+ */
+@property (nonatomic, strong, readonly, nullable) TWTAsynchronousOperation *operation;
+
+/*!
+ @abstract Returns a new future that has already succeeded with the specified result.
+ @param result The future’s result.
+ @result A resolved future.
+ */
++ (instancetype)futureWithResult:(nullable id)result;
+
+/*!
+ @abstract Returns a new future that has already failed with the specified error.
+ @param error The future’s error. May not be nil.
+ @result A resolved future.
+ */
++ (instancetype)futureWithError:(NSError *)error;
+
+/*!
+ @abstract Returns a new future that is resolved by an asynchronous operation executing on the specified queue.
+ @discussion If the operation is cancelled or otherwise finishes without resolving the future, the future is 
+     cancelled.
+ @param operationQueue The queue on which to execute the operation. May not be nil.
+ @param block The block that the operation executes. May not be nil.
+ @result A new pending future.
+ */
++ (instancetype)futureWithOperationQueue:(NSOperationQueue *)operationQueue block:(TWTFutureOperationBlock)block;
+
+/*!
+ @abstract Returns a future that succeeds when every input future succeeds.
+ @discussion The returned future’s result is an array containing the results of the input futures in order, with
+     NSNull in place of nil results. If any input fails or is cancelled, the returned future is resolved the same way
+     immediately, without waiting for the remaining inputs, and the remaining inputs are cancelled. Cancelling the
+     returned future cancels every input.
+ @param futures The input futures. May not be nil.
+ @result A future for the results of every input future.
+ */
++ (TWTFuture *)all:(NSArray<TWTFuture *> *)futures;
+
+/*!
+ @abstract Returns a future that succeeds with the result of the first input future to succeed.
+ @discussion If every input fails, the returned future fails with a TWTFutureErrorAllFailed error whose userInfo 
+     contains the inputs’ errors under kTWTFutureUnderlyingErrorsKey. This includes the case where there are no 
+     inputs. Cancelling the returned future cancels every input.
+ @param futures The input futures. May not be nil.
+ @result A future for the first successful result.
+ */
++ (TWTFuture *)any:(NSArray<TWTFuture *> *)futures;
+
+/*!
+ @abstract Registers a block to invoke when the receiver is resolved, regardless of how.
+ @discussion Cancelling the returned future cancels the receiver.
+ @param block The block to invoke with the receiver’s result and error. May not be nil.
+ @result A future that is resolved the same way as the receiver after block has been invoked.
+ */
+- (TWTFuture *)then:(void (^)(id _Nullable result, NSError * _Nullable error))block;
+
+/*!
+ @abstract Returns a future for the result of transforming the receiver’s result.
+ @discussion If the receiver fails or is cancelled, block is not invoked and the returned future is resolved the same
+     way as the receiver. Cancelling the returned future cancels the receiver.
+ @param block The block that transforms the receiver’s result. To fail the returned future, the block should set its
+     error parameter and return nil. May not be nil.
+ @result A future for the transformed result.
+ */
+- (TWTFuture *)map:(id _Nullable (^)(id _Nullable result, NSError * __autoreleasing *error))block;
+
+/*!
+ @abstract Returns a future that is resolved by the future that a block returns for the receiver’s result.
+ @discussion If the receiver fails or is cancelled, block is not invoked and the returned future is resolved the same
+     way as the receiver. Cancelling the returned future cancels the receiver and the future that block returned.
+ @param block The block that returns the next future in the chain. If it returns nil, the returned future succeeds 
+     with a nil result. May not be nil.
+ @result A future for the chained result.
+ */
+- (TWTFuture *)flatMap:(TWTFuture * _Nullable (^)(id _Nullable result))block;
+
+/*!
+ @abstract Cancels the receiver if it is still pending.
+ @discussion This cancels the receiver’s operation, if any, and every future derived from the receiver that has not 
+     yet been resolved. If the receiver was returned by a chaining method, the futures it was derived from are also
+     cancelled.
+ @result Whether the receiver was cancelled. Returns NO if the receiver was already resolved.
+ */
+- (BOOL)cancel;
+
+@end
+
+
+/*!
+ TWTPromises are the producing side of a TWTFuture. They allow arbitrary asynchronous code, e.g., a delegate callback, 
+ to resolve a future.
+ */
+@interface TWTPromise : NSObject
+
+/*! The future that the promise resolves. */
+@property (nonatomic, strong, readonly) TWTFuture *future;
+
+/*!
+ @abstract Resolves the promise’s future with the specified result.
+ @param result The result.
+ @result Whether the future was resolved. Returns NO if it was already resolved.
+ */
+- (BOOL)fulfillWithResult:(nullable id)result;
+
+/*!
+ @abstract Resolves the promise’s future with the specified error.
+ @param error The error. May not be nil.
+ @result Whether the future was resolved. Returns NO if it was already resolved.
+ */
+- (BOOL)rejectWithError:(NSError *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,543 @@
+//
+//  TWTFuture.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTFuture.h"
+
+#import <pthread.h>
+
+
+NSString *const kTWTFutureErrorDomain = @"TWTFutureErrorDomain";
+NSString *const kTWTFutureUnderlyingErrorsKey = @"TWTFutureUnderlyingErrors";
+
+
+typedef NS_ENUM(NSUInteger, TWTFutureState) {
+    TWTFutureStatePending,
+    TWTFutureStateSucceeded,
+    TWTFutureStateFailed,
+    TWTFutureStateCancelled
+};
+
+
+typedef void (^TWTFutureCallback)(TWTFuture *future);
+
+
+@interface TWTFuture () {
+    // Guards every ivar below. Once _state leaves TWTFutureStatePending, _result and _error never change, so callbacks
+    // that run after resolution may read them directly.
+    pthread_mutex_t _lock;
+    TWTFutureState _state;
+    id _result;
+    NSError *_error;
+
+    // Both are nil until something is added and set back to nil when the future is resolved
+    NSMutableArray<TWTFutureCallback> *_callbacks;
+    NSMutableArray<dispatch_block_t> *_cancellationHandlers;
+}
+
+@property (nonatomic, strong, readwrite, nullable) TWTAsynchronousOperation *operation;
+
+/*!
+ @abstract Resolves the receiver if it is still pending.
+ @discussion Callbacks are invoked on the calling thread after the lock is released. If the receiver is cancelled, 
+     cancellation handlers are invoked first.
+ @param state The state to resolve the receiver to. May not be TWTFutureStatePending.
+ @param result The receiver’s result.
+ @param error The receiver’s error.
+ @result Whether the receiver was resolved.
+ */
+- (BOOL)resolveWithState:(TWTFutureState)state result:(id)result error:(NSError *)error;
+
+/*!
+ @abstract Resolves the receiver in the same way as the specified resolved future.
+ @param future The resolved future whose state, result, and error the receiver should adopt.
+ @result Whether the receiver was resolved.
+ */
+- (BOOL)resolveWithFuture:(TWTFuture *)future;
+
+/*!
+ @abstract Adds a callback that is invoked with the receiver when it is resolved, or immediately if the receiver is 
+     already resolved.
+ @param callback The callback.
+ */
+- (void)addCallback:(TWTFutureCallback)callback;
+
+/*!
+ @abstract Adds a handler that is invoked if the receiver is cancelled, or immediately if the receiver has already 
+     been cancelled. If the receiver is resolved any other way, the handler is discarded.
+ @param cancellationHandler The handler.
+ */
+- (void)addCancellationHandler:(dispatch_block_t)cancellationHandler;
+
+/*!
+ @abstract Returns a new pending future that cancels the receiver when it is cancelled.
+ @discussion Chaining methods use this so that cancellation propagates upstream as well as downstream.
+ @result A new pending future.
+ */
+- (TWTFuture *)dependentFuture;
+
+/*!
+ @abstract Cancels each of the specified futures that is still pending.
+ @param futures The futures to cancel.
+ */
++ (void)cancelFutures:(NSArray<TWTFuture *> *)futures;
+
+@end
+
+
+#pragma mark -
+
+@implementation TWTFuture
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _state = TWTFutureStatePending;
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_lock);
+}
+
+
+- (NSString *)description
+{
+    static NSString *const stateNames[] = { @"pending", @"succeeded", @"failed", @"cancelled" };
+
+    pthread_mutex_lock(&_lock);
+    NSString *description = [NSString stringWithFormat:@"<%@: %p state=%@ result=%@ error=%@>",
+                             self.class, self, stateNames[_state], _result, _error];
+    pthread_mutex_unlock(&_lock);
+
+    return description;
+}
+
+
+#pragma mark Creating Futures
+
++ (instancetype)futureWithResult:(id)result
+{
+    TWTFuture *future = [[self alloc] init];
+    [future resolveWithState:TWTFutureStateSucceeded result:result error:nil];
+    return future;
+}
+
+
++ (instancetype)futureWithError:(NSError *)error
+{
+    NSParameterAssert(error);
+
+    TWTFuture *future = [[self alloc] init];
+    [future resolveWithState:TWTFutureStateFailed result:nil error:error];
+    return future;
+}
+
+
++ (instancetype)futureWithOperationQueue:(NSOperationQueue *)operationQueue block:(TWTFutureOperationBlock)block
+{
+    NSParameterAssert(operationQueue);
+    NSParameterAssert(block);
+
+    TWTFuture *future = [[self alloc] init];
+
+    // The operation only references the future until it finishes, at which point its block and finish handlers are
+    // released. This breaks the cycle formed with future.operation.
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        block(operation, ^(id result, NSError *error) {
+            [future resolveWithState:(error ? TWTFutureStateFailed : TWTFutureStateSucceeded) result:result error:error];
+            [operation finishOperationExecution];
+        });
+    }];
+
+    [operation addFinishHandler:^(TWTAsynchronousOperation *operation) {
+        [future cancel];
+    }];
+
+    [future addCancellationHandler:^{
+        [operation cancel];
+    }];
+
+    future.operation = operation;
+    [operationQueue addOperation:operation];
+    return future;
+}
+
+
++ (TWTFuture *)all:(NSArray<TWTFuture *> *)futures
+{
+    NSParameterAssert(futures);
+
+    NSUInteger count = futures.count;
+    if (count == 0) {
+        return [self futureWithResult:@[]];
+    }
+
+    TWTFuture *allFuture = [[TWTFuture alloc] init];
+    NSMutableArray *results = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [results addObject:[NSNull null]];
+    }
+
+    __block NSUInteger remainingCount = count;
+    [futures enumerateObjectsUsingBlock:^(TWTFuture *future, NSUInteger index, BOOL *stop) {
+        [future addCallback:^(TWTFuture *input) {
+            if (input->_state != TWTFutureStateSucceeded) {
+                // Once the combined future has failed, nothing needs the other inputs’ results
+                if ([allFuture resolveWithFuture:input]) {
+                    [TWTFuture cancelFutures:futures];
+                }
+
+                return;
+            }
+
+            NSArray *completedResults = nil;
+            @synchronized (results) {
+                if (input->_result) {
+                    results[index] = input->_result;
+                }
+
+                if (--remainingCount == 0) {
+                    completedResults = [results copy];
+                }
+            }
+
+            if (completedResults) {
+                [allFuture resolveWithState:TWTFutureStateSucceeded result:completedResults error:nil];
+            }
+        }];
+    }];
+
+    [allFuture addCancellationHandler:^{
+        [TWTFuture cancelFutures:futures];
+    }];
+
+    return allFuture;
+}
+
+
++ (TWTFuture *)any:(NSArray<TWTFuture *> *)futures
+{
+    NSParameterAssert(futures);
+
+    NSUInteger count = futures.count;
+    if (count == 0) {
+        NSError *error = [NSError errorWithDomain:kTWTFutureErrorDomain
+                                             code:TWTFutureErrorAllFailed
+                                         userInfo:@{ kTWTFutureUnderlyingErrorsKey : @[] }];
+        return [self futureWithError:error];
+    }
+
+    TWTFuture *anyFuture = [[TWTFuture alloc] init];
+    NSMutableArray<NSError *> *errors = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        [errors addObject:(NSError *)[NSNull null]];
+    }
+
+    __block NSUInteger remainingCount = count;
+    [futures enumerateObjectsUsingBlock:^(TWTFuture *future, NSUInteger index, BOOL *stop) {
+        [future addCallback:^(TWTFuture *input) {
+            if (input->_state == TWTFutureStateSucceeded) {
+                [anyFuture resolveWithFuture:input];
+                return;
+            }
+
+            NSArray<NSError *> *completedErrors = nil;
+            @synchronized (errors) {
+                errors[index] = input->_error;
+                if (--remainingCount == 0) {
+                    completedErrors = [errors copy];
+                }
+            }
+
+            if (completedErrors) {
+                NSError *error = [NSError errorWithDomain:kTWTFutureErrorDomain
+                                                     code:TWTFutureErrorAllFailed
+                                                 userInfo:@{ kTWTFutureUnderlyingErrorsKey : completedErrors }];
+                [anyFuture resolveWithState:TWTFutureStateFailed result:nil error:error];
+            }
+        }];
+    }];
+
+    [anyFuture addCancellationHandler:^{
+        [TWTFuture cancelFutures:futures];
+    }];
+
+    return anyFuture;
+}
+
+
++ (void)cancelFutures:(NSArray<TWTFuture *> *)futures
+{
+    for (TWTFuture *future in futures) {
+        [future cancel];
+    }
+}
+
+
+#pragma mark Chaining
+
+- (TWTFuture *)then:(void (^)(id, NSError *))block
+{
+    NSParameterAssert(block);
+
+    TWTFuture *nextFuture = [self dependentFuture];
+    [self addCallback:^(TWTFuture *future) {
+        block(future->_result, future->_error);
+        [nextFuture resolveWithFuture:future];
+    }];
+
+    return nextFuture;
+}
+
+
+- (TWTFuture *)map:(id (^)(id, NSError *__autoreleasing *))block
+{
+    NSParameterAssert(block);
+
+    TWTFuture *nextFuture = [self dependentFuture];
+    [self addCallback:^(TWTFuture *future) {
+        if (future->_state != TWTFutureStateSucceeded || nextFuture.isResolved) {
+            [nextFuture resolveWithFuture:future];
+            return;
+        }
+
+        NSError *error = nil;
+        id result = block(future->_result, &error);
+        if (!result && error) {
+            [nextFuture resolveWithState:TWTFutureStateFailed result:nil error:error];
+        } else {
+            [nextFuture resolveWithState:TWTFutureStateSucceeded result:result error:nil];
+        }
+    }];
+
+    return nextFuture;
+}
+
+
+- (TWTFuture *)flatMap:(TWTFuture *(^)(id))block
+{
+    NSParameterAssert(block);
+
+    TWTFuture *nextFuture = [self dependentFuture];
+    [self addCallback:^(TWTFuture *future) {
+        if (future->_state != TWTFutureStateSucceeded || nextFuture.isResolved) {
+            [nextFuture resolveWithFuture:future];
+            return;
+        }
+
+        TWTFuture *chainedFuture = block(future->_result);
+        if (!chainedFuture) {
+            [nextFuture resolveWithState:TWTFutureStateSucceeded result:nil error:nil];
+            return;
+        }
+
+        [nextFuture addCancellationHandler:^{
+            [chainedFuture cancel];
+        }];
+
+        [chainedFuture addCallback:^(TWTFuture *chainedFuture) {
+            [nextFuture resolveWithFuture:chainedFuture];
+        }];
+    }];
+
+    return nextFuture;
+}
+
+
+- (TWTFuture *)dependentFuture
+{
+    // The next future only references the receiver weakly. The receiver keeps the next future alive through its
+    // callback until it is resolved, which is as long as cancelling it can matter.
+    TWTFuture *nextFuture = [[TWTFuture alloc] init];
+    __weak TWTFuture *weakSelf = self;
+    [nextFuture addCancellationHandler:^{
+        [weakSelf cancel];
+    }];
+
+    return nextFuture;
+}
+
+
+#pragma mark Cancellation
+
+- (BOOL)cancel
+{
+    NSError *error = [NSError errorWithDomain:kTWTFutureErrorDomain code:TWTFutureErrorCancelled userInfo:nil];
+    return [self resolveWithState:TWTFutureStateCancelled result:nil error:error];
+}
+
+
+#pragma mark State
+
+- (BOOL)isResolved
+{
+    pthread_mutex_lock(&_lock);
+    BOOL resolved = _state != TWTFutureStatePending;
+    pthread_mutex_unlock(&_lock);
+    return resolved;
+}
+
+
+- (BOOL)isCancelled
+{
+    pthread_mutex_lock(&_lock);
+    BOOL cancelled = _state == TWTFutureStateCancelled;
+    pthread_mutex_unlock(&_lock);
+    return cancelled;
+}
+
+
+- (id)result
+{
+    pthread_mutex_lock(&_lock);
+    id result = _result;
+    pthread_mutex_unlock(&_lock);
+    return result;
+}
+
+
+- (NSError *)error
+{
+    pthread_mutex_lock(&_lock);
+    NSError *error = _error;
+    pthread_mutex_unlock(&_lock);
+    return error;
+}
+
+
+#pragma mark Resolution
+
+- (BOOL)resolveWithState:(TWTFutureState)state result:(id)result error:(NSError *)error
+{
+    NSParameterAssert(state != TWTFutureStatePending);
+
+    pthread_mutex_lock(&_lock);
+    if (_state != TWTFutureStatePending) {
+        pthread_mutex_unlock(&_lock);
+        return NO;
+    }
+
+    _state = state;
+    _result = state == TWTFutureStateSucceeded ? result : nil;
+    _error = state == TWTFutureStateSucceeded ? nil : error;
+
+    NSArray<TWTFutureCallback> *callbacks = _callbacks;
+    NSArray<dispatch_block_t> *cancellationHandlers = state == TWTFutureStateCancelled ? _cancellationHandlers : nil;
+    _callbacks = nil;
+    _cancellationHandlers = nil;
+    pthread_mutex_unlock(&_lock);
+
+    for (dispatch_block_t cancellationHandler in cancellationHandlers) {
+        cancellationHandler();
+    }
+
+    for (TWTFutureCallback callback in callbacks) {
+        callback(self);
+    }
+
+    return YES;
+}
+
+
+- (BOOL)resolveWithFuture:(TWTFuture *)future
+{
+    return [self resolveWithState:future->_state result:future->_result error:future->_error];
+}
+
+
+- (void)addCallback:(TWTFutureCallback)callback
+{
+    pthread_mutex_lock(&_lock);
+    if (_state == TWTFutureStatePending) {
+        if (!_callbacks) {
+            _callbacks = [[NSMutableArray alloc] init];
+        }
+
+        [_callbacks addObject:[callback copy]];
+        callback = nil;
+    }
+    pthread_mutex_unlock(&_lock);
+
+    // If we’re already resolved, invoke the callback immediately
+    if (callback) {
+        callback(self);
+    }
+}
+
+
+- (void)addCancellationHandler:(dispatch_block_t)cancellationHandler
+{
+    pthread_mutex_lock(&_lock);
+    BOOL cancelled = _state == TWTFutureStateCancelled;
+    if (_state == TWTFutureStatePending) {
+        if (!_cancellationHandlers) {
+            _cancellationHandlers = [[NSMutableArray alloc] init];
+        }
+
+        [_cancellationHandlers addObject:[cancellationHandler copy]];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (cancelled) {
+        cancellationHandler();
+    }
+}
+
+@end
+
+
+#pragma mark -
+
+@implementation TWTPromise
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _future = [[TWTFuture alloc] init];
+    }
+    return self;
+}
+
+
+- (BOOL)fulfillWithResult:(id)result
+{
+    return [self.future resolveWithState:TWTFutureStateSucceeded result:result error:nil];
+}
+
+
+- (BOOL)rejectWithError:(NSError *)error
+{
+    NSParameterAssert(error);
+    return [self.future resolveWithState:TWTFutureStateFailed result:nil error:error];
+}
+
+@end
@@ -0,0 +1,95 @@
+//
+//  TWTKeyedSerialExecutor.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTAsynchronousOperation.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TWTKeyedSerialExecutors run operations serially per key and in parallel across keys. Operations submitted with the 
+ same key are executed one at a time, in the order they were submitted, with each one starting only after the 
+ previous one has finished. Operations with different keys share a fixed pool of workers.
+ 
+ Each key with outstanding work has a lane, which holds its pending operations. Lanes are created on demand and 
+ reclaimed as soon as their last operation finishes, so the executor’s memory use is proportional to the number of 
+ keys with outstanding work rather than the number of keys ever used. This makes it a cheap replacement for creating 
+ a serial dispatch queue per entity.
+ 
+ Cancelled operations still take their turn in their lane, but finish immediately without executing their work.
+ */
+@interface TWTKeyedSerialExecutor : NSObject
+
+/*! The maximum number of operations that execute concurrently. */
+@property (nonatomic, assign, readonly) NSUInteger workerCount;
+
+/*! The number of keys that currently have pending or executing operations. */
+@property (nonatomic, assign, readonly) NSUInteger laneCount;
+
+/*!
+ @abstract Initializes a newly created executor with one worker per active processor.
+ @result An initialized executor.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created executor with the specified number of workers.
+ @param workerCount The maximum number of operations to execute concurrently. Must be positive.
+ @result An initialized executor.
+ */
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Creates a TWTAsynchronousOperation with the specified block and submits it for execution in the lane for 
+     the specified key.
+ @discussion As with any TWTAsynchronousOperation, the block must eventually invoke ‑finishOperationExecution on its 
+     operation. The next operation in the key’s lane does not start until it does.
+ @param key The key whose lane the operation should execute in. May not be nil.
+ @param block The operation block to execute. May not be nil.
+ @result The submitted operation.
+ */
+- (TWTAsynchronousOperation *)addOperationForKey:(id<NSCopying>)key block:(TWTAsynchronousOperationBlock)block;
+
+/*!
+ @abstract Submits the specified operation for execution in the lane for the specified key.
+ @discussion An operation should only be submitted once, and should not also be added to an NSOperationQueue. 
+     Dependencies on other operations are honored, but an operation that is waiting on a dependency holds up the rest
+     of its lane.
+ @param operation The operation to execute. May not be nil.
+ @param key The key whose lane the operation should execute in. May not be nil.
+ */
+- (void)addOperation:(TWTAsynchronousOperation *)operation forKey:(id<NSCopying>)key;
+
+/*!
+ @abstract Blocks the calling thread until every submitted operation has finished.
+ */
+- (void)waitUntilAllOperationsAreFinished;
+
+@end
+
+NS_ASSUME_NONNULL_END
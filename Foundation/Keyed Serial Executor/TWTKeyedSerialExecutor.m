@@ -0,0 +1,189 @@
+//
+//  TWTKeyedSerialExecutor.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTKeyedSerialExecutor.h"
+
+#import <pthread.h>
+
+
+/*!
+ TWTKeyedSerialLane holds the operations for a single key that have not yet been handed to the worker pool. The lane’s
+ head operation is always executing or waiting in the pool, so a lane with no pending operations becomes idle as soon
+ as its head finishes. Lanes are guarded by the executor’s lock.
+ */
+@interface TWTKeyedSerialLane : NSObject {
+@public
+    NSMutableArray<TWTAsynchronousOperation *> *_pendingOperations;
+}
+
+@end
+
+
+@implementation TWTKeyedSerialLane
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        _pendingOperations = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+@end
+
+
+#pragma mark -
+
+@implementation TWTKeyedSerialExecutor {
+    // Guards _lanes
+    pthread_mutex_t _lock;
+    NSMutableDictionary<id<NSCopying>, TWTKeyedSerialLane *> *_lanes;
+
+    NSOperationQueue *_workerQueue;
+    dispatch_group_t _outstandingOperationGroup;
+}
+
+- (instancetype)init
+{
+    return [self initWithWorkerCount:[[NSProcessInfo processInfo] activeProcessorCount]];
+}
+
+
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount
+{
+    NSParameterAssert(workerCount > 0);
+
+    self = [super init];
+    if (self) {
+        _workerCount = workerCount;
+        pthread_mutex_init(&_lock, NULL);
+        _lanes = [[NSMutableDictionary alloc] init];
+
+        _workerQueue = [[NSOperationQueue alloc] init];
+        _workerQueue.maxConcurrentOperationCount = workerCount;
+        _workerQueue.name = [NSString stringWithFormat:@"%@.%p", self.class, self];
+
+        _outstandingOperationGroup = dispatch_group_create();
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_lock);
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p workerCount=%lu laneCount=%lu>",
+            self.class, self, (unsigned long)self.workerCount, (unsigned long)self.laneCount];
+}
+
+
+- (NSUInteger)laneCount
+{
+    pthread_mutex_lock(&_lock);
+    NSUInteger laneCount = _lanes.count;
+    pthread_mutex_unlock(&_lock);
+    return laneCount;
+}
+
+
+#pragma mark Submission
+
+- (TWTAsynchronousOperation *)addOperationForKey:(id<NSCopying>)key block:(TWTAsynchronousOperationBlock)block
+{
+    NSParameterAssert(block);
+
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:block];
+    [self addOperation:operation forKey:key];
+    return operation;
+}
+
+
+- (void)addOperation:(TWTAsynchronousOperation *)operation forKey:(id<NSCopying>)key
+{
+    NSParameterAssert(operation);
+    NSParameterAssert(key);
+
+    dispatch_group_enter(_outstandingOperationGroup);
+
+    pthread_mutex_lock(&_lock);
+    TWTKeyedSerialLane *lane = _lanes[key];
+    if (lane) {
+        [lane->_pendingOperations addObject:operation];
+        pthread_mutex_unlock(&_lock);
+        return;
+    }
+
+    // The key was idle, so the operation can go straight to the worker pool
+    _lanes[key] = [[TWTKeyedSerialLane alloc] init];
+    pthread_mutex_unlock(&_lock);
+
+    [self submitOperation:operation forKey:key];
+}
+
+
+- (void)submitOperation:(TWTAsynchronousOperation *)operation forKey:(id<NSCopying>)key
+{
+    [operation addFinishHandler:^(TWTAsynchronousOperation *operation) {
+        [self operationDidFinishForKey:key];
+    }];
+
+    [_workerQueue addOperation:operation];
+}
+
+
+- (void)operationDidFinishForKey:(id<NSCopying>)key
+{
+    pthread_mutex_lock(&_lock);
+    TWTKeyedSerialLane *lane = _lanes[key];
+    TWTAsynchronousOperation *nextOperation = lane->_pendingOperations.firstObject;
+    if (nextOperation) {
+        [lane->_pendingOperations removeObjectAtIndex:0];
+    } else {
+        // Reclaim the lane now that it’s idle
+        [_lanes removeObjectForKey:key];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (nextOperation) {
+        [self submitOperation:nextOperation forKey:key];
+    }
+
+    dispatch_group_leave(_outstandingOperationGroup);
+}
+
+
+- (void)waitUntilAllOperationsAreFinished
+{
+    dispatch_group_wait(_outstandingOperationGroup, DISPATCH_TIME_FOREVER);
+}
+
+@end
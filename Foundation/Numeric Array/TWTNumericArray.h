@@ -0,0 +1,237 @@
+//
+//  TWTNumericArray.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TWTNumericArray is the abstract superclass of immutable arrays of unboxed numbers stored in a contiguous C buffer. 
+ Its concrete subclasses, TWTDoubleArray and TWTInt64Array, offer the block enumeration vocabulary—collect, detect,
+ inject, reject, and select—with blocks that take and return scalars, so no NSNumber is created and no message is 
+ sent per element. They also offer SIMD-friendly sum, minimum, maximum, and mean reductions and mask-based selection,
+ which are an order of magnitude faster than the equivalent operations on arrays of NSNumbers.
+ 
+ Numeric arrays convert to and from arrays of NSNumbers using ‑initWithArray: and ‑arrayValue.
+
+ Equality is bitwise: two numeric arrays are equal if they are of the same class and their values have identical bit
+ patterns. For TWTDoubleArrays, this means that an array containing 0.0 is not equal to one containing -0.0, and that
+ arrays containing identical NaNs are equal.
+ */
+@interface TWTNumericArray : NSObject <NSCopying>
+
+/*! The number of values in the array. */
+@property (nonatomic, assign, readonly) NSUInteger count;
+
+- (instancetype)init NS_UNAVAILABLE;
+
+/*!
+ @abstract Initializes a newly allocated numeric array with the values of the specified NSNumbers.
+ @param array The array of NSNumbers whose values to use. May not be nil.
+ @result An initialized numeric array.
+ */
+- (instancetype)initWithArray:(NSArray<NSNumber *> *)array;
+
+/*!
+ @abstract Returns an array of NSNumbers with the values of the receiver.
+ @result An array of NSNumbers.
+ */
+- (NSArray<NSNumber *> *)arrayValue;
+
+/*!
+ @abstract Returns a mask in which each byte is 1 if the corresponding value of the receiver is in the specified 
+     closed range and 0 otherwise.
+ @discussion Masks can be combined with bitwise operations and passed to ‑arrayBySelectingValuesWithMask:. Values are
+     compared without branching, so the comparison is vectorized.
+ @param minimum The smallest value in the range.
+ @param maximum The largest value in the range.
+ @result A mask with one byte per value of the receiver.
+ */
+- (NSData *)maskForValuesWithMinimum:(NSNumber *)minimum maximum:(NSNumber *)maximum;
+
+/*!
+ @abstract Returns a new numeric array with the values of the receiver whose corresponding mask bytes are non-zero.
+ @param mask The mask, which must contain one byte per value of the receiver. May not be nil.
+ @result A new numeric array of the receiver’s class with the selected values, in order.
+ */
+- (instancetype)arrayBySelectingValuesWithMask:(NSData *)mask;
+
+@end
+
+
+#pragma mark
+
+/*!
+ TWTDoubleArrays are numeric arrays of doubles.
+ */
+@interface TWTDoubleArray : TWTNumericArray
+
+/*! A pointer to the array’s values. This is valid for the lifetime of the array. */
+@property (nonatomic, assign, readonly) const double *values NS_RETURNS_INNER_POINTER;
+
+/*! The sum of the array’s values, or 0 if the array is empty. */
+@property (nonatomic, assign, readonly) double sum;
+
+/*! The smallest of the array’s values, or +∞ if the array is empty. */
+@property (nonatomic, assign, readonly) double minimum;
+
+/*! The largest of the array’s values, or -∞ if the array is empty. */
+@property (nonatomic, assign, readonly) double maximum;
+
+/*! The arithmetic mean of the array’s values, or NaN if the array is empty. */
+@property (nonatomic, assign, readonly) double mean;
+
+/*!
+ @abstract Initializes a newly allocated double array with a copy of the specified values.
+ @param values The values. May be NULL if count is 0.
+ @param count The number of values.
+ @result An initialized double array.
+ */
+- (instancetype)initWithValues:(nullable const double *)values count:(NSUInteger)count;
+
+/*!
+ @abstract Returns the value at the specified index.
+ @param index The index. Raises an NSRangeException if it is beyond the end of the array.
+ @result The value at the index.
+ */
+- (double)valueAtIndex:(NSUInteger)index;
+
+/*!
+ @abstract Returns a new array with the results of invoking the block on each value of the receiver.
+ @param block The block to invoke on each value. May not be nil.
+ @result A new double array.
+ */
+- (TWTDoubleArray *)collectWithBlock:(double (^)(double value))block;
+
+/*!
+ @abstract Returns the index of the first value for which the block returns YES.
+ @param block Predicate block to test values. May not be nil.
+ @result The index of the first value that passes the test, or NSNotFound if there is none.
+ */
+- (NSUInteger)detectWithBlock:(BOOL (^)(double value))block;
+
+/*!
+ @abstract Passes each value of the receiver and a memo to the block, starting with the initial value.
+ @param initialValue The memo to pass to the first invocation of the block.
+ @param block The block to invoke for each value. Its return value is the memo for the next invocation. May not be nil.
+ @result The value returned by the last invocation of the block, or initialValue if the array is empty.
+ */
+- (double)injectWithInitialValue:(double)initialValue block:(double (^)(double memo, double value))block;
+
+/*!
+ @abstract Returns a new array with the values of the receiver for which the block returns NO.
+ @param block Predicate block to test values. May not be nil.
+ @result A new double array.
+ */
+- (TWTDoubleArray *)rejectWithBlock:(BOOL (^)(double value))block;
+
+/*!
+ @abstract Returns a new array with the values of the receiver for which the block returns YES.
+ @param block Predicate block to test values. May not be nil.
+ @result A new double array.
+ */
+- (TWTDoubleArray *)selectWithBlock:(BOOL (^)(double value))block;
+
+@end
+
+
+#pragma mark
+
+/*!
+ TWTInt64Arrays are numeric arrays of 64-bit signed integers. Sums wrap around on overflow.
+ */
+@interface TWTInt64Array : TWTNumericArray
+
+/*! A pointer to the array’s values. This is valid for the lifetime of the array. */
+@property (nonatomic, assign, readonly) const int64_t *values NS_RETURNS_INNER_POINTER;
+
+/*! The sum of the array’s values, or 0 if the array is empty. */
+@property (nonatomic, assign, readonly) int64_t sum;
+
+/*! The smallest of the array’s values, or INT64_MAX if the array is empty. */
+@property (nonatomic, assign, readonly) int64_t minimum;
+
+/*! The largest of the array’s values, or INT64_MIN if the array is empty. */
+@property (nonatomic, assign, readonly) int64_t maximum;
+
+/*! The arithmetic mean of the array’s values, or NaN if the array is empty. */
+@property (nonatomic, assign, readonly) double mean;
+
+/*!
+ @abstract Initializes a newly allocated integer array with a copy of the specified values.
+ @param values The values. May be NULL if count is 0.
+ @param count The number of values.
+ @result An initialized integer array.
+ */
+- (instancetype)initWithValues:(nullable const int64_t *)values count:(NSUInteger)count;
+
+/*!
+ @abstract Returns the value at the specified index.
+ @param index The index. Raises an NSRangeException if it is beyond the end of the array.
+ @result The value at the index.
+ */
+- (int64_t)valueAtIndex:(NSUInteger)index;
+
+/*!
+ @abstract Returns a new array with the results of invoking the block on each value of the receiver.
+ @param block The block to invoke on each value. May not be nil.
+ @result A new integer array.
+ */
+- (TWTInt64Array *)collectWithBlock:(int64_t (^)(int64_t value))block;
+
+/*!
+ @abstract Returns the index of the first value for which the block returns YES.
+ @param block Predicate block to test values. May not be nil.
+ @result The index of the first value that passes the test, or NSNotFound if there is none.
+ */
+- (NSUInteger)detectWithBlock:(BOOL (^)(int64_t value))block;
+
+/*!
+ @abstract Passes each value of the receiver and a memo to the block, starting with the initial value.
+ @param initialValue The memo to pass to the first invocation of the block.
+ @param block The block to invoke for each value. Its return value is the memo for the next invocation. May not be nil.
+ @result The value returned by the last invocation of the block, or initialValue if the array is empty.
+ */
+- (int64_t)injectWithInitialValue:(int64_t)initialValue block:(int64_t (^)(int64_t memo, int64_t value))block;
+
+/*!
+ @abstract Returns a new array with the values of the receiver for which the block returns NO.
+ @param block Predicate block to test values. May not be nil.
+ @result A new integer array.
+ */
+- (TWTInt64Array *)rejectWithBlock:(BOOL (^)(int64_t value))block;
+
+/*!
+ @abstract Returns a new array with the values of the receiver for which the block returns YES.
+ @param block Predicate block to test values. May not be nil.
+ @result A new integer array.
+ */
+- (TWTInt64Array *)selectWithBlock:(BOOL (^)(int64_t value))block;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,699 @@
+//
+//  TWTNumericArray.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTNumericArray.h"
+
+#import "NSException+TWTSubclassResponsibility.h"
+
+
+// Four-lane vectors for reductions. The compiler maps operations on these directly to SIMD instructions.
+typedef double TWTDoubleVector __attribute__((ext_vector_type(4)));
+typedef uint64_t TWTUInt64Vector __attribute__((ext_vector_type(4)));
+
+// Conversions from NSArrays copy this many objects at a time into a stack buffer
+enum {
+    kTWTNumericArrayConversionBatchSize = 256
+};
+
+
+#pragma mark Kernels
+
+static double TWTDoubleArraySum(const double *values, NSUInteger count)
+{
+    // Like any reordered summation, this may differ from a sequential sum in the last few bits
+    TWTDoubleVector partialSums = 0;
+    NSUInteger i = 0;
+    for (; i + 4 <= count; i += 4) {
+        TWTDoubleVector vector;
+        memcpy(&vector, values + i, sizeof(vector));
+        partialSums += vector;
+    }
+
+    double sum = (partialSums.x + partialSums.y) + (partialSums.z + partialSums.w);
+    for (; i < count; ++i) {
+        sum += values[i];
+    }
+
+    return sum;
+}
+
+
+static int64_t TWTInt64ArraySum(const int64_t *values, NSUInteger count)
+{
+    // Sum as unsigned so that overflow wraps around rather than being undefined
+    TWTUInt64Vector partialSums = 0;
+    NSUInteger i = 0;
+    for (; i + 4 <= count; i += 4) {
+        TWTUInt64Vector vector;
+        memcpy(&vector, values + i, sizeof(vector));
+        partialSums += vector;
+    }
+
+    uint64_t sum = (partialSums.x + partialSums.y) + (partialSums.z + partialSums.w);
+    for (; i < count; ++i) {
+        sum += (uint64_t)values[i];
+    }
+
+    return (int64_t)sum;
+}
+
+
+// The minimum and maximum kernels keep four independent, branchless accumulators so that the compiler can vectorize
+// them. Their initial values are the identities of the reductions, which are also the results for empty arrays.
+
+static double TWTDoubleArrayMinimum(const double *values, NSUInteger count)
+{
+    double minima[4] = { INFINITY, INFINITY, INFINITY, INFINITY };
+    for (NSUInteger i = 0; i < count; ++i) {
+        minima[i % 4] = values[i] < minima[i % 4] ? values[i] : minima[i % 4];
+    }
+
+    double minimum01 = minima[0] < minima[1] ? minima[0] : minima[1];
+    double minimum23 = minima[2] < minima[3] ? minima[2] : minima[3];
+    return minimum01 < minimum23 ? minimum01 : minimum23;
+}
+
+
+static double TWTDoubleArrayMaximum(const double *values, NSUInteger count)
+{
+    double maxima[4] = { -INFINITY, -INFINITY, -INFINITY, -INFINITY };
+    for (NSUInteger i = 0; i < count; ++i) {
+        maxima[i % 4] = values[i] > maxima[i % 4] ? values[i] : maxima[i % 4];
+    }
+
+    double maximum01 = maxima[0] > maxima[1] ? maxima[0] : maxima[1];
+    double maximum23 = maxima[2] > maxima[3] ? maxima[2] : maxima[3];
+    return maximum01 > maximum23 ? maximum01 : maximum23;
+}
+
+
+static int64_t TWTInt64ArrayMinimum(const int64_t *values, NSUInteger count)
+{
+    int64_t minimum = INT64_MAX;
+    for (NSUInteger i = 0; i < count; ++i) {
+        minimum = values[i] < minimum ? values[i] : minimum;
+    }
+
+    return minimum;
+}
+
+
+static int64_t TWTInt64ArrayMaximum(const int64_t *values, NSUInteger count)
+{
+    int64_t maximum = INT64_MIN;
+    for (NSUInteger i = 0; i < count; ++i) {
+        maximum = values[i] > maximum ? values[i] : maximum;
+    }
+
+    return maximum;
+}
+
+
+#pragma mark - TWTNumericArray
+
+@interface TWTNumericArray ()
+
+/*! The array’s values. */
+@property (nonatomic, assign, readonly) const void *bytes;
+
+/*!
+ @abstract Initializes a newly allocated numeric array with the specified buffer, which it takes ownership of.
+ @param bytes A buffer allocated with malloc. The numeric array frees it when deallocated. May be NULL if count is 0.
+ @param count The number of values in the buffer.
+ @result An initialized numeric array.
+ */
+- (instancetype)initWithBytesNoCopy:(void *)bytes count:(NSUInteger)count NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Initializes a newly allocated numeric array with a copy of the specified buffer.
+ @param bytes The values. May be NULL if count is 0.
+ @param count The number of values in the buffer.
+ @result An initialized numeric array.
+ */
+- (instancetype)initWithBytes:(const void *)bytes count:(NSUInteger)count;
+
+/*!
+ @abstract Returns a new numeric array of the receiver’s class with the values whose mask bytes are non-zero.
+ @param mask A buffer with one byte per value of the receiver.
+ @result A new numeric array.
+ */
+- (instancetype)arrayBySelectingValuesWithMaskBytes:(const uint8_t *)mask;
+
+/*!
+ @abstract Returns a new buffer with the values of the specified NSNumbers converted to the class’s element type.
+ @discussion Subclasses must override this method.
+ @param numbers The NSNumbers to convert.
+ @result A buffer allocated with malloc, which the caller must free.
+ */
++ (void *)newBytesWithNumbers:(NSArray *)numbers;
+
+@end
+
+
+@implementation TWTNumericArray
+
+// Both doubles and int64_ts are 8 bytes, so copying, comparing, and selecting can be done generically
+_Static_assert(sizeof(double) == sizeof(int64_t), "Numeric array element types must be the same size");
+
+- (instancetype)init
+{
+    [self doesNotRecognizeSelector:_cmd];
+    return nil;
+}
+
+
+- (instancetype)initWithBytesNoCopy:(void *)bytes count:(NSUInteger)count
+{
+    NSParameterAssert(bytes || count == 0);
+
+    self = [super init];
+    if (self) {
+        _bytes = bytes;
+        _count = count;
+    }
+
+    return self;
+}
+
+
+- (instancetype)initWithBytes:(const void *)bytes count:(NSUInteger)count
+{
+    void *bytesCopy = malloc(MAX(count, 1) * sizeof(int64_t));
+    if (count > 0) {
+        memcpy(bytesCopy, bytes, count * sizeof(int64_t));
+    }
+
+    return [self initWithBytesNoCopy:bytesCopy count:count];
+}
+
+
+- (instancetype)initWithArray:(NSArray<NSNumber *> *)array
+{
+    NSParameterAssert(array);
+    return [self initWithBytesNoCopy:[[self class] newBytesWithNumbers:array] count:array.count];
+}
+
+
++ (void *)newBytesWithNumbers:(NSArray *)numbers
+{
+    @throw [NSException twt_subclassResponsibilityExceptionWithReceiver:self selector:_cmd];
+}
+
+
+- (void)dealloc
+{
+    free((void *)_bytes);
+}
+
+
+- (id)copyWithZone:(NSZone *)zone
+{
+    return self;
+}
+
+
+- (BOOL)isEqual:(id)object
+{
+    if (self == object) {
+        return YES;
+    } else if (![object isMemberOfClass:[self class]]) {
+        return NO;
+    }
+
+    TWTNumericArray *array = object;
+    return _count == array->_count && memcmp(_bytes, array->_bytes, _count * sizeof(int64_t)) == 0;
+}
+
+
+- (NSUInteger)hash
+{
+    NSUInteger hash = _count;
+    if (_count > 0) {
+        int64_t firstValue;
+        memcpy(&firstValue, _bytes, sizeof(firstValue));
+        hash ^= (NSUInteger)firstValue;
+    }
+
+    return hash;
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p count=%lu>", self.class, self, (unsigned long)_count];
+}
+
+
+- (NSArray *)arrayValue
+{
+    @throw [NSException twt_subclassResponsibilityExceptionWithReceiver:self selector:_cmd];
+}
+
+
+- (NSData *)maskForValuesWithMinimum:(NSNumber *)minimum maximum:(NSNumber *)maximum
+{
+    @throw [NSException twt_subclassResponsibilityExceptionWithReceiver:self selector:_cmd];
+}
+
+
+- (instancetype)arrayBySelectingValuesWithMask:(NSData *)mask
+{
+    NSParameterAssert(mask);
+    NSParameterAssert(mask.length == _count);
+    return [self arrayBySelectingValuesWithMaskBytes:mask.bytes];
+}
+
+
+- (instancetype)arrayBySelectingValuesWithMaskBytes:(const uint8_t *)mask
+{
+    const int64_t *values = _bytes;
+    int64_t *selectedValues = malloc(MAX(_count, 1) * sizeof(int64_t));
+
+    // Write every value but only advance past the ones that are selected, which avoids unpredictable branches
+    NSUInteger selectedCount = 0;
+    for (NSUInteger i = 0; i < _count; ++i) {
+        selectedValues[selectedCount] = values[i];
+        selectedCount += mask[i] != 0;
+    }
+
+    return [[[self class] alloc] initWithBytesNoCopy:selectedValues count:selectedCount];
+}
+
+@end
+
+
+#pragma mark - TWTDoubleArray
+
+@implementation TWTDoubleArray
+
+- (instancetype)initWithValues:(const double *)values count:(NSUInteger)count
+{
+    return [self initWithBytes:values count:count];
+}
+
+
++ (void *)newBytesWithNumbers:(NSArray *)numbers
+{
+    NSUInteger count = numbers.count;
+    double *values = malloc(MAX(count, 1) * sizeof(double));
+
+    __unsafe_unretained NSNumber *batch[kTWTNumericArrayConversionBatchSize];
+    for (NSUInteger location = 0; location < count; location += kTWTNumericArrayConversionBatchSize) {
+        NSRange range = NSMakeRange(location, MIN(kTWTNumericArrayConversionBatchSize, count - location));
+        [numbers getObjects:batch range:range];
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            values[location + i] = batch[i].doubleValue;
+        }
+    }
+
+    return values;
+}
+
+
+- (const double *)values
+{
+    return self.bytes;
+}
+
+
+- (double)valueAtIndex:(NSUInteger)index
+{
+    if (index >= self.count) {
+        [NSException raise:NSRangeException format:@"index %lu beyond bounds [0 .. %ld]", (unsigned long)index, (long)self.count - 1];
+    }
+
+    return self.values[index];
+}
+
+
+- (NSArray *)arrayValue
+{
+    NSUInteger count = self.count;
+    const double *values = self.values;
+    __strong NSNumber **numbers = (__strong NSNumber **)calloc(MAX(count, 1), sizeof(NSNumber *));
+    for (NSUInteger i = 0; i < count; ++i) {
+        numbers[i] = @(values[i]);
+    }
+
+    NSArray *array = [[NSArray alloc] initWithObjects:numbers count:count];
+
+    for (NSUInteger i = 0; i < count; ++i) {
+        numbers[i] = nil;
+    }
+
+    free(numbers);
+    return array;
+}
+
+
+#pragma mark Reductions
+
+- (double)sum
+{
+    return TWTDoubleArraySum(self.values, self.count);
+}
+
+
+- (double)minimum
+{
+    return TWTDoubleArrayMinimum(self.values, self.count);
+}
+
+
+- (double)maximum
+{
+    return TWTDoubleArrayMaximum(self.values, self.count);
+}
+
+
+- (double)mean
+{
+    return self.count > 0 ? self.sum / self.count : NAN;
+}
+
+
+- (NSData *)maskForValuesWithMinimum:(NSNumber *)minimum maximum:(NSNumber *)maximum
+{
+    NSParameterAssert(minimum);
+    NSParameterAssert(maximum);
+
+    NSUInteger count = self.count;
+    const double *values = self.values;
+    double minimumValue = minimum.doubleValue;
+    double maximumValue = maximum.doubleValue;
+
+    uint8_t *mask = malloc(MAX(count, 1));
+    for (NSUInteger i = 0; i < count; ++i) {
+        mask[i] = (values[i] >= minimumValue) & (values[i] <= maximumValue);
+    }
+
+    return [[NSData alloc] initWithBytesNoCopy:mask length:count freeWhenDone:YES];
+}
+
+
+#pragma mark Block Enumeration
+
+- (TWTDoubleArray *)collectWithBlock:(double (^)(double))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const double *values = self.values;
+    double *results = malloc(MAX(count, 1) * sizeof(double));
+    for (NSUInteger i = 0; i < count; ++i) {
+        results[i] = block(values[i]);
+    }
+
+    return [[TWTDoubleArray alloc] initWithBytesNoCopy:results count:count];
+}
+
+
+- (NSUInteger)detectWithBlock:(BOOL (^)(double))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const double *values = self.values;
+    for (NSUInteger i = 0; i < count; ++i) {
+        if (block(values[i])) {
+            return i;
+        }
+    }
+
+    return NSNotFound;
+}
+
+
+- (double)injectWithInitialValue:(double)initialValue block:(double (^)(double, double))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const double *values = self.values;
+    double memo = initialValue;
+    for (NSUInteger i = 0; i < count; ++i) {
+        memo = block(memo, values[i]);
+    }
+
+    return memo;
+}
+
+
+- (TWTDoubleArray *)rejectWithBlock:(BOOL (^)(double))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const double *values = self.values;
+    uint8_t *mask = malloc(MAX(count, 1));
+    for (NSUInteger i = 0; i < count; ++i) {
+        mask[i] = block(values[i]) ? 0 : 1;
+    }
+
+    TWTDoubleArray *unrejectedValues = [self arrayBySelectingValuesWithMaskBytes:mask];
+    free(mask);
+    return unrejectedValues;
+}
+
+
+- (TWTDoubleArray *)selectWithBlock:(BOOL (^)(double))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const double *values = self.values;
+    uint8_t *mask = malloc(MAX(count, 1));
+    for (NSUInteger i = 0; i < count; ++i) {
+        mask[i] = block(values[i]) ? 1 : 0;
+    }
+
+    TWTDoubleArray *selectedValues = [self arrayBySelectingValuesWithMaskBytes:mask];
+    free(mask);
+    return selectedValues;
+}
+
+@end
+
+
+#pragma mark - TWTInt64Array
+
+@implementation TWTInt64Array
+
+- (instancetype)initWithValues:(const int64_t *)values count:(NSUInteger)count
+{
+    return [self initWithBytes:values count:count];
+}
+
+
++ (void *)newBytesWithNumbers:(NSArray *)numbers
+{
+    NSUInteger count = numbers.count;
+    int64_t *values = malloc(MAX(count, 1) * sizeof(int64_t));
+
+    __unsafe_unretained NSNumber *batch[kTWTNumericArrayConversionBatchSize];
+    for (NSUInteger location = 0; location < count; location += kTWTNumericArrayConversionBatchSize) {
+        NSRange range = NSMakeRange(location, MIN(kTWTNumericArrayConversionBatchSize, count - location));
+        [numbers getObjects:batch range:range];
+        for (NSUInteger i = 0; i < range.length; ++i) {
+            values[location + i] = batch[i].longLongValue;
+        }
+    }
+
+    return values;
+}
+
+
+- (const int64_t *)values
+{
+    return self.bytes;
+}
+
+
+- (int64_t)valueAtIndex:(NSUInteger)index
+{
+    if (index >= self.count) {
+        [NSException raise:NSRangeException format:@"index %lu beyond bounds [0 .. %ld]", (unsigned long)index, (long)self.count - 1];
+    }
+
+    return self.values[index];
+}
+
+
+- (NSArray *)arrayValue
+{
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    __strong NSNumber **numbers = (__strong NSNumber **)calloc(MAX(count, 1), sizeof(NSNumber *));
+    for (NSUInteger i = 0; i < count; ++i) {
+        numbers[i] = @(values[i]);
+    }
+
+    NSArray *array = [[NSArray alloc] initWithObjects:numbers count:count];
+
+    for (NSUInteger i = 0; i < count; ++i) {
+        numbers[i] = nil;
+    }
+
+    free(numbers);
+    return array;
+}
+
+
+#pragma mark Reductions
+
+- (int64_t)sum
+{
+    return TWTInt64ArraySum(self.values, self.count);
+}
+
+
+- (int64_t)minimum
+{
+    return TWTInt64ArrayMinimum(self.values, self.count);
+}
+
+
+- (int64_t)maximum
+{
+    return TWTInt64ArrayMaximum(self.values, self.count);
+}
+
+
+- (double)mean
+{
+    // Sum as doubles rather than dividing the integer sum, which could have overflowed
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    double sum = 0;
+    for (NSUInteger i = 0; i < count; ++i) {
+        sum += values[i];
+    }
+
+    return count > 0 ? sum / count : NAN;
+}
+
+
+- (NSData *)maskForValuesWithMinimum:(NSNumber *)minimum maximum:(NSNumber *)maximum
+{
+    NSParameterAssert(minimum);
+    NSParameterAssert(maximum);
+
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    int64_t minimumValue = minimum.longLongValue;
+    int64_t maximumValue = maximum.longLongValue;
+
+    uint8_t *mask = malloc(MAX(count, 1));
+    for (NSUInteger i = 0; i < count; ++i) {
+        mask[i] = (values[i] >= minimumValue) & (values[i] <= maximumValue);
+    }
+
+    return [[NSData alloc] initWithBytesNoCopy:mask length:count freeWhenDone:YES];
+}
+
+
+#pragma mark Block Enumeration
+
+- (TWTInt64Array *)collectWithBlock:(int64_t (^)(int64_t))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    int64_t *results = malloc(MAX(count, 1) * sizeof(int64_t));
+    for (NSUInteger i = 0; i < count; ++i) {
+        results[i] = block(values[i]);
+    }
+
+    return [[TWTInt64Array alloc] initWithBytesNoCopy:results count:count];
+}
+
+
+- (NSUInteger)detectWithBlock:(BOOL (^)(int64_t))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    for (NSUInteger i = 0; i < count; ++i) {
+        if (block(values[i])) {
+            return i;
+        }
+    }
+
+    return NSNotFound;
+}
+
+
+- (int64_t)injectWithInitialValue:(int64_t)initialValue block:(int64_t (^)(int64_t, int64_t))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    int64_t memo = initialValue;
+    for (NSUInteger i = 0; i < count; ++i) {
+        memo = block(memo, values[i]);
+    }
+
+    return memo;
+}
+
+
+- (TWTInt64Array *)rejectWithBlock:(BOOL (^)(int64_t))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    uint8_t *mask = malloc(MAX(count, 1));
+    for (NSUInteger i = 0; i < count; ++i) {
+        mask[i] = block(values[i]) ? 0 : 1;
+    }
+
+    TWTInt64Array *unrejectedValues = [self arrayBySelectingValuesWithMaskBytes:mask];
+    free(mask);
+    return unrejectedValues;
+}
+
+
+- (TWTInt64Array *)selectWithBlock:(BOOL (^)(int64_t))block
+{
+    NSParameterAssert(block);
+
+    NSUInteger count = self.count;
+    const int64_t *values = self.values;
+    uint8_t *mask = malloc(MAX(count, 1));
+    for (NSUInteger i = 0; i < count; ++i) {
+        mask[i] = block(values[i]) ? 1 : 0;
+    }
+
+    TWTInt64Array *selectedValues = [self arrayBySelectingValuesWithMaskBytes:mask];
+    free(mask);
+    return selectedValues;
+}
+
+@end
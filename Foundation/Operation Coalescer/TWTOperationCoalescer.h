@@ -0,0 +1,134 @@
+//
+//  TWTOperationCoalescer.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTAsynchronousOperation.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The error domain for errors generated by TWTOperationCoalescer.
+ */
+extern NSString *const kTWTOperationCoalescerErrorDomain;
+
+typedef NS_ENUM(NSInteger, TWTOperationCoalescerError) {
+    /*!
+     This error is passed to result blocks if the operation for their key finished without producing a result, e.g.,
+     because it was cancelled.
+     */
+    TWTOperationCoalescerErrorNoResult
+};
+
+
+/*!
+ @abstract Type for blocks that receive the result of a keyed operation.
+ @param result The operation’s result. nil if an error occurred.
+ @param error The error that occurred. nil if the operation succeeded.
+ */
+typedef void (^TWTOperationCoalescerResultBlock)(id _Nullable result, NSError * _Nullable error);
+
+/*!
+ @abstract Type for blocks that perform the work of a keyed operation.
+ @discussion The block must eventually invoke finishBlock exactly once with the operation’s result. Doing so also 
+     finishes the operation, so the block should not invoke ‑finishOperationExecution itself.
+ @param operation The operation executing the block.
+ @param finishBlock The block to invoke with the operation’s result.
+ */
+typedef void (^TWTOperationCoalescerWorkBlock)(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock);
+
+
+/*!
+ TWTOperationCoalescers prevent duplicate work by coalescing keyed operations. When an operation is submitted for a 
+ key that already has an operation pending or executing, no new operation is created. Instead, the submitter’s result
+ block is attached to the existing operation, and every attached result block receives that operation’s result. Keys 
+ are released as soon as their operation finishes. 
+ 
+ Optionally, successful results can be cached for a short time, in which case submissions for the same key during that
+ time receive the cached result immediately.
+ */
+@interface TWTOperationCoalescer : NSObject
+
+/*! The operation queue on which the coalescer’s operations execute. */
+@property (nonatomic, strong, readonly) NSOperationQueue *operationQueue;
+
+/*! 
+ How long successful results are cached after their operation finishes. A value of zero, the default, disables 
+ caching.
+ */
+@property (atomic, assign) NSTimeInterval resultCacheDuration;
+
+/*! The total number of submissions. */
+@property (nonatomic, assign, readonly) NSUInteger submissionCount;
+
+/*! The number of submissions that created and enqueued a new operation. */
+@property (nonatomic, assign, readonly) NSUInteger executionCount;
+
+/*! The number of submissions that were attached to an operation that was already pending or executing. */
+@property (nonatomic, assign, readonly) NSUInteger coalescedCount;
+
+/*! The number of submissions that were satisfied using a cached result. */
+@property (nonatomic, assign, readonly) NSUInteger cacheHitCount;
+
+/*!
+ @abstract Initializes a newly created coalescer that executes its operations on a new operation queue.
+ @result An initialized coalescer.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created coalescer that executes its operations on the specified queue.
+ @param operationQueue The operation queue on which operations execute. May not be nil.
+ @result An initialized coalescer.
+ */
+- (instancetype)initWithOperationQueue:(NSOperationQueue *)operationQueue NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Submits work for the specified key, coalescing it with any pending or executing operation for that key.
+ @discussion If the key has a cached result, the result block is invoked immediately on the calling thread and nil is
+     returned. If the key already has a pending or executing operation, the result block is attached to it, the work 
+     block is ignored, and the existing operation is returned. Otherwise, a new operation that executes the work block 
+     is created, enqueued, and returned.
+ 
+     Result blocks are invoked on the thread that produces the result.
+ @param key The key identifying the work. May not be nil.
+ @param workBlock The block that performs the work if no operation for the key is pending or executing. May not be nil.
+ @param resultBlock The block to invoke with the result of the work. May not be nil.
+ @result The operation performing the work for the key, or nil if a cached result was used.
+ */
+- (nullable TWTAsynchronousOperation *)submitOperationForKey:(id<NSCopying>)key
+                                                   workBlock:(TWTOperationCoalescerWorkBlock)workBlock
+                                                 resultBlock:(TWTOperationCoalescerResultBlock)resultBlock;
+
+/*!
+ @abstract Removes all cached results.
+ */
+- (void)removeAllCachedResults;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,294 @@
+//
+//  TWTOperationCoalescer.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTOperationCoalescer.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+
+
+NSString *const kTWTOperationCoalescerErrorDomain = @"TWTOperationCoalescerErrorDomain";
+
+
+#pragma mark Entries
+
+/*!
+ TWTOperationCoalescerEntry tracks the pending or executing operation for a single key and the result blocks that are
+ attached to it. Its mutable state is guarded by the coalescer’s lock.
+ */
+@interface TWTOperationCoalescerEntry : NSObject {
+@public
+    TWTAsynchronousOperation *_operation;
+    NSMutableArray<TWTOperationCoalescerResultBlock> *_resultBlocks;
+    BOOL _finished;
+}
+
+@end
+
+
+@implementation TWTOperationCoalescerEntry
+@end
+
+
+/*!
+ TWTOperationCoalescerCachedResult holds a successful result, the key it was cached for, and the system uptime at 
+ which it expires.
+ */
+@interface TWTOperationCoalescerCachedResult : NSObject {
+@public
+    id<NSCopying> _key;
+    id _result;
+    NSTimeInterval _expirationTime;
+}
+
+@end
+
+
+@implementation TWTOperationCoalescerCachedResult
+@end
+
+
+#pragma mark -
+
+@implementation TWTOperationCoalescer {
+    pthread_mutex_t _lock;
+    NSMutableDictionary<id<NSCopying>, TWTOperationCoalescerEntry *> *_entries;
+    NSMutableDictionary<id<NSCopying>, TWTOperationCoalescerCachedResult *> *_cachedResults;
+
+    // Every cached result in the order it was cached, which is also the order in which they expire unless the cache
+    // duration changes. This may include results that were since replaced or removed from _cachedResults
+    NSMutableArray<TWTOperationCoalescerCachedResult *> *_cachedResultExpirationQueue;
+
+    _Atomic(NSUInteger) _submissionCount;
+    _Atomic(NSUInteger) _executionCount;
+    _Atomic(NSUInteger) _coalescedCount;
+    _Atomic(NSUInteger) _cacheHitCount;
+}
+
+- (instancetype)init
+{
+    return [self initWithOperationQueue:[[NSOperationQueue alloc] init]];
+}
+
+
+- (instancetype)initWithOperationQueue:(NSOperationQueue *)operationQueue
+{
+    NSParameterAssert(operationQueue);
+
+    self = [super init];
+    if (self) {
+        _operationQueue = operationQueue;
+        pthread_mutex_init(&_lock, NULL);
+        _entries = [[NSMutableDictionary alloc] init];
+        _cachedResults = [[NSMutableDictionary alloc] init];
+        _cachedResultExpirationQueue = [[NSMutableArray alloc] init];
+        atomic_init(&_submissionCount, 0);
+        atomic_init(&_executionCount, 0);
+        atomic_init(&_coalescedCount, 0);
+        atomic_init(&_cacheHitCount, 0);
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_lock);
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p submissionCount=%lu executionCount=%lu coalescedCount=%lu cacheHitCount=%lu>",
+            self.class, self, (unsigned long)self.submissionCount, (unsigned long)self.executionCount,
+            (unsigned long)self.coalescedCount, (unsigned long)self.cacheHitCount];
+}
+
+
+#pragma mark Counters
+
+- (NSUInteger)submissionCount
+{
+    return atomic_load(&_submissionCount);
+}
+
+
+- (NSUInteger)executionCount
+{
+    return atomic_load(&_executionCount);
+}
+
+
+- (NSUInteger)coalescedCount
+{
+    return atomic_load(&_coalescedCount);
+}
+
+
+- (NSUInteger)cacheHitCount
+{
+    return atomic_load(&_cacheHitCount);
+}
+
+
+#pragma mark Submission
+
+- (TWTAsynchronousOperation *)submitOperationForKey:(id<NSCopying>)key
+                                          workBlock:(TWTOperationCoalescerWorkBlock)workBlock
+                                        resultBlock:(TWTOperationCoalescerResultBlock)resultBlock
+{
+    NSParameterAssert(key);
+    NSParameterAssert(workBlock);
+    NSParameterAssert(resultBlock);
+
+    atomic_fetch_add_explicit(&_submissionCount, 1, memory_order_relaxed);
+
+    pthread_mutex_lock(&_lock);
+
+    // Use a cached result if there’s one that hasn’t expired
+    TWTOperationCoalescerCachedResult *cachedResult = _cachedResults[key];
+    if (cachedResult) {
+        if (cachedResult->_expirationTime > [[NSProcessInfo processInfo] systemUptime]) {
+            pthread_mutex_unlock(&_lock);
+            atomic_fetch_add_explicit(&_cacheHitCount, 1, memory_order_relaxed);
+            resultBlock(cachedResult->_result, nil);
+            return nil;
+        }
+
+        [_cachedResults removeObjectForKey:key];
+    }
+
+    // Attach to an existing operation if there is one
+    TWTOperationCoalescerEntry *entry = _entries[key];
+    if (entry) {
+        [entry->_resultBlocks addObject:[resultBlock copy]];
+        TWTAsynchronousOperation *operation = entry->_operation;
+        pthread_mutex_unlock(&_lock);
+
+        atomic_fetch_add_explicit(&_coalescedCount, 1, memory_order_relaxed);
+        return operation;
+    }
+
+    entry = [[TWTOperationCoalescerEntry alloc] init];
+    entry->_resultBlocks = [[NSMutableArray alloc] initWithObjects:[resultBlock copy], nil];
+    entry->_operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        workBlock(operation, ^(id result, NSError *error) {
+            [self finishEntry:entry forKey:key result:result error:error];
+        });
+    }];
+
+    _entries[key] = entry;
+    pthread_mutex_unlock(&_lock);
+
+    // If the operation finishes without the work block producing a result, e.g., because it was cancelled before it
+    // started, make sure the key is released and that no one waits forever
+    [entry->_operation addFinishHandler:^(TWTAsynchronousOperation *operation) {
+        NSError *error = [NSError errorWithDomain:kTWTOperationCoalescerErrorDomain code:TWTOperationCoalescerErrorNoResult userInfo:nil];
+        [self finishEntry:entry forKey:key result:nil error:error];
+    }];
+
+    atomic_fetch_add_explicit(&_executionCount, 1, memory_order_relaxed);
+    [self.operationQueue addOperation:entry->_operation];
+    return entry->_operation;
+}
+
+
+- (void)finishEntry:(TWTOperationCoalescerEntry *)entry forKey:(id<NSCopying>)key result:(id)result error:(NSError *)error
+{
+    pthread_mutex_lock(&_lock);
+    if (entry->_finished) {
+        pthread_mutex_unlock(&_lock);
+        return;
+    }
+
+    entry->_finished = YES;
+    if (_entries[key] == entry) {
+        [_entries removeObjectForKey:key];
+    }
+
+    NSArray<TWTOperationCoalescerResultBlock> *resultBlocks = entry->_resultBlocks;
+    entry->_resultBlocks = nil;
+
+    NSTimeInterval resultCacheDuration = self.resultCacheDuration;
+    if (!error && resultCacheDuration > 0) {
+        NSTimeInterval now = [[NSProcessInfo processInfo] systemUptime];
+        [self removeCachedResultsExpiredBefore:now];
+
+        TWTOperationCoalescerCachedResult *cachedResult = [[TWTOperationCoalescerCachedResult alloc] init];
+        cachedResult->_key = key;
+        cachedResult->_result = result;
+        cachedResult->_expirationTime = now + resultCacheDuration;
+        _cachedResults[key] = cachedResult;
+        [_cachedResultExpirationQueue addObject:cachedResult];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    for (TWTOperationCoalescerResultBlock resultBlock in resultBlocks) {
+        resultBlock(result, error);
+    }
+
+    [entry->_operation finishOperationExecution];
+}
+
+
+#pragma mark Cached Results
+
+// Must be called with the lock held. This only pops expired results off the head of the expiration queue, so it takes
+// amortized constant time. If the cache duration was shortened, results behind a later-expiring one are not removed 
+// until that one expires, but expired results are never returned, as lookups check expiration themselves
+- (void)removeCachedResultsExpiredBefore:(NSTimeInterval)time
+{
+    NSUInteger expiredCount = 0;
+    NSUInteger queueCount = _cachedResultExpirationQueue.count;
+    while (expiredCount < queueCount) {
+        TWTOperationCoalescerCachedResult *cachedResult = _cachedResultExpirationQueue[expiredCount];
+        if (cachedResult->_expirationTime > time) {
+            break;
+        }
+
+        // The key may have been cached again since, in which case the newer result stays
+        if (_cachedResults[cachedResult->_key] == cachedResult) {
+            [_cachedResults removeObjectForKey:cachedResult->_key];
+        }
+
+        ++expiredCount;
+    }
+
+    if (expiredCount > 0) {
+        [_cachedResultExpirationQueue removeObjectsInRange:NSMakeRange(0, expiredCount)];
+    }
+}
+
+
+- (void)removeAllCachedResults
+{
+    pthread_mutex_lock(&_lock);
+    [_cachedResults removeAllObjects];
+    [_cachedResultExpirationQueue removeAllObjects];
+    pthread_mutex_unlock(&_lock);
+}
+
+@end
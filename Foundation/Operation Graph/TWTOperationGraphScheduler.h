@@ -0,0 +1,144 @@
+//
+//  TWTOperationGraphScheduler.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTAsynchronousOperation.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ The error domain for errors generated by TWTOperationGraphScheduler.
+ */
+extern NSString *const kTWTOperationGraphErrorDomain;
+
+typedef NS_ENUM(NSInteger, TWTOperationGraphError) {
+    /*!
+     This error is generated if the dependencies between the graph’s operations contain a cycle. The userInfo
+     dictionary will contain an object for the key kTWTOperationGraphErrorOperationsKey containing the operations 
+     that are part of or depend on the cycle.
+     */
+    TWTOperationGraphErrorCycle,
+
+    /*!
+     This error is generated if an operation in the graph depends on an unfinished operation that is not part of the
+     graph. The userInfo dictionary will contain an object for the key kTWTOperationGraphErrorOperationsKey containing
+     the unfinished dependencies.
+     */
+    TWTOperationGraphErrorUnfinishedExternalDependency
+};
+
+/*!
+ The value for this userInfo key is an array of the operations that caused the error.
+ */
+extern NSString *const kTWTOperationGraphErrorOperationsKey;
+
+
+/*!
+ @abstract Type for blocks that return the estimated cost of an operation.
+ @param operation The operation whose cost is being estimated.
+ @result The operation’s estimated cost, typically in seconds. Negative values indicate that there is no estimate, in
+     which case the scheduler’s measured history is used.
+ */
+typedef NSTimeInterval (^TWTOperationGraphCostBlock)(NSOperation *operation);
+
+
+/*!
+ TWTOperationGraphSchedulers execute a whole directed acyclic graph of operations, using the operations’ dependencies
+ as the graph’s edges. Before anything executes, the scheduler checks the graph for cycles and computes each 
+ operation’s rank: its own cost plus the cost of the longest chain of operations that depend on it. Whenever a 
+ concurrency slot is free, the ready operation with the highest rank is started, so the graph’s critical path is never
+ left waiting behind operations that have plenty of slack. This typically shortens the time it takes to execute the 
+ entire graph compared to NSOperationQueue’s FIFO and priority-based scheduling.
+ 
+ Each operation’s cost is determined, in order of preference, by the scheduler’s cost block, the average measured 
+ execution time of previous operations with the same name, and finally a default cost of one second, which makes the
+ critical path the longest chain of operations.
+ */
+@interface TWTOperationGraphScheduler : NSObject
+
+/*! The maximum number of the graph’s operations that may execute concurrently. */
+@property (nonatomic, assign, readonly) NSUInteger maximumConcurrentOperationCount;
+
+/*! 
+ A block that returns the estimated cost of an operation. If nil or if the block returns a negative value, measured
+ history is used instead.
+ */
+@property (nonatomic, copy, nullable) TWTOperationGraphCostBlock costBlock;
+
+/*!
+ @abstract The measured average execution times, in seconds, of previously executed operations keyed by operation name.
+ @discussion Only named operations are measured.
+ */
+@property (nonatomic, copy, readonly) NSDictionary<NSString *, NSNumber *> *measuredCosts;
+
+/*!
+ @abstract Initializes a newly created scheduler that executes up to one operation per active processor at a time.
+ @result An initialized scheduler.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created scheduler with the specified maximum concurrent operation count.
+ @param maximumConcurrentOperationCount The maximum number of operations that may execute concurrently. Must be
+     positive.
+ @result An initialized scheduler.
+ */
+- (instancetype)initWithMaximumConcurrentOperationCount:(NSUInteger)maximumConcurrentOperationCount NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Validates that the specified operations form a directed acyclic graph that can be executed.
+ @param operations The operations in the graph.
+ @param error An out error. This parameter may be NULL.
+ @result Whether the graph can be executed.
+ */
+- (BOOL)validateOperations:(NSArray<NSOperation *> *)operations error:(NSError *__autoreleasing *)error;
+
+/*!
+ @abstract Validates and asynchronously executes the specified graph of operations.
+ @discussion Operations are started on global dispatch queues. If validation fails, no operations are started and the
+     completion block is not invoked. Operations should not be added to any other queue or executor.
+ @param operations The operations in the graph.
+ @param completion A block to invoke on an arbitrary queue once every operation in the graph has finished. May be nil.
+ @param error An out error. This parameter may be NULL.
+ @result Whether the graph was valid and execution started.
+ */
+- (BOOL)executeOperations:(NSArray<NSOperation *> *)operations
+               completion:(nullable void (^)(void))completion
+                    error:(NSError *__autoreleasing *)error;
+
+/*!
+ @abstract Validates and executes the specified graph of operations, blocking until every operation has finished.
+ @param operations The operations in the graph.
+ @param error An out error. This parameter may be NULL.
+ @result Whether the graph was valid and executed.
+ */
+- (BOOL)executeOperationsAndWait:(NSArray<NSOperation *> *)operations error:(NSError *__autoreleasing *)error;
+
+@end
+
+NS_ASSUME_NONNULL_END
@@ -0,0 +1,500 @@
+//
+//  TWTOperationGraphScheduler.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTOperationGraphScheduler.h"
+
+#import <pthread.h>
+
+#import "NSOperation+TWTFinishHandler.h"
+
+
+NSString *const kTWTOperationGraphErrorDomain = @"TWTOperationGraphErrorDomain";
+NSString *const kTWTOperationGraphErrorOperationsKey = @"TWTOperationGraphErrorOperationsKey";
+
+static const NSTimeInterval kTWTOperationGraphDefaultCost = 1.0;
+
+// The weight given to each new measurement when updating an operation’s measured cost
+static const double kTWTOperationGraphMeasuredCostSmoothingFactor = 0.25;
+
+
+#pragma mark Nodes
+
+/*!
+ TWTOperationGraphNodes represent a single operation in a graph along with its scheduling information.
+ */
+@interface TWTOperationGraphNode : NSObject {
+@public
+    NSOperation *_operation;
+    NSUInteger _index;
+    NSTimeInterval _cost;
+    NSTimeInterval _rank;
+    NSMutableArray<TWTOperationGraphNode *> *_successors;
+    NSUInteger _predecessorCount;
+    NSUInteger _unfinishedPredecessorCount;
+    NSTimeInterval _startTime;
+}
+
+@end
+
+
+@implementation TWTOperationGraphNode
+@end
+
+
+/*!
+ Returns whether node1 should be started before node2: nodes with higher rank come first, and ties are broken by the
+ order in which the operations were given to the scheduler.
+ */
+static inline BOOL TWTOperationGraphNodePrecedes(TWTOperationGraphNode *node1, TWTOperationGraphNode *node2)
+{
+    return node1->_rank > node2->_rank || (node1->_rank == node2->_rank && node1->_index < node2->_index);
+}
+
+
+static void TWTOperationGraphHeapPush(NSMutableArray<TWTOperationGraphNode *> *heap, TWTOperationGraphNode *node)
+{
+    [heap addObject:node];
+
+    NSUInteger index = heap.count - 1;
+    while (index > 0) {
+        NSUInteger parentIndex = (index - 1) / 2;
+        if (!TWTOperationGraphNodePrecedes(heap[index], heap[parentIndex])) {
+            break;
+        }
+
+        [heap exchangeObjectAtIndex:index withObjectAtIndex:parentIndex];
+        index = parentIndex;
+    }
+}
+
+
+static TWTOperationGraphNode *TWTOperationGraphHeapPop(NSMutableArray<TWTOperationGraphNode *> *heap)
+{
+    TWTOperationGraphNode *top = heap.firstObject;
+    [heap exchangeObjectAtIndex:0 withObjectAtIndex:heap.count - 1];
+    [heap removeLastObject];
+
+    NSUInteger count = heap.count;
+    NSUInteger index = 0;
+    while (YES) {
+        NSUInteger leftIndex = 2 * index + 1;
+        NSUInteger rightIndex = leftIndex + 1;
+        NSUInteger firstIndex = index;
+
+        if (leftIndex < count && TWTOperationGraphNodePrecedes(heap[leftIndex], heap[firstIndex])) {
+            firstIndex = leftIndex;
+        }
+
+        if (rightIndex < count && TWTOperationGraphNodePrecedes(heap[rightIndex], heap[firstIndex])) {
+            firstIndex = rightIndex;
+        }
+
+        if (firstIndex == index) {
+            break;
+        }
+
+        [heap exchangeObjectAtIndex:index withObjectAtIndex:firstIndex];
+        index = firstIndex;
+    }
+
+    return top;
+}
+
+
+#pragma mark - Executions
+
+@interface TWTOperationGraphScheduler ()
+
+- (void)recordMeasuredCost:(NSTimeInterval)cost forOperation:(NSOperation *)operation;
+
+@end
+
+
+/*!
+ TWTOperationGraphExecutions hold the state for a single execution of a graph. Ready nodes are kept in a heap ordered
+ by rank and are started as concurrency slots become available.
+ */
+@interface TWTOperationGraphExecution : NSObject {
+    TWTOperationGraphScheduler *_scheduler;
+    NSUInteger _maximumConcurrentOperationCount;
+    void (^_completion)(void);
+
+    pthread_mutex_t _lock;
+    NSMutableArray<TWTOperationGraphNode *> *_readyNodes;
+    NSUInteger _executingNodeCount;
+    NSUInteger _unfinishedNodeCount;
+}
+
+- (instancetype)initWithScheduler:(TWTOperationGraphScheduler *)scheduler
+                            nodes:(NSArray<TWTOperationGraphNode *> *)nodes
+                       completion:(void (^)(void))completion;
+- (void)start;
+
+@end
+
+
+@implementation TWTOperationGraphExecution
+
+- (instancetype)initWithScheduler:(TWTOperationGraphScheduler *)scheduler
+                            nodes:(NSArray<TWTOperationGraphNode *> *)nodes
+                       completion:(void (^)(void))completion
+{
+    self = [super init];
+    if (self) {
+        _scheduler = scheduler;
+        _maximumConcurrentOperationCount = scheduler.maximumConcurrentOperationCount;
+        _completion = [completion copy];
+        pthread_mutex_init(&_lock, NULL);
+
+        _readyNodes = [[NSMutableArray alloc] init];
+        for (TWTOperationGraphNode *node in nodes) {
+            node->_unfinishedPredecessorCount = node->_predecessorCount;
+            if (node->_unfinishedPredecessorCount == 0) {
+                TWTOperationGraphHeapPush(_readyNodes, node);
+            }
+        }
+
+        _unfinishedNodeCount = nodes.count;
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_lock);
+}
+
+
+- (void)start
+{
+    if (_unfinishedNodeCount == 0) {
+        [self finish];
+        return;
+    }
+
+    [self startReadyNodes];
+}
+
+
+- (void)startReadyNodes
+{
+    NSMutableArray<TWTOperationGraphNode *> *nodesToStart = nil;
+
+    pthread_mutex_lock(&_lock);
+    while (_executingNodeCount < _maximumConcurrentOperationCount && _readyNodes.count > 0) {
+        if (!nodesToStart) {
+            nodesToStart = [[NSMutableArray alloc] init];
+        }
+
+        [nodesToStart addObject:TWTOperationGraphHeapPop(_readyNodes)];
+        ++_executingNodeCount;
+    }
+    pthread_mutex_unlock(&_lock);
+
+    for (TWTOperationGraphNode *node in nodesToStart) {
+        [self startNode:node];
+    }
+}
+
+
+- (void)startNode:(TWTOperationGraphNode *)node
+{
+    NSOperation *operation = node->_operation;
+    BOOL supportsFinishHandlers = [operation isKindOfClass:[TWTAsynchronousOperation class]];
+    if (supportsFinishHandlers) {
+        [operation twt_addFinishHandler:^(NSOperation *finishedOperation) {
+            [self nodeDidFinish:node];
+        }];
+    }
+
+    dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+        node->_startTime = [[NSProcessInfo processInfo] systemUptime];
+        [operation start];
+
+        // Synchronous operations are finished as soon as -start returns, so we only need to observe the others
+        if (!supportsFinishHandlers) {
+            if (operation.isFinished) {
+                [self nodeDidFinish:node];
+            } else {
+                [operation twt_addFinishHandler:^(NSOperation *finishedOperation) {
+                    [self nodeDidFinish:node];
+                }];
+            }
+        }
+    });
+}
+
+
+- (void)nodeDidFinish:(TWTOperationGraphNode *)node
+{
+    // Operations that were cancelled or had already finished never really executed, so don’t measure them
+    if (!node->_operation.isCancelled && node->_startTime > 0) {
+        [_scheduler recordMeasuredCost:[[NSProcessInfo processInfo] systemUptime] - node->_startTime forOperation:node->_operation];
+    }
+
+    pthread_mutex_lock(&_lock);
+    --_executingNodeCount;
+    NSUInteger unfinishedNodeCount = --_unfinishedNodeCount;
+    for (TWTOperationGraphNode *successor in node->_successors) {
+        if (--successor->_unfinishedPredecessorCount == 0) {
+            TWTOperationGraphHeapPush(_readyNodes, successor);
+        }
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (unfinishedNodeCount == 0) {
+        [self finish];
+    } else {
+        [self startReadyNodes];
+    }
+}
+
+
+- (void)finish
+{
+    if (_completion) {
+        _completion();
+    }
+}
+
+@end
+
+
+#pragma mark - Scheduler
+
+@implementation TWTOperationGraphScheduler {
+    pthread_mutex_t _measuredCostsLock;
+    NSMutableDictionary<NSString *, NSNumber *> *_measuredCosts;
+}
+
+- (instancetype)init
+{
+    return [self initWithMaximumConcurrentOperationCount:[[NSProcessInfo processInfo] activeProcessorCount]];
+}
+
+
+- (instancetype)initWithMaximumConcurrentOperationCount:(NSUInteger)maximumConcurrentOperationCount
+{
+    NSParameterAssert(maximumConcurrentOperationCount > 0);
+
+    self = [super init];
+    if (self) {
+        _maximumConcurrentOperationCount = maximumConcurrentOperationCount;
+        pthread_mutex_init(&_measuredCostsLock, NULL);
+        _measuredCosts = [[NSMutableDictionary alloc] init];
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_measuredCostsLock);
+}
+
+
+#pragma mark Measured Costs
+
+- (NSDictionary<NSString *, NSNumber *> *)measuredCosts
+{
+    pthread_mutex_lock(&_measuredCostsLock);
+    NSDictionary *measuredCosts = [_measuredCosts copy];
+    pthread_mutex_unlock(&_measuredCostsLock);
+    return measuredCosts;
+}
+
+
+- (void)recordMeasuredCost:(NSTimeInterval)cost forOperation:(NSOperation *)operation
+{
+    NSString *name = operation.name;
+    if (!name) {
+        return;
+    }
+
+    pthread_mutex_lock(&_measuredCostsLock);
+    NSNumber *previousCost = _measuredCosts[name];
+    if (previousCost) {
+        cost = previousCost.doubleValue + kTWTOperationGraphMeasuredCostSmoothingFactor * (cost - previousCost.doubleValue);
+    }
+
+    _measuredCosts[name] = @(cost);
+    pthread_mutex_unlock(&_measuredCostsLock);
+}
+
+
+- (NSTimeInterval)costForOperation:(NSOperation *)operation measuredCosts:(NSDictionary<NSString *, NSNumber *> *)measuredCosts
+{
+    TWTOperationGraphCostBlock costBlock = self.costBlock;
+    if (costBlock) {
+        NSTimeInterval cost = costBlock(operation);
+        if (cost >= 0) {
+            return cost;
+        }
+    }
+
+    NSNumber *measuredCost = operation.name ? measuredCosts[operation.name] : nil;
+    return measuredCost ? measuredCost.doubleValue : kTWTOperationGraphDefaultCost;
+}
+
+
+#pragma mark Graph Construction
+
+/*!
+ Builds the graph’s nodes, checks that it is acyclic and has no unfinished external dependencies, and computes each
+ node’s rank. Returns nil and sets the error parameter if the graph is invalid.
+ */
+- (NSArray<TWTOperationGraphNode *> *)nodesForOperations:(NSArray<NSOperation *> *)operations error:(NSError *__autoreleasing *)error
+{
+    NSParameterAssert(operations);
+
+    NSDictionary *measuredCosts = self.measuredCosts;
+    NSMapTable<NSOperation *, TWTOperationGraphNode *> *nodesByOperation = [NSMapTable mapTableWithKeyOptions:NSPointerFunctionsObjectPointerPersonality
+                                                                                                  valueOptions:NSPointerFunctionsStrongMemory];
+    NSMutableArray<TWTOperationGraphNode *> *nodes = [[NSMutableArray alloc] initWithCapacity:operations.count];
+
+    for (NSOperation *operation in operations) {
+        if ([nodesByOperation objectForKey:operation]) {
+            continue;
+        }
+
+        TWTOperationGraphNode *node = [[TWTOperationGraphNode alloc] init];
+        node->_operation = operation;
+        node->_index = nodes.count;
+        node->_cost = [self costForOperation:operation measuredCosts:measuredCosts];
+        node->_successors = [[NSMutableArray alloc] init];
+        [nodesByOperation setObject:node forKey:operation];
+        [nodes addObject:node];
+    }
+
+    // Connect the nodes, making sure every dependency outside the graph has already finished
+    NSMutableArray<NSOperation *> *unfinishedExternalDependencies = [[NSMutableArray alloc] init];
+    for (TWTOperationGraphNode *node in nodes) {
+        for (NSOperation *dependency in node->_operation.dependencies) {
+            TWTOperationGraphNode *predecessor = [nodesByOperation objectForKey:dependency];
+            if (predecessor) {
+                [predecessor->_successors addObject:node];
+                ++node->_predecessorCount;
+            } else if (!dependency.isFinished) {
+                [unfinishedExternalDependencies addObject:dependency];
+            }
+        }
+    }
+
+    if (unfinishedExternalDependencies.count > 0) {
+        if (error) {
+            *error = [NSError errorWithDomain:kTWTOperationGraphErrorDomain
+                                         code:TWTOperationGraphErrorUnfinishedExternalDependency
+                                     userInfo:@{ kTWTOperationGraphErrorOperationsKey : [unfinishedExternalDependencies copy] }];
+        }
+
+        return nil;
+    }
+
+    // Topologically sort the nodes using Kahn’s algorithm. Any nodes that can’t be sorted are part of or depend on a cycle.
+    NSMutableArray<TWTOperationGraphNode *> *sortedNodes = [[NSMutableArray alloc] initWithCapacity:nodes.count];
+    for (TWTOperationGraphNode *node in nodes) {
+        node->_unfinishedPredecessorCount = node->_predecessorCount;
+        if (node->_unfinishedPredecessorCount == 0) {
+            [sortedNodes addObject:node];
+        }
+    }
+
+    for (NSUInteger i = 0; i < sortedNodes.count; ++i) {
+        for (TWTOperationGraphNode *successor in sortedNodes[i]->_successors) {
+            if (--successor->_unfinishedPredecessorCount == 0) {
+                [sortedNodes addObject:successor];
+            }
+        }
+    }
+
+    if (sortedNodes.count < nodes.count) {
+        if (error) {
+            NSMutableArray<NSOperation *> *cyclicOperations = [[NSMutableArray alloc] init];
+            for (TWTOperationGraphNode *node in nodes) {
+                if (node->_unfinishedPredecessorCount > 0) {
+                    [cyclicOperations addObject:node->_operation];
+                }
+            }
+
+            *error = [NSError errorWithDomain:kTWTOperationGraphErrorDomain
+                                         code:TWTOperationGraphErrorCycle
+                                     userInfo:@{ kTWTOperationGraphErrorOperationsKey : cyclicOperations }];
+        }
+
+        return nil;
+    }
+
+    // Compute ranks in reverse topological order so that every successor’s rank is known before its predecessors’
+    for (TWTOperationGraphNode *node in [sortedNodes reverseObjectEnumerator]) {
+        NSTimeInterval maximumSuccessorRank = 0;
+        for (TWTOperationGraphNode *successor in node->_successors) {
+            maximumSuccessorRank = MAX(maximumSuccessorRank, successor->_rank);
+        }
+
+        node->_rank = node->_cost + maximumSuccessorRank;
+    }
+
+    return nodes;
+}
+
+
+#pragma mark Execution
+
+- (BOOL)validateOperations:(NSArray<NSOperation *> *)operations error:(NSError *__autoreleasing *)error
+{
+    return [self nodesForOperations:operations error:error] != nil;
+}
+
+
+- (BOOL)executeOperations:(NSArray<NSOperation *> *)operations completion:(void (^)(void))completion error:(NSError *__autoreleasing *)error
+{
+    NSArray<TWTOperationGraphNode *> *nodes = [self nodesForOperations:operations error:error];
+    if (!nodes) {
+        return NO;
+    }
+
+    [[[TWTOperationGraphExecution alloc] initWithScheduler:self nodes:nodes completion:completion] start];
+    return YES;
+}
+
+
+- (BOOL)executeOperationsAndWait:(NSArray<NSOperation *> *)operations error:(NSError *__autoreleasing *)error
+{
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    BOOL started = [self executeOperations:operations completion:^{
+        dispatch_semaphore_signal(semaphore);
+    } error:error];
+
+    if (!started) {
+        return NO;
+    }
+
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    return YES;
+}
+
+@end
@@ -0,0 +1,111 @@
+//
+//  TWTWorkStealingExecutor.h
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import <Foundation/Foundation.h>
+
+#import "TWTAsynchronousOperation.h"
+#import "TWTAsynchronousOperationPool.h"
+
+
+NS_ASSUME_NONNULL_BEGIN
+
+/*!
+ TWTWorkStealingExecutors run operations on a fixed pool of worker threads, each of which has its own double-ended
+ queue of work. Workers push and pop work at the bottom of their own deque and, when they run out, steal work from the
+ top of another worker’s deque. Operations submitted from a worker thread (e.g., from inside another operation’s block)
+ are pushed onto that worker’s deque, so fan-out work stays local until some other worker goes idle.
+ 
+ Unlike NSOperationQueue, the executor has no central lock and does not use KVO to determine readiness. Dependencies
+ between operations submitted to the same executor are tracked directly by the executor, and finished 
+ TWTAsynchronousOperations report their completion through finish handlers. Dependencies on operations outside the
+ executor are also honored, though operations other than TWTAsynchronousOperations are observed using KVO.
+ 
+ Cancelled operations are still started once their dependencies finish, which moves them directly to the finished
+ state without executing their work.
+ 
+ The executor also runs TWTAsynchronousTasks, which it starts directly without any per-submission bookkeeping. 
+ Together with a TWTAsynchronousOperationPool, this allows submitting short tasks without allocating.
+ */
+@interface TWTWorkStealingExecutor : NSObject
+
+/*! The number of worker threads the executor uses. */
+@property (nonatomic, assign, readonly) NSUInteger workerCount;
+
+/*!
+ @abstract Initializes a newly created executor with one worker per active processor.
+ @result An initialized executor.
+ */
+- (instancetype)init;
+
+/*!
+ @abstract Initializes a newly created executor with the specified number of workers.
+ @param workerCount The number of worker threads to use. Must be positive.
+ @result An initialized executor.
+ */
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount NS_DESIGNATED_INITIALIZER;
+
+/*!
+ @abstract Creates a TWTAsynchronousOperation with the specified block and submits it for execution.
+ @discussion The returned operation may be used as a dependency of subsequently submitted operations. As with any
+     TWTAsynchronousOperation, the block must eventually invoke ‑finishOperationExecution on its operation.
+ @param block The operation block to execute. May not be nil.
+ @result The submitted operation.
+ */
+- (TWTAsynchronousOperation *)addOperationWithBlock:(TWTAsynchronousOperationBlock)block;
+
+/*!
+ @abstract Submits the specified operation for execution.
+ @discussion The operation is started on a worker thread once all of its dependencies have finished. An operation
+     should only be submitted once, and should not also be added to an NSOperationQueue.
+ @param operation The operation to execute. May not be nil.
+ */
+- (void)addOperation:(NSOperation *)operation;
+
+/*!
+ @abstract Submits the specified task for execution.
+ @discussion The task is started on a worker thread. A task should only be submitted once, and should not also be 
+     started with ‑start. Once submitted, the task is returned to its pool as soon as it finishes, so it should not be
+     referenced again by the submitter.
+ @param task The task to execute. May not be nil.
+ */
+- (void)addTask:(TWTAsynchronousTask *)task;
+
+/*!
+ @abstract Submits the specified operations for execution, optionally waiting for them to finish.
+ @param operations The operations to execute. May not be nil.
+ @param wait Whether to block the calling thread until every operation in the executor has finished.
+ */
+- (void)addOperations:(NSArray<NSOperation *> *)operations waitUntilFinished:(BOOL)wait;
+
+/*!
+ @abstract Blocks the calling thread until every operation submitted to the executor has finished.
+ @discussion This must not be invoked from one of the executor’s worker threads.
+ */
+- (void)waitUntilAllOperationsAreFinished;
+
+@end
+
+NS_ASSUME_NONNULL_END
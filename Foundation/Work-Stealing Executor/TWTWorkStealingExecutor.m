@@ -0,0 +1,481 @@
+//
+//  TWTWorkStealingExecutor.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTWorkStealingExecutor.h"
+
+#import <pthread.h>
+#import <stdatomic.h>
+#import <stdlib.h>
+
+#import "NSOperation+TWTFinishHandler.h"
+#import "TWTAsynchronousOperationPool+Private.h"
+
+
+#pragma mark Pending Operations
+
+/*!
+ TWTWorkStealingPendingOperation counts the unfinished dependencies of an operation that has been submitted to an
+ executor. The count starts at one so that the operation can’t be scheduled while its dependencies are still being
+ registered.
+ */
+@interface TWTWorkStealingPendingOperation : NSObject {
+@public
+    NSOperation *_operation;
+    _Atomic(NSInteger) _unfinishedDependencyCount;
+}
+
+@end
+
+
+@implementation TWTWorkStealingPendingOperation
+@end
+
+
+#pragma mark - Workers
+
+/*!
+ TWTWorkStealingWorkers hold a deque of ready work, which consists of NSOperations and TWTAsynchronousTasks. The owning worker thread pushes and pops operations at the 
+ bottom of the deque, while other workers steal from the top. Each deque has its own lock, so the only contention is
+ between a worker and the occasional thief.
+ */
+@interface TWTWorkStealingWorker : NSObject {
+@public
+    __unsafe_unretained id _scheduler;
+    NSUInteger _index;
+    pthread_mutex_t _lock;
+    NSMutableArray *_deque;
+}
+
+- (void)pushOperation:(id)operation;
+- (nullable id)popOperation;
+- (nullable id)stealOperation;
+
+@end
+
+
+@implementation TWTWorkStealingWorker
+
+- (instancetype)init
+{
+    self = [super init];
+    if (self) {
+        pthread_mutex_init(&_lock, NULL);
+        _deque = [[NSMutableArray alloc] init];
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_mutex_destroy(&_lock);
+}
+
+
+- (void)pushOperation:(id)operation
+{
+    pthread_mutex_lock(&_lock);
+    [_deque addObject:operation];
+    pthread_mutex_unlock(&_lock);
+}
+
+
+- (id)popOperation
+{
+    pthread_mutex_lock(&_lock);
+    id operation = [_deque lastObject];
+    if (operation) {
+        [_deque removeLastObject];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    return operation;
+}
+
+
+- (id)stealOperation
+{
+    // Rather than waiting on a contended deque, let the thief move on to its next victim
+    if (pthread_mutex_trylock(&_lock) != 0) {
+        return nil;
+    }
+
+    id operation = [_deque firstObject];
+    if (operation) {
+        [_deque removeObjectAtIndex:0];
+    }
+    pthread_mutex_unlock(&_lock);
+
+    return operation;
+}
+
+@end
+
+
+#pragma mark - Scheduler
+
+/*!
+ TWTWorkStealingScheduler does the actual work of a TWTWorkStealingExecutor. It is a separate object so that the
+ executor’s worker threads, which retain the scheduler, do not keep the executor itself alive.
+ */
+@interface TWTWorkStealingScheduler : NSObject {
+    NSArray<TWTWorkStealingWorker *> *_workers;
+    dispatch_group_t _outstandingOperationGroup;
+
+    // Used to put idle workers to sleep and wake them up when work arrives
+    pthread_mutex_t _idleLock;
+    pthread_cond_t _idleCondition;
+    _Atomic(NSInteger) _idleWorkerCount;
+    _Atomic(NSInteger) _queuedOperationCount;
+    _Atomic(NSUInteger) _nextWorkerIndex;
+    _Atomic(bool) _running;
+}
+
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount;
+- (void)submitOperation:(NSOperation *)operation;
+- (void)submitTask:(TWTAsynchronousTask *)task;
+- (void)waitUntilAllOperationsAreFinished;
+- (void)stop;
+
+@end
+
+
+static pthread_key_t TWTWorkStealingCurrentWorkerKey;
+
+
+@implementation TWTWorkStealingScheduler
+
++ (void)initialize
+{
+    if (self == [TWTWorkStealingScheduler class]) {
+        pthread_key_create(&TWTWorkStealingCurrentWorkerKey, NULL);
+    }
+}
+
+
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount
+{
+    self = [super init];
+    if (self) {
+        _outstandingOperationGroup = dispatch_group_create();
+        pthread_mutex_init(&_idleLock, NULL);
+        pthread_cond_init(&_idleCondition, NULL);
+        atomic_init(&_idleWorkerCount, 0);
+        atomic_init(&_queuedOperationCount, 0);
+        atomic_init(&_nextWorkerIndex, 0);
+        atomic_init(&_running, true);
+
+        NSMutableArray *workers = [[NSMutableArray alloc] initWithCapacity:workerCount];
+        for (NSUInteger i = 0; i < workerCount; ++i) {
+            TWTWorkStealingWorker *worker = [[TWTWorkStealingWorker alloc] init];
+            worker->_scheduler = self;
+            worker->_index = i;
+            [workers addObject:worker];
+        }
+
+        _workers = [workers copy];
+
+        for (TWTWorkStealingWorker *worker in _workers) {
+            NSThread *thread = [[NSThread alloc] initWithTarget:self selector:@selector(runWorker:) object:worker];
+            thread.name = [NSString stringWithFormat:@"%@.%p.%lu", self.class, self, (unsigned long)worker->_index];
+            [thread start];
+        }
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    pthread_cond_destroy(&_idleCondition);
+    pthread_mutex_destroy(&_idleLock);
+}
+
+
+- (void)stop
+{
+    atomic_store(&_running, false);
+
+    pthread_mutex_lock(&_idleLock);
+    pthread_cond_broadcast(&_idleCondition);
+    pthread_mutex_unlock(&_idleLock);
+}
+
+
+- (void)waitUntilAllOperationsAreFinished
+{
+    dispatch_group_wait(_outstandingOperationGroup, DISPATCH_TIME_FOREVER);
+}
+
+
+#pragma mark Submission
+
+- (void)submitOperation:(NSOperation *)operation
+{
+    dispatch_group_enter(_outstandingOperationGroup);
+
+    NSArray<NSOperation *> *dependencies = operation.dependencies;
+    if (dependencies.count == 0) {
+        [self enqueueReadyOperation:operation];
+        return;
+    }
+
+    TWTWorkStealingPendingOperation *pendingOperation = [[TWTWorkStealingPendingOperation alloc] init];
+    pendingOperation->_operation = operation;
+    atomic_init(&pendingOperation->_unfinishedDependencyCount, 1);
+
+    for (NSOperation *dependency in dependencies) {
+        if (dependency.isFinished) {
+            continue;
+        }
+
+        atomic_fetch_add(&pendingOperation->_unfinishedDependencyCount, 1);
+        [dependency twt_addFinishHandler:^(NSOperation *finishedDependency) {
+            [self dependencyDidFinishForPendingOperation:pendingOperation];
+        }];
+    }
+
+    // Release the count we started with
+    [self dependencyDidFinishForPendingOperation:pendingOperation];
+}
+
+
+- (void)submitTask:(TWTAsynchronousTask *)task
+{
+    dispatch_group_enter(_outstandingOperationGroup);
+    [self enqueueReadyOperation:task];
+}
+
+
+- (void)dependencyDidFinishForPendingOperation:(TWTWorkStealingPendingOperation *)pendingOperation
+{
+    if (atomic_fetch_sub(&pendingOperation->_unfinishedDependencyCount, 1) == 1) {
+        [self enqueueReadyOperation:pendingOperation->_operation];
+    }
+}
+
+
+- (void)enqueueReadyOperation:(id)operation
+{
+    // Operations that become ready on one of our workers stay on that worker. All others are distributed round-robin.
+    TWTWorkStealingWorker *worker = (__bridge TWTWorkStealingWorker *)pthread_getspecific(TWTWorkStealingCurrentWorkerKey);
+    if (!worker || worker->_scheduler != self) {
+        worker = _workers[atomic_fetch_add(&_nextWorkerIndex, 1) % _workers.count];
+    }
+
+    [worker pushOperation:operation];
+    atomic_fetch_add(&_queuedOperationCount, 1);
+
+    if (atomic_load(&_idleWorkerCount) > 0) {
+        pthread_mutex_lock(&_idleLock);
+        pthread_cond_signal(&_idleCondition);
+        pthread_mutex_unlock(&_idleLock);
+    }
+}
+
+
+#pragma mark Execution
+
+- (void)runWorker:(TWTWorkStealingWorker *)worker
+{
+    pthread_setspecific(TWTWorkStealingCurrentWorkerKey, (__bridge void *)worker);
+
+    while (YES) {
+        id operation = [worker popOperation];
+        if (!operation) {
+            operation = [self stealOperationForWorker:worker];
+        }
+
+        if (operation) {
+            atomic_fetch_sub(&_queuedOperationCount, 1);
+            @autoreleasepool {
+                [self runOperation:operation];
+            }
+
+            continue;
+        }
+
+        // The queued operation count can briefly go negative when an operation is taken before its submitter has
+        // incremented the count, so we only wait if it’s non-positive
+        pthread_mutex_lock(&_idleLock);
+        atomic_fetch_add(&_idleWorkerCount, 1);
+        while (atomic_load(&_queuedOperationCount) <= 0 && atomic_load(&_running)) {
+            pthread_cond_wait(&_idleCondition, &_idleLock);
+        }
+        atomic_fetch_sub(&_idleWorkerCount, 1);
+        BOOL shouldExit = !atomic_load(&_running) && atomic_load(&_queuedOperationCount) <= 0;
+        pthread_mutex_unlock(&_idleLock);
+
+        if (shouldExit) {
+            break;
+        }
+    }
+
+    pthread_setspecific(TWTWorkStealingCurrentWorkerKey, NULL);
+}
+
+
+- (id)stealOperationForWorker:(TWTWorkStealingWorker *)thief
+{
+    NSUInteger workerCount = _workers.count;
+    NSUInteger startIndex = arc4random_uniform((uint32_t)workerCount);
+
+    for (NSUInteger i = 0; i < workerCount; ++i) {
+        TWTWorkStealingWorker *victim = _workers[(startIndex + i) % workerCount];
+        if (victim == thief) {
+            continue;
+        }
+
+        id operation = [victim stealOperation];
+        if (operation) {
+            return operation;
+        }
+    }
+
+    return nil;
+}
+
+
+- (void)runOperation:(id)operationOrTask
+{
+    dispatch_group_t outstandingOperationGroup = _outstandingOperationGroup;
+
+    // Tasks leave the group themselves, so running one allocates nothing
+    if ([operationOrTask isKindOfClass:[TWTAsynchronousTask class]]) {
+        [(TWTAsynchronousTask *)operationOrTask startInGroup:outstandingOperationGroup];
+        return;
+    }
+
+    NSOperation *operation = operationOrTask;
+
+    if ([operation isKindOfClass:[TWTAsynchronousOperation class]]) {
+        [(TWTAsynchronousOperation *)operation addFinishHandler:^(TWTAsynchronousOperation *finishedOperation) {
+            dispatch_group_leave(outstandingOperationGroup);
+        }];
+
+        [operation start];
+        return;
+    }
+
+    [operation start];
+    if (operation.isFinished) {
+        dispatch_group_leave(outstandingOperationGroup);
+    } else {
+        [operation twt_addFinishHandler:^(NSOperation *finishedOperation) {
+            dispatch_group_leave(outstandingOperationGroup);
+        }];
+    }
+}
+
+@end
+
+
+#pragma mark - Executor
+
+@interface TWTWorkStealingExecutor ()
+
+@property (nonatomic, strong, readonly) TWTWorkStealingScheduler *scheduler;
+
+@end
+
+
+@implementation TWTWorkStealingExecutor
+
+- (instancetype)init
+{
+    return [self initWithWorkerCount:[[NSProcessInfo processInfo] activeProcessorCount]];
+}
+
+
+- (instancetype)initWithWorkerCount:(NSUInteger)workerCount
+{
+    NSParameterAssert(workerCount > 0);
+
+    self = [super init];
+    if (self) {
+        _workerCount = workerCount;
+        _scheduler = [[TWTWorkStealingScheduler alloc] initWithWorkerCount:workerCount];
+    }
+    return self;
+}
+
+
+- (void)dealloc
+{
+    [_scheduler stop];
+}
+
+
+- (NSString *)description
+{
+    return [NSString stringWithFormat:@"<%@: %p workerCount=%lu>", self.class, self, (unsigned long)self.workerCount];
+}
+
+
+- (TWTAsynchronousOperation *)addOperationWithBlock:(TWTAsynchronousOperationBlock)block
+{
+    NSParameterAssert(block);
+
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:block];
+    [self.scheduler submitOperation:operation];
+    return operation;
+}
+
+
+- (void)addOperation:(NSOperation *)operation
+{
+    NSParameterAssert(operation);
+    [self.scheduler submitOperation:operation];
+}
+
+
+- (void)addTask:(TWTAsynchronousTask *)task
+{
+    NSParameterAssert(task);
+    [self.scheduler submitTask:task];
+}
+
+
+- (void)addOperations:(NSArray<NSOperation *> *)operations waitUntilFinished:(BOOL)wait
+{
+    NSParameterAssert(operations);
+
+    for (NSOperation *operation in operations) {
+        [self.scheduler submitOperation:operation];
+    }
+
+    if (wait) {
+        [self waitUntilAllOperationsAreFinished];
+    }
+}
+
+
+- (void)waitUntilAllOperationsAreFinished
+{
+    [self.scheduler waitUntilAllOperationsAreFinished];
+}
+
+@end
@@ -0,0 +1,220 @@
+//
+//  TWTAsynchronousOperationPoolTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTAsynchronousOperationPool.h"
+#import "TWTWorkStealingExecutor.h"
+
+
+@interface TWTAsynchronousOperationPoolTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTAsynchronousOperationPoolTests
+
+- (TWTAsynchronousTaskBlock)finishingTaskBlock
+{
+    return ^(TWTAsynchronousTask *task) {
+        [task finishTaskExecution];
+    };
+}
+
+
+- (void)testFinishedTasksAreReused
+{
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] init];
+
+    TWTAsynchronousTask *task = [pool taskWithBlock:[self finishingTaskBlock]];
+    XCTAssertEqual(pool.missCount, 1, @"First task was not a miss");
+    XCTAssertEqual(pool.pooledTaskCount, 0, @"Pool contains an unfinished task");
+
+    [task start];
+    XCTAssertFalse(task.isExecuting, @"Task did not finish");
+    XCTAssertEqual(pool.pooledTaskCount, 1, @"Pool does not contain the finished task");
+
+    __block BOOL blockExecuted = NO;
+    TWTAsynchronousTask *reusedTask = [pool taskWithBlock:^(TWTAsynchronousTask *task) {
+        blockExecuted = YES;
+        [task finishTaskExecution];
+    }];
+
+    XCTAssertEqual(reusedTask, task, @"Finished task was not reused");
+    XCTAssertEqual(pool.hitCount, 1, @"Reuse was not counted as a hit");
+    XCTAssertEqual(pool.pooledTaskCount, 0, @"Pool still contains the reused task");
+
+    [reusedTask start];
+    XCTAssertTrue(blockExecuted, @"Reused task did not execute its new block");
+    XCTAssertEqual(pool.pooledTaskCount, 1, @"Reused task was not returned to the pool");
+}
+
+
+- (void)testUnfinishedTasksAreNotRecycled
+{
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] init];
+
+    __block NSUInteger executionCount = 0;
+    TWTAsynchronousTask *task = [pool taskWithBlock:^(TWTAsynchronousTask *task) {
+        ++executionCount;
+    }];
+
+    [task start];
+    XCTAssertTrue(task.isExecuting, @"Task is not executing");
+    XCTAssertEqual(pool.pooledTaskCount, 0, @"Executing task was recycled");
+
+    [task start];
+    XCTAssertEqual(executionCount, 1, @"Executing task was started again");
+
+    [task finishTaskExecution];
+    [task finishTaskExecution];
+    XCTAssertFalse(task.isExecuting, @"Task did not finish");
+    XCTAssertEqual(pool.pooledTaskCount, 1, @"Finishing a task twice did not recycle it exactly once");
+}
+
+
+- (void)testTasksReturnToTheThreadThatAllocatedThem
+{
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] init];
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:random() % 4 + 1];
+
+    NSUInteger taskCount = random() % 64 + 1;
+    __block NSUInteger executionCount = 0;
+    TWTAsynchronousTaskBlock taskBlock = ^(TWTAsynchronousTask *task) {
+        @synchronized (pool) {
+            ++executionCount;
+        }
+
+        // Finish on yet another thread, which should still return the task to this test’s thread
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            [task finishTaskExecution];
+        });
+    };
+
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        [executor addTask:[pool taskWithBlock:taskBlock]];
+    }
+
+    [executor waitUntilAllOperationsAreFinished];
+    XCTAssertEqual(executionCount, taskCount, @"Tasks did not all execute");
+    XCTAssertEqual(pool.pooledTaskCount, taskCount, @"Finished tasks were not all returned to the pool");
+
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        [executor addTask:[pool taskWithBlock:taskBlock]];
+    }
+
+    [executor waitUntilAllOperationsAreFinished];
+    XCTAssertEqual(executionCount, 2 * taskCount, @"Reused tasks did not all execute");
+    XCTAssertEqual(pool.missCount, taskCount, @"Tasks finished on other threads were not reused");
+    XCTAssertEqual(pool.hitCount, taskCount, @"Tasks finished on other threads were not reused");
+}
+
+
+- (void)testPoolsDoNotShareFreeLists
+{
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] init];
+    [[pool taskWithBlock:nil] start];
+    XCTAssertEqual(pool.pooledTaskCount, 1, @"Finished task was not recycled");
+
+    TWTAsynchronousOperationPool *otherPool = [[TWTAsynchronousOperationPool alloc] init];
+    [otherPool taskWithBlock:nil];
+    XCTAssertEqual(otherPool.hitCount, 0, @"Pool reused another pool’s task");
+    XCTAssertEqual(otherPool.pooledTaskCount, 0, @"Pool count changed without a task finishing");
+}
+
+
+- (void)testMaximumPoolSize
+{
+    NSUInteger maximumPoolSize = random() % 16 + 1;
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] initWithMaximumPoolSize:maximumPoolSize];
+
+    NSUInteger taskCount = maximumPoolSize + random() % 16 + 1;
+    NSMutableArray *tasks = [[NSMutableArray alloc] initWithCapacity:taskCount];
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        [tasks addObject:[pool taskWithBlock:nil]];
+    }
+
+    for (TWTAsynchronousTask *task in tasks) {
+        [task start];
+    }
+
+    XCTAssertEqual(pool.pooledTaskCount, maximumPoolSize, @"Pool exceeded its maximum size");
+    XCTAssertEqual(pool.discardCount, taskCount - maximumPoolSize, @"Incorrect discard count");
+}
+
+
+- (void)testSteadyStateSubmissionAllocatesNothing
+{
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] init];
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:2];
+    TWTAsynchronousTaskBlock taskBlock = [self finishingTaskBlock];
+
+    NSUInteger tasksPerRound = 64;
+    void (^submitTasks)(NSUInteger) = ^(NSUInteger taskCount) {
+        // Drain any autoreleased return values so that the autorelease pool never needs a new page
+        @autoreleasepool {
+            for (NSUInteger i = 0; i < taskCount; ++i) {
+                [executor addTask:[pool taskWithBlock:taskBlock]];
+            }
+        }
+    };
+
+    // The first round allocates more tasks than later rounds use and grows the workers’ deques past the size they
+    // need in later rounds
+    submitTasks(4 * tasksPerRound);
+    [executor waitUntilAllOperationsAreFinished];
+
+    NSUInteger roundCount = 100;
+    NSUInteger allocationCount = 0;
+    for (NSUInteger i = 0; i < roundCount; ++i) {
+        allocationCount += TWTAllocationCountForBlock(^{
+            submitTasks(tasksPerRound);
+        });
+
+        [executor waitUntilAllOperationsAreFinished];
+    }
+
+    XCTAssertEqual(allocationCount, 0, @"Submitting recycled tasks allocated memory");
+    XCTAssertEqual(pool.missCount, 4 * tasksPerRound, @"Tasks were allocated after the first round");
+    XCTAssertEqual(pool.hitCount, roundCount * tasksPerRound, @"Tasks were not reused");
+}
+
+
+#pragma mark - Performance
+
+- (void)testPooledTaskPerformance
+{
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] initWithMaximumPoolSize:1];
+    TWTAsynchronousTaskBlock taskBlock = [self finishingTaskBlock];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100000; ++i) {
+            [[pool taskWithBlock:taskBlock] start];
+        }
+    }];
+}
+
+@end
@@ -0,0 +1,367 @@
+//
+//  TWTAsynchronousOperationTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTAsynchronousOperation.h"
+#import "TWTTimerWheel.h"
+
+
+#pragma mark Legacy Operation
+
+/*!
+ TWTLegacyAsynchronousOperation reproduces the original TWTAsynchronousOperation state machine, which stored its state
+ in a plain ivar and sent four KVO notifications on every transition. It exists only so that the performance tests
+ below can compare the two implementations.
+ */
+@interface TWTLegacyAsynchronousOperation : NSOperation
+
+@property (nonatomic, assign) NSUInteger state;
+@property (nonatomic, copy) void (^operationBlock)(TWTLegacyAsynchronousOperation *operation);
+
+- (void)finishOperationExecution;
+
+@end
+
+
+@implementation TWTLegacyAsynchronousOperation
+
++ (NSString *)keyForState:(NSUInteger)state
+{
+    return @[ @"isReady", @"isExecuting", @"isFinished" ][state];
+}
+
+
+- (void)start
+{
+    self.state = 1;
+    if (self.operationBlock) {
+        self.operationBlock(self);
+    } else {
+        [self finishOperationExecution];
+    }
+}
+
+
+- (void)finishOperationExecution
+{
+    self.operationBlock = nil;
+    self.state = 2;
+}
+
+
+- (BOOL)isReady
+{
+    return self.state == 0 && [super isReady];
+}
+
+
+- (BOOL)isExecuting
+{
+    return self.state == 1;
+}
+
+
+- (BOOL)isFinished
+{
+    return self.state == 2;
+}
+
+
+- (BOOL)isConcurrent
+{
+    return YES;
+}
+
+
+- (void)setState:(NSUInteger)state
+{
+    NSString *oldStateKey = [[self class] keyForState:_state];
+    NSString *newStateKey = [[self class] keyForState:state];
+
+    [self willChangeValueForKey:oldStateKey];
+    [self willChangeValueForKey:newStateKey];
+    _state = state;
+    [self didChangeValueForKey:oldStateKey];
+    [self didChangeValueForKey:newStateKey];
+}
+
+@end
+
+
+#pragma mark - Tests
+
+@interface TWTAsynchronousOperationTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTAsynchronousOperationTests
+
+- (void)testStartAndFinish
+{
+    __block BOOL blockExecuted = NO;
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        blockExecuted = YES;
+        XCTAssertTrue(operation.isExecuting, @"Operation is not executing inside its block");
+        XCTAssertFalse(operation.isFinished, @"Operation is finished inside its block");
+        [operation finishOperationExecution];
+    }];
+
+    XCTAssertFalse(operation.isExecuting, @"Operation is executing before start");
+    XCTAssertFalse(operation.isFinished, @"Operation is finished before start");
+
+    [operation start];
+
+    XCTAssertTrue(blockExecuted, @"Operation block was not executed");
+    XCTAssertFalse(operation.isExecuting, @"Operation is executing after finish");
+    XCTAssertTrue(operation.isFinished, @"Operation is not finished after finish");
+}
+
+
+- (void)testCancelBeforeStart
+{
+    __block BOOL blockExecuted = NO;
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        blockExecuted = YES;
+        [operation finishOperationExecution];
+    }];
+
+    [operation cancel];
+    [operation start];
+
+    XCTAssertFalse(blockExecuted, @"Operation block was executed after cancellation");
+    XCTAssertTrue(operation.isFinished, @"Cancelled operation is not finished after start");
+}
+
+
+- (void)testRepeatedStartAndFinishAreIgnored
+{
+    __block NSUInteger executionCount = 0;
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        ++executionCount;
+    }];
+
+    [operation start];
+    [operation start];
+    XCTAssertEqual(executionCount, 1, @"Operation block executed more than once");
+
+    [operation finishOperationExecution];
+    [operation finishOperationExecution];
+    XCTAssertTrue(operation.isFinished, @"Operation is not finished");
+}
+
+
+- (void)testKeyValueNotificationsOnlyForChangedKeys
+{
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:nil];
+
+    NSMutableArray *changedKeys = [[NSMutableArray alloc] init];
+    for (NSString *key in @[ @"isReady", @"isExecuting", @"isFinished" ]) {
+        [operation addObserver:self forKeyPath:key options:0 context:(__bridge void *)changedKeys];
+    }
+
+    [operation start];
+
+    for (NSString *key in @[ @"isReady", @"isExecuting", @"isFinished" ]) {
+        [operation removeObserver:self forKeyPath:key context:(__bridge void *)changedKeys];
+    }
+
+    NSArray *expectedKeys = @[ @"isExecuting", @"isFinished", @"isExecuting" ];
+    XCTAssertEqualObjects(changedKeys, expectedKeys, @"Unexpected KVO notifications");
+}
+
+
+- (void)testRacingStartFinishAndCancelNotifyOnce
+{
+    dispatch_queue_t queue = dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0);
+    NSArray *observedKeys = @[ @"isExecuting", @"isFinished" ];
+
+    for (NSUInteger i = 0; i < 1000; ++i) {
+        __block NSUInteger executionCount = 0;
+        TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+            ++executionCount;
+        }];
+
+        __block NSUInteger finishHandlerCount = 0;
+        [operation addFinishHandler:^(TWTAsynchronousOperation *operation) {
+            ++finishHandlerCount;
+        }];
+
+        NSMutableArray *changedKeys = [[NSMutableArray alloc] init];
+        for (NSString *key in observedKeys) {
+            [operation addObserver:self forKeyPath:key options:0 context:(__bridge void *)changedKeys];
+        }
+
+        dispatch_group_t group = dispatch_group_create();
+        for (NSUInteger j = 0; j < 2; ++j) {
+            dispatch_group_async(group, queue, ^{
+                [operation start];
+            });
+
+            dispatch_group_async(group, queue, ^{
+                [operation finishOperationExecution];
+            });
+
+            dispatch_group_async(group, queue, ^{
+                [operation cancel];
+            });
+        }
+
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+
+        // If the operation started without being cancelled after every finish was attempted, it is still executing
+        [operation finishOperationExecution];
+
+        for (NSString *key in observedKeys) {
+            [operation removeObserver:self forKeyPath:key context:(__bridge void *)changedKeys];
+        }
+
+        NSCountedSet *changedKeyCounts = [[NSCountedSet alloc] initWithArray:changedKeys];
+        XCTAssertTrue(operation.isFinished, @"Operation did not finish");
+        XCTAssertLessThanOrEqual(executionCount, 1, @"Operation block executed more than once");
+        XCTAssertEqual(finishHandlerCount, 1, @"Operation did not finish exactly once");
+        XCTAssertEqual([changedKeyCounts countForObject:@"isFinished"], 1, @"isFinished did not change exactly once");
+
+        // isExecuting changes when the operation starts executing and again when it finishes, or never if it was 
+        // cancelled before it started
+        XCTAssertEqual([changedKeyCounts countForObject:@"isExecuting"], 2 * executionCount,
+                       @"isExecuting notifications do not match the operation's transitions");
+    }
+}
+
+
+- (void)observeValueForKeyPath:(NSString *)keyPath ofObject:(id)object change:(NSDictionary *)change context:(void *)context
+{
+    NSMutableArray *changedKeys = (__bridge NSMutableArray *)context;
+    @synchronized (changedKeys) {
+        [changedKeys addObject:keyPath];
+    }
+}
+
+
+- (void)testQueueExecution
+{
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+
+    NSUInteger operationCount = random() % 100 + 1;
+    NSMutableArray *operations = [[NSMutableArray alloc] initWithCapacity:operationCount];
+    for (NSUInteger i = 0; i < operationCount; ++i) {
+        [operations addObject:[[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                [operation finishOperationExecution];
+            });
+        }]];
+    }
+
+    [queue addOperations:operations waitUntilFinished:YES];
+
+    for (TWTAsynchronousOperation *operation in operations) {
+        XCTAssertTrue(operation.isFinished, @"Operation did not finish");
+    }
+}
+
+
+- (void)testMissedDeadlineFinishesExecutingOperation
+{
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+
+    // The block never finishes the operation, so only the deadline can
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) { }];
+    [operation setDeadlineWithTimeInterval:0.05 action:TWTAsynchronousOperationDeadlineActionFinish];
+    [queue addOperations:@[ operation ] waitUntilFinished:YES];
+
+    XCTAssertTrue(operation.isFinished, @"Operation did not finish");
+    XCTAssertTrue(operation.isCancelled, @"Operation was not cancelled");
+    XCTAssertTrue(operation.missedDeadline, @"Operation did not miss its deadline");
+}
+
+
+- (void)testFinishingBeforeDeadlineRemovesIt
+{
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        [operation finishOperationExecution];
+    }];
+
+    NSUInteger timerCount = [TWTTimerWheel sharedTimerWheel].timerCount;
+    [operation setDeadlineWithTimeInterval:60 action:TWTAsynchronousOperationDeadlineActionCancel];
+    XCTAssertEqual([TWTTimerWheel sharedTimerWheel].timerCount, timerCount + 1, @"Deadline was not scheduled");
+
+    [operation start];
+    XCTAssertEqual([TWTTimerWheel sharedTimerWheel].timerCount, timerCount, @"Deadline was not removed when operation finished");
+    XCTAssertFalse(operation.missedDeadline, @"Operation missed its deadline");
+    XCTAssertFalse(operation.isCancelled, @"Operation was cancelled");
+}
+
+#pragma mark - Performance
+
+- (void)testLegacyStartFinishPerformance
+{
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10000; ++i) {
+            @autoreleasepool {
+                TWTLegacyAsynchronousOperation *operation = [[TWTLegacyAsynchronousOperation alloc] init];
+                operation.operationBlock = ^(TWTLegacyAsynchronousOperation *operation) {
+                    [operation finishOperationExecution];
+                };
+
+                [operation start];
+            }
+        }
+    }];
+}
+
+
+- (void)testStartFinishPerformance
+{
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10000; ++i) {
+            @autoreleasepool {
+                [[[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+                    [operation finishOperationExecution];
+                }] start];
+            }
+        }
+    }];
+}
+
+
+- (void)testQueueThroughputPerformance
+{
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10000; ++i) {
+            [queue addOperation:[[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+                [operation finishOperationExecution];
+            }]];
+        }
+
+        [queue waitUntilAllOperationsAreFinished];
+    }];
+}
+
+@end
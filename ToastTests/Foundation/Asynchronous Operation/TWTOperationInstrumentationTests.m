@@ -0,0 +1,152 @@
+//
+//  TWTOperationInstrumentationTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTAsynchronousOperation.h"
+#import "TWTOperationInstrumentation.h"
+
+
+@interface TWTOperationInstrumentationTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTOperationInstrumentationTests
+
+- (void)setUp
+{
+    [super setUp];
+    [TWTOperationInstrumentation reset];
+}
+
+
+- (void)tearDown
+{
+    [TWTOperationInstrumentation setEnabled:NO];
+    [TWTOperationInstrumentation reset];
+    [super tearDown];
+}
+
+
+- (NSArray *)operationsWithLabel:(NSString *)label count:(NSUInteger)count runTime:(NSTimeInterval)runTime
+{
+    NSMutableArray *operations = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, runTime * NSEC_PER_SEC), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                [operation finishOperationExecution];
+            });
+        }];
+
+        operation.name = label;
+        [operations addObject:operation];
+    }
+
+    return operations;
+}
+
+
+- (void)testDisabledInstrumentationRecordsNothing
+{
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    [queue addOperations:[self operationsWithLabel:UMKRandomAlphanumericString() count:random() % 16 + 1 runTime:0]
+       waitUntilFinished:YES];
+
+    XCTAssertEqual([TWTOperationInstrumentation snapshot].count, 0, @"Values were recorded while disabled");
+}
+
+
+- (void)testSnapshotsGroupByLabel
+{
+    [TWTOperationInstrumentation setEnabled:YES];
+
+    NSString *fastLabel = UMKRandomAlphanumericString();
+    NSString *slowLabel = [fastLabel stringByAppendingString:@"-slow"];
+    NSUInteger fastCount = random() % 32 + 1;
+    NSUInteger slowCount = random() % 4 + 1;
+    NSTimeInterval slowRunTime = 0.05;
+
+    // Run serially so that the slow operations also accumulate measurable queue wait
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    queue.maxConcurrentOperationCount = 1;
+
+    NSMutableArray *operations = [[NSMutableArray alloc] init];
+    [operations addObjectsFromArray:[self operationsWithLabel:fastLabel count:fastCount runTime:0]];
+    [operations addObjectsFromArray:[self operationsWithLabel:slowLabel count:slowCount runTime:slowRunTime]];
+    [queue addOperations:operations waitUntilFinished:YES];
+
+    NSDictionary *snapshot = [TWTOperationInstrumentation snapshot];
+    XCTAssertEqual(snapshot.count, 2, @"Incorrect number of labels");
+
+    NSDictionary *fastRunTime = snapshot[fastLabel][kTWTOperationInstrumentationRunTimeKey];
+    NSDictionary *slowStatistics = snapshot[slowLabel][kTWTOperationInstrumentationRunTimeKey];
+    XCTAssertEqualObjects(fastRunTime[kTWTOperationInstrumentationCountKey], @(fastCount), @"Incorrect count");
+    XCTAssertEqualObjects(slowStatistics[kTWTOperationInstrumentationCountKey], @(slowCount), @"Incorrect count");
+
+    // Allow for the histogram’s bucketing error
+    XCTAssertGreaterThanOrEqual([slowStatistics[kTWTOperationInstrumentationMinimumKey] doubleValue], slowRunTime,
+                                @"Run time is less than the time spent executing");
+    XCTAssertGreaterThanOrEqual([slowStatistics[kTWTOperationInstrumentationP50Key] doubleValue], slowRunTime * 15 / 16,
+                                @"Median run time is too small");
+    XCTAssertLessThanOrEqual([slowStatistics[kTWTOperationInstrumentationP50Key] doubleValue],
+                             [slowStatistics[kTWTOperationInstrumentationMaximumKey] doubleValue],
+                             @"Median exceeds the maximum");
+
+    // Queue wait is only recorded if the queue asked the operations whether they were ready
+    NSDictionary *slowQueueWaitTime = snapshot[slowLabel][kTWTOperationInstrumentationQueueWaitTimeKey];
+    if (slowCount > 1 && [slowQueueWaitTime[kTWTOperationInstrumentationCountKey] unsignedIntegerValue] == slowCount) {
+        XCTAssertGreaterThanOrEqual([slowQueueWaitTime[kTWTOperationInstrumentationMaximumKey] doubleValue], slowRunTime,
+                                    @"Queue wait does not include time spent behind a slow operation");
+    }
+
+    NSError *error = nil;
+    NSData *JSONData = [TWTOperationInstrumentation snapshotJSONDataWithError:&error];
+    XCTAssertNotNil(JSONData, @"Snapshot was not serialized: %@", error);
+    NSDictionary *JSONObject = [NSJSONSerialization JSONObjectWithData:JSONData options:0 error:NULL];
+    XCTAssertEqualObjects([NSSet setWithArray:JSONObject.allKeys], [NSSet setWithArray:snapshot.allKeys],
+                          @"JSON labels do not match snapshot");
+
+    [TWTOperationInstrumentation reset];
+    XCTAssertEqual([TWTOperationInstrumentation snapshot].count, 0, @"Reset did not discard recorded values");
+}
+
+
+- (void)testRecordingFromManyThreads
+{
+    [TWTOperationInstrumentation setEnabled:YES];
+
+    NSString *label = UMKRandomAlphanumericString();
+    NSUInteger operationCount = random() % 1000 + 100;
+
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    [queue addOperations:[self operationsWithLabel:label count:operationCount runTime:0] waitUntilFinished:YES];
+
+    NSDictionary *runTime = [TWTOperationInstrumentation snapshot][label][kTWTOperationInstrumentationRunTimeKey];
+    XCTAssertEqualObjects(runTime[kTWTOperationInstrumentationCountKey], @(operationCount), @"Values were lost");
+}
+
+@end
@@ -0,0 +1,119 @@
+//
+//  TWTTimerWheelTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTTimerWheel.h"
+
+
+@interface TWTTimerWheelTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTTimerWheelTests
+
+- (void)testTimersFireInOrderAndNotEarly
+{
+    TWTTimerWheel *timerWheel = [[TWTTimerWheel alloc] initWithTickInterval:0.001];
+
+    NSUInteger timerCount = random() % 16 + 2;
+    NSMutableArray *firedIndexes = [[NSMutableArray alloc] initWithCapacity:timerCount];
+    dispatch_group_t group = dispatch_group_create();
+
+    NSTimeInterval startTime = [[NSProcessInfo processInfo] systemUptime];
+    for (NSUInteger i = 0; i < timerCount; ++i) {
+        // Space timers several ticks apart, and far enough out that some of them start in level 1
+        NSTimeInterval timeInterval = 0.01 * (i + 1);
+        dispatch_group_enter(group);
+        [timerWheel scheduleTimerWithTimeInterval:timeInterval block:^{
+            XCTAssertGreaterThanOrEqual([[NSProcessInfo processInfo] systemUptime] - startTime, timeInterval, @"Timer fired early");
+            [firedIndexes addObject:@(i)];
+            dispatch_group_leave(group);
+        }];
+    }
+
+    XCTAssertEqual(timerWheel.timerCount, timerCount, @"Incorrect timer count");
+    XCTAssertEqual(dispatch_group_wait(group, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)), 0, @"Timers did not fire");
+
+    for (NSUInteger i = 0; i < timerCount; ++i) {
+        XCTAssertEqualObjects(firedIndexes[i], @(i), @"Timers fired out of order");
+    }
+
+    XCTAssertEqual(timerWheel.timerCount, 0, @"Incorrect timer count after firing");
+}
+
+
+- (void)testCancelledTimersDoNotFire
+{
+    TWTTimerWheel *timerWheel = [[TWTTimerWheel alloc] initWithTickInterval:0.001];
+
+    __block BOOL cancelledTimerFired = NO;
+    TWTTimerWheelTimer *timer = [timerWheel scheduleTimerWithTimeInterval:0.01 block:^{
+        cancelledTimerFired = YES;
+    }];
+
+    XCTAssertTrue([timer cancel], @"Timer was not cancelled");
+    XCTAssertFalse([timer cancel], @"Timer was cancelled twice");
+    XCTAssertEqual(timerWheel.timerCount, 0, @"Cancelled timer is still counted");
+
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [timerWheel scheduleTimerWithTimeInterval:0.05 block:^{
+        dispatch_semaphore_signal(semaphore);
+    }];
+
+    dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+    XCTAssertFalse(cancelledTimerFired, @"Cancelled timer fired");
+
+    // Timers can only be cancelled by the wheel that scheduled them
+    TWTTimerWheelTimer *otherTimer = [[TWTTimerWheel sharedTimerWheel] scheduleTimerWithTimeInterval:60 block:^{ }];
+    XCTAssertFalse([timerWheel cancelTimer:otherTimer], @"Timer was cancelled by the wrong wheel");
+    XCTAssertTrue([otherTimer cancel], @"Timer was not cancelled");
+}
+
+
+- (void)testManyTimersCanBeScheduledAndCancelled
+{
+    TWTTimerWheel *timerWheel = [[TWTTimerWheel alloc] init];
+
+    // Spread timers across every level of the wheel, including past its end
+    NSUInteger timerCount = 100000;
+    NSMutableArray *timers = [[NSMutableArray alloc] initWithCapacity:timerCount];
+    for (NSUInteger i = 0; i < timerCount; ++i) {
+        NSTimeInterval timeInterval = 60 + pow(2, random() % 26) * timerWheel.tickInterval;
+        [timers addObject:[timerWheel scheduleTimerWithTimeInterval:timeInterval block:^{ }]];
+    }
+
+    XCTAssertEqual(timerWheel.timerCount, timerCount, @"Incorrect timer count");
+
+    for (TWTTimerWheelTimer *timer in timers) {
+        XCTAssertTrue([timer cancel], @"Timer was not cancelled");
+    }
+
+    XCTAssertEqual(timerWheel.timerCount, 0, @"Incorrect timer count after cancellation");
+}
+
+@end
@@ -0,0 +1,138 @@
+//
+//  NSDictionaryTWTKeyPathFlatteningTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import <URLMock/UMKTestUtilities.h>
+
+#import "NSDictionary+TWTKeyPathFlattening.h"
+
+
+@interface NSDictionaryTWTKeyPathFlatteningTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation NSDictionaryTWTKeyPathFlatteningTests
+
+#pragma mark - Helpers
+
+// Alphanumeric keys never contain the separator, so the random dictionaries never have collisions
+- (NSDictionary *)randomNestedDictionaryWithDepth:(NSUInteger)depth
+{
+    NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] init];
+    NSUInteger count = random() % 5 + 1;
+    for (NSUInteger i = 0; i < count; ++i) {
+        NSString *key = UMKRandomAlphanumericString();
+        dictionary[key] = (depth > 0 && random() % 2) ? [self randomNestedDictionaryWithDepth:depth - 1] : UMKRandomUnicodeString();
+    }
+
+    return dictionary;
+}
+
+
+#pragma mark - Tests
+
+- (void)testFlatten
+{
+    NSString *leafValue = UMKRandomUnicodeString();
+    NSString *topValue = UMKRandomUnicodeString();
+    NSDictionary *dictionary = @{ @"a" : @{ @"b" : @{ @"c" : leafValue }, @"e" : @{ } }, @"d" : topValue, @3 : @4 };
+
+    NSDictionary *expectedDictionary = @{ @"a.b.c" : leafValue, @"a.e" : @{ }, @"d" : topValue, @"3" : @4 };
+    XCTAssertEqualObjects([dictionary twt_keyPathFlattenedDictionary], expectedDictionary, @"Flattened dictionary is incorrect");
+
+    NSDictionary *slashDictionary = [dictionary twt_keyPathFlattenedDictionaryWithSeparator:@"/"
+                                                                            collisionPolicy:TWTKeyPathFlatteningCollisionPolicyKeepLast];
+    XCTAssertEqualObjects(slashDictionary[@"a/b/c"], leafValue, @"Custom separator is not used");
+
+    XCTAssertEqualObjects([@{ } twt_keyPathFlattenedDictionary], @{ }, @"Empty dictionary does not flatten to empty dictionary");
+    XCTAssertThrows([dictionary twt_keyPathFlattenedDictionaryWithSeparator:@"" collisionPolicy:TWTKeyPathFlatteningCollisionPolicyKeepLast],
+                    @"Empty separator does not throw");
+}
+
+
+- (void)testCollisionPolicies
+{
+    NSString *value1 = UMKRandomUnicodeString();
+    NSString *value2 = UMKRandomUnicodeString();
+    NSDictionary *dictionary = @{ @"a.b" : value1, @"a" : @{ @"b" : value2 } };
+
+    // Dictionaries have no inherent order, so determine which leaf comes first the same way flattening does
+    __block NSArray *valuesInEnumerationOrder = nil;
+    [dictionary enumerateKeysAndObjectsUsingBlock:^(NSString *key, id value, BOOL *stop) {
+        valuesInEnumerationOrder = [key isEqualToString:@"a"] ? @[ value2, value1 ] : @[ value1, value2 ];
+        *stop = YES;
+    }];
+
+    NSDictionary *keepFirstDictionary = [dictionary twt_keyPathFlattenedDictionaryWithSeparator:@"."
+                                                                                collisionPolicy:TWTKeyPathFlatteningCollisionPolicyKeepFirst];
+    XCTAssertEqualObjects(keepFirstDictionary, @{ @"a.b" : valuesInEnumerationOrder[0] }, @"Keep first is incorrect");
+
+    NSDictionary *keepLastDictionary = [dictionary twt_keyPathFlattenedDictionaryWithSeparator:@"."
+                                                                               collisionPolicy:TWTKeyPathFlatteningCollisionPolicyKeepLast];
+    XCTAssertEqualObjects(keepLastDictionary, @{ @"a.b" : valuesInEnumerationOrder[1] }, @"Keep last is incorrect");
+
+    NSMutableDictionary *collidingDictionary = [dictionary mutableCopy];
+    collidingDictionary[@"c"] = value1;
+    NSDictionary *collectDictionary = [collidingDictionary twt_keyPathFlattenedDictionaryWithSeparator:@"."
+                                                                                       collisionPolicy:TWTKeyPathFlatteningCollisionPolicyCollect];
+    XCTAssertEqualObjects([NSSet setWithArray:collectDictionary[@"a.b"]], ([NSSet setWithObjects:value1, value2, nil]),
+                          @"Collect does not collect all colliding values");
+    XCTAssertEqualObjects(collectDictionary[@"c"], value1, @"Collect changes values without collisions");
+}
+
+
+- (void)testUnflatten
+{
+    NSString *leafValue = UMKRandomUnicodeString();
+    NSDictionary *flattenedDictionary = @{ @"a.b.c" : leafValue, @"a.e" : @{ }, @"d" : @1, @"a.b" : @2 };
+
+    NSDictionary *expectedDictionary = @{ @"a" : @{ @"b" : @{ @"c" : leafValue }, @"e" : @{ } }, @"d" : @1 };
+    XCTAssertEqualObjects([flattenedDictionary twt_keyPathUnflattenedDictionary], expectedDictionary,
+                          @"Unflattened dictionary is incorrect; child dictionaries should take precedence");
+
+    NSDictionary *slashDictionary = @{ @"a/b" : leafValue, @"a.c" : @1 };
+    XCTAssertEqualObjects([slashDictionary twt_keyPathUnflattenedDictionaryWithSeparator:@"/"],
+                          (@{ @"a" : @{ @"b" : leafValue }, @"a.c" : @1 }), @"Custom separator is not used");
+}
+
+
+- (void)testRoundTrip
+{
+    for (NSUInteger i = 0; i < 20; ++i) {
+        NSDictionary *dictionary = [self randomNestedDictionaryWithDepth:random() % 6];
+        NSDictionary *flattenedDictionary = [dictionary twt_keyPathFlattenedDictionary];
+
+        for (id value in flattenedDictionary.objectEnumerator) {
+            XCTAssertFalse([value isKindOfClass:[NSDictionary class]] && [value count] > 0, @"Flattened dictionary has a nested value");
+        }
+
+        XCTAssertEqualObjects([flattenedDictionary twt_keyPathUnflattenedDictionary], dictionary, @"Round trip does not preserve dictionary");
+    }
+}
+
+@end
@@ -31,6 +31,45 @@
 #import "TWTBlockEnumeration.h"
 
 
+#pragma mark TWTCountingEnumerator
+
+/*!
+ TWTCountingEnumerators yield the NSNumbers from 0 up to a count without storing them, so that performance tests
+ can enumerate many elements without the memory for a collection of them.
+ */
+@interface TWTCountingEnumerator : NSEnumerator
+
+- (instancetype)initWithCount:(NSUInteger)count;
+
+@end
+
+
+@implementation TWTCountingEnumerator {
+    NSUInteger _count;
+    NSUInteger _index;
+}
+
+- (instancetype)initWithCount:(NSUInteger)count
+{
+    self = [super init];
+    if (self) {
+        _count = count;
+    }
+
+    return self;
+}
+
+
+- (id)nextObject
+{
+    return _index < _count ? @(_index++) : nil;
+}
+
+@end
+
+
+#pragma mark -
+
 @interface TWTBlockEnumerationTests : TWTRandomizedTestCase
 
 @end
@@ -45,6 +84,25 @@
     return (random() % 1024) + 1;
 }
 
+- (NSArray *)randomSortedNumberArray
+{
+    // Few distinct values, so there are many duplicates within and across arrays
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(random() % 256, ^id(NSUInteger index) {
+        return @(random() % 64);
+    });
+
+    return [numbers sortedArrayUsingSelector:@selector(compare:)];
+}
+
+
+- (NSArray *)randomStringArrayWithCount:(NSUInteger)count
+{
+    return UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return UMKRandomUnicodeString();
+    });
+}
+
+
 - (NSArray *)randomStringArray
 {
     NSSet *stringSet = UMKGeneratedSetWithElementCount([self randomCount], ^id{
@@ -165,6 +223,61 @@
     XCTAssertEqualObjects(groups, expectedGroups, @"Group dictionary does not match the expected group dictionary");
 }
 
+- (void)testDictionaryBlockEnumerationCountBy
+{
+    NSDictionary *randomStringDictionary = [self randomStringDictionary];
+    TWTBlockEnumerationGroupBlock groupBlock = ^id<NSCopying>(NSString *element) {
+        return @(element.length % 4);
+    };
+
+    NSDictionary *counts = [randomStringDictionary twt_countByBlock:groupBlock];
+    NSDictionary *groups = [randomStringDictionary twt_groupWithBlock:groupBlock];
+
+    XCTAssertEqual(counts.count, groups.count, @"Count keys do not match group keys");
+    for (id groupKey in groups) {
+        XCTAssertEqualObjects(counts[groupKey], @([groups[groupKey] count]), @"Count does not match group size");
+    }
+}
+
+
+- (void)testDictionaryBlockEnumerationDistinct
+{
+    NSDictionary *randomStringDictionary = [self randomStringDictionary];
+
+    NSDictionary *distinctDictionary = [randomStringDictionary twt_distinctByBlock:^id<NSCopying>(NSString *element) {
+        return @(element.length);
+    }];
+
+    XCTAssertTrue([distinctDictionary isKindOfClass:[NSDictionary class]], @"Returned collection is not a dictionary");
+    NSArray *lengths = [distinctDictionary.allKeys valueForKey:@"length"];
+    XCTAssertEqual([NSSet setWithArray:lengths].count, lengths.count, @"Returned dictionary has keys with duplicate lengths");
+    XCTAssertEqualObjects([NSSet setWithArray:lengths], [NSSet setWithArray:[randomStringDictionary.allKeys valueForKey:@"length"]], @"Returned dictionary is missing some lengths");
+    for (NSString *key in distinctDictionary) {
+        XCTAssertEqualObjects(distinctDictionary[key], randomStringDictionary[key], @"Returned dictionary has the wrong value for a key");
+    }
+}
+
+
+- (void)testDictionaryBlockEnumerationPartition
+{
+    NSDictionary *randomNumbers = [self randomNumberDictionary];
+    NSNumber *randomMaximumNumber = UMKRandomUnsignedNumber();
+    TWTBlockEnumerationPredicateBlock predicate = ^BOOL(id element) {
+        return [randomNumbers[element] compare:randomMaximumNumber] == NSOrderedDescending;
+    };
+
+    __block NSUInteger invocationCount = 0;
+    NSArray *partitions = [randomNumbers twt_partitionWithBlock:^BOOL(id element) {
+        ++invocationCount;
+        return predicate(element);
+    }];
+
+    XCTAssertEqual(invocationCount, randomNumbers.count, @"Predicate was not invoked exactly once per element");
+    XCTAssertEqual(partitions.count, 2, @"Partition did not return two collections");
+    XCTAssertEqualObjects(partitions[0], [randomNumbers twt_selectWithBlock:predicate], @"Selected partition does not match selected dictionary");
+    XCTAssertEqualObjects(partitions[1], [randomNumbers twt_rejectWithBlock:predicate], @"Rejected partition does not match rejected dictionary");
+}
+
 
 - (void)testDictionaryBlockEnumerationInject
 {
@@ -247,6 +360,38 @@
     }
 }
 
+- (void)testDictionaryBlockEnumerationSorted
+{
+    NSDictionary *randomNumbers = [self randomNumberDictionary];
+
+    NSArray *sortedKeys = [randomNumbers twt_sortedByBlock:^id(id key) {
+        return randomNumbers[key];
+    }];
+
+    XCTAssertEqual(sortedKeys.count, randomNumbers.count, @"Sorted array count does not match dictionary count");
+    XCTAssertEqualObjects([NSSet setWithArray:sortedKeys], [NSSet setWithArray:randomNumbers.allKeys], @"Sorted array does not contain the dictionary’s keys");
+    for (NSUInteger i = 1; i < sortedKeys.count; ++i) {
+        XCTAssertNotEqual([randomNumbers[sortedKeys[i - 1]] compare:randomNumbers[sortedKeys[i]]], NSOrderedDescending, @"Keys are not sorted by value");
+    }
+}
+
+
+- (void)testDictionaryBlockEnumerationTopK
+{
+    NSDictionary *randomNumbers = [self randomNumberDictionary];
+    NSUInteger k = random() % (randomNumbers.count + 1);
+
+    TWTBlockEnumerationSortKeyBlock keyBlock = ^id(id key) {
+        return randomNumbers[key];
+    };
+
+    NSArray *topKeys = [randomNumbers twt_topK:k byBlock:keyBlock];
+    NSArray *sortedKeys = [randomNumbers twt_sortedByBlock:keyBlock];
+
+    XCTAssertEqual(topKeys.count, k, @"Top-k array has wrong count");
+    XCTAssertEqualObjects(topKeys, [sortedKeys subarrayWithRange:NSMakeRange(0, k)], @"Top-k keys do not match first k sorted keys");
+}
+
 
 #pragma mark - Collection Tests
 
@@ -299,6 +444,126 @@
 }
 
 
+- (void)testCollectionBlockEnumerationFlattenWithMaximumDepth
+{
+    NSArray *innermostArray = @[ UMKRandomAlphanumericString(), UMKRandomAlphanumericString() ];
+    NSArray *middleArray = @[ UMKRandomAlphanumericString(), innermostArray ];
+    NSString *leaf = UMKRandomAlphanumericString();
+    NSArray *nestedArray = @[ middleArray, leaf, @[ ] ];
+
+    XCTAssertEqualObjects([nestedArray twt_flattenWithMaximumDepth:0], nestedArray, @"Depth 0 is not a copy");
+    XCTAssertEqualObjects([nestedArray twt_flattenWithMaximumDepth:1], (@[ middleArray[0], innermostArray, leaf ]), @"Depth 1 is incorrect");
+
+    NSArray *fullyFlattenedArray = @[ middleArray[0], innermostArray[0], innermostArray[1], leaf ];
+    XCTAssertEqualObjects([nestedArray twt_flattenWithMaximumDepth:2], fullyFlattenedArray, @"Depth 2 is incorrect");
+    XCTAssertEqualObjects([nestedArray twt_flatten], fullyFlattenedArray, @"Unlimited depth is incorrect");
+    XCTAssertEqualObjects([nestedArray.objectEnumerator twt_flattenWithMaximumDepth:1], [nestedArray twt_flattenWithMaximumDepth:1],
+                          @"Enumerator flatten is incorrect");
+
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:nestedArray];
+    XCTAssertEqualObjects([orderedSet twt_flatten], [NSOrderedSet orderedSetWithArray:fullyFlattenedArray], @"Ordered set flatten is incorrect");
+
+    NSSet *set = [NSSet setWithArray:@[ [NSSet setWithArray:middleArray], leaf ]];
+    XCTAssertEqualObjects([set twt_flattenWithMaximumDepth:1], ([NSSet setWithObjects:middleArray[0], innermostArray, leaf, nil]),
+                          @"Set flatten is incorrect");
+}
+
+
+- (void)testCollectionBlockEnumerationFlattenDeepNesting
+{
+    // Recursive flattening would need one stack frame per level
+    NSString *leaf = UMKRandomAlphanumericString();
+    NSUInteger depth = 10000 + random() % 1000;
+
+    id nestedArray = @[ leaf ];
+    for (NSUInteger i = 0; i < depth; ++i) {
+        nestedArray = @[ nestedArray ];
+    }
+
+    XCTAssertEqualObjects([nestedArray twt_flatten], @[ leaf ], @"Deeply nested flatten is incorrect");
+    XCTAssertEqual([[nestedArray twt_flattenWithMaximumDepth:depth - 1] count], 1, @"Depth-limited flatten is incorrect");
+    XCTAssertTrue([[[nestedArray twt_flattenWithMaximumDepth:depth - 1] firstObject] isKindOfClass:[NSArray class]],
+                  @"Depth-limited flatten went too deep");
+
+    // Sets and dictionaries copy their elements into the enumeration buffer rather than returning internal storage.
+    // Nest them well past the initial frame capacity, with leaves on every level, so that the walk returns to 
+    // shallower frames after deeper ones have been pushed
+    NSMutableSet *expectedLeaves = [[NSMutableSet alloc] init];
+    id nestedCollection = [NSSet setWithObject:leaf];
+    [expectedLeaves addObject:leaf];
+    for (NSUInteger i = 0; i < 64; ++i) {
+        NSString *firstLeaf = [NSString stringWithFormat:@"%@-%lu-first", leaf, (unsigned long)i];
+        NSString *secondLeaf = [NSString stringWithFormat:@"%@-%lu-second", leaf, (unsigned long)i];
+        [expectedLeaves addObject:firstLeaf];
+        [expectedLeaves addObject:secondLeaf];
+
+        if (i % 2) {
+            nestedCollection = [NSSet setWithObjects:firstLeaf, nestedCollection, secondLeaf, nil];
+        } else {
+            nestedCollection = @{ firstLeaf : @0, nestedCollection : @1, secondLeaf : @2 };
+        }
+    }
+
+    NSArray *flattenedLeaves = [@[ nestedCollection ] twt_flatten];
+    XCTAssertEqual(flattenedLeaves.count, expectedLeaves.count, @"Deeply nested set and dictionary flatten has incorrect count");
+    XCTAssertEqualObjects([NSSet setWithArray:flattenedLeaves], expectedLeaves, @"Deeply nested set and dictionary flatten is incorrect");
+}
+
+
+- (void)testFlattenedObjectEnumerator
+{
+    NSMutableArray *nestedArray = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < [self randomCount]; ++i) {
+        [nestedArray addObject:@[ UMKRandomAlphanumericString(), @[ UMKRandomAlphanumericString(), @[ ] ] ]];
+        [nestedArray addObject:UMKRandomAlphanumericString()];
+    }
+
+    for (NSUInteger depth = 0; depth < 4; ++depth) {
+        NSEnumerator *enumerator = [nestedArray twt_flattenedObjectEnumeratorWithMaximumDepth:depth];
+        XCTAssertEqualObjects(enumerator.allObjects, [nestedArray twt_flattenWithMaximumDepth:depth],
+                              @"Enumerator does not match flatten at depth %lu", (unsigned long)depth);
+    }
+
+    // Leaves are produced on demand
+    NSEnumerator *enumerator = [nestedArray twt_flattenedObjectEnumeratorWithMaximumDepth:NSUIntegerMax];
+    XCTAssertEqualObjects([enumerator nextObject], nestedArray[0][0], @"First leaf is incorrect");
+    XCTAssertEqualObjects([enumerator nextObject], nestedArray[0][1][0], @"Second leaf is incorrect");
+    XCTAssertEqualObjects([enumerator nextObject], nestedArray[1], @"Third leaf is incorrect");
+
+    NSMutableArray *mutatedArray = [nestedArray mutableCopy];
+    enumerator = [mutatedArray twt_flattenedObjectEnumeratorWithMaximumDepth:NSUIntegerMax];
+    void (^enumerateWhileMutating)(void) = ^{
+        for (__unused id leaf in enumerator) {
+            [mutatedArray removeLastObject];
+        }
+    };
+
+    XCTAssertThrows(enumerateWhileMutating(), @"Mutation during enumeration does not throw");
+}
+
+
+- (void)testDictionaryBlockEnumerationFlattenWithMaximumDepth
+{
+    NSDictionary *innermostDictionary = @{ UMKRandomAlphanumericString() : UMKRandomAlphanumericString() };
+    NSString *innerKey = UMKRandomAlphanumericString();
+    NSString *middleKey = UMKRandomAlphanumericString();
+    NSDictionary *middleDictionary = @{ innerKey : innermostDictionary, middleKey : UMKRandomAlphanumericString() };
+    NSString *topKey = UMKRandomAlphanumericString();
+    NSDictionary *nestedDictionary = @{ UMKRandomAlphanumericString() : middleDictionary, topKey : UMKRandomAlphanumericString() };
+
+    XCTAssertEqualObjects([nestedDictionary twt_flattenWithMaximumDepth:0], nestedDictionary, @"Depth 0 is not a copy");
+
+    NSDictionary *expectedDictionary = @{ innerKey : innermostDictionary, middleKey : middleDictionary[middleKey],
+                                          topKey : nestedDictionary[topKey] };
+    XCTAssertEqualObjects([nestedDictionary twt_flattenWithMaximumDepth:1], expectedDictionary, @"Depth 1 is incorrect");
+
+    NSMutableDictionary *fullyFlattenedDictionary = [innermostDictionary mutableCopy];
+    fullyFlattenedDictionary[middleKey] = middleDictionary[middleKey];
+    fullyFlattenedDictionary[topKey] = nestedDictionary[topKey];
+    XCTAssertEqualObjects([nestedDictionary twt_flatten], fullyFlattenedDictionary, @"Unlimited depth is incorrect");
+}
+
+
 - (void)testCollectionBlockEnumerationGroup
 {
     for (Class class in [self collectionClasses]) {
@@ -412,6 +677,468 @@
     }
 }
 
+- (void)testCollectionBlockEnumerationSorted
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomNumberArray]];
+
+        NSArray *actualValues = [randomCollection twt_sortedByBlock:^id(NSNumber *element) {
+            return element;
+        }];
+
+        NSArray *expectedValues = [[[randomCollection objectEnumerator] allObjects] sortedArrayUsingSelector:@selector(compare:)];
+        XCTAssertEqualObjects(actualValues, expectedValues, @"Sorted array does not match expected array");
+    }
+}
+
+
+- (void)testCollectionBlockEnumerationSortedInvokesBlockOncePerElement
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomStringArray]];
+
+        __block NSUInteger invocationCount = 0;
+        [randomCollection twt_sortedByBlock:^id(NSString *element) {
+            ++invocationCount;
+            return @(element.length);
+        }];
+
+        XCTAssertEqual(invocationCount, [randomCollection count], @"Key block was not invoked exactly once per element");
+
+        invocationCount = 0;
+        [randomCollection twt_topK:random() % [randomCollection count] + 1 byBlock:^id(NSString *element) {
+            ++invocationCount;
+            return @(element.length);
+        }];
+
+        XCTAssertEqual(invocationCount, [randomCollection count], @"Key block was not invoked exactly once per element");
+    }
+}
+
+
+- (void)testCollectionBlockEnumerationTopK
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomNumberArray]];
+        NSUInteger k = random() % ([randomCollection count] + 1);
+
+        NSArray *actualValues = [randomCollection twt_topK:k byBlock:^id(NSNumber *element) {
+            return element;
+        }];
+
+        NSArray *sortedValues = [[[randomCollection objectEnumerator] allObjects] sortedArrayUsingSelector:@selector(compare:)];
+        XCTAssertEqualObjects(actualValues, [sortedValues subarrayWithRange:NSMakeRange(0, k)], @"Top-k array does not match first k sorted elements");
+
+        XCTAssertEqualObjects([randomCollection twt_topK:0 byBlock:^id(id element) { return element; }], @[ ], @"Top-0 array is not empty");
+        XCTAssertEqualObjects([randomCollection twt_topK:[randomCollection count] + 1 byBlock:^id(id element) { return element; }], sortedValues,
+                              @"Top-k array with k greater than count does not match sorted array");
+    }
+}
+
+
+- (void)testEnumeratorBlockEnumerationSortedAndTopK
+{
+    NSArray *randomNumbers = [self randomNumberArray];
+    NSArray *expectedValues = [randomNumbers sortedArrayUsingSelector:@selector(compare:)];
+    NSUInteger k = random() % (randomNumbers.count + 1);
+    TWTBlockEnumerationSortKeyBlock keyBlock = ^id(NSNumber *element) {
+        return element;
+    };
+
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_sortedByBlock:keyBlock], expectedValues, @"Sorted array does not match expected array");
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_topK:k byBlock:keyBlock], [expectedValues subarrayWithRange:NSMakeRange(0, k)],
+                          @"Top-k array does not match first k sorted elements");
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_topK:randomNumbers.count + 1 byBlock:keyBlock], expectedValues,
+                          @"Top-k array with k greater than count does not match sorted array");
+}
+
+- (void)assertSample:(NSArray *)sample isSubmultisetOfArray:(NSArray *)array
+{
+    NSCountedSet *remainingElements = [[NSCountedSet alloc] initWithArray:array];
+    for (id element in sample) {
+        XCTAssertTrue([remainingElements countForObject:element] > 0, @"Sample contains element not in collection");
+        [remainingElements removeObject:element];
+    }
+}
+
+
+- (void)testCollectionBlockEnumerationSample
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomNumberArray]];
+        NSArray *elements = [[randomCollection objectEnumerator] allObjects];
+        NSUInteger size = random() % ([randomCollection count] + 1);
+        uint64_t seed = ((uint64_t)random() << 32) | random();
+
+        NSArray *sample = [randomCollection twt_sampleOfSize:size seed:seed];
+        XCTAssertEqual(sample.count, size, @"Sample has incorrect size");
+        [self assertSample:sample isSubmultisetOfArray:elements];
+        XCTAssertEqualObjects([randomCollection twt_sampleOfSize:size seed:seed], sample, @"Samples with the same seed differ");
+
+        XCTAssertEqualObjects([randomCollection twt_sampleOfSize:0 seed:seed], @[ ], @"Sample of size 0 is not empty");
+        XCTAssertEqualObjects([NSCountedSet setWithArray:[randomCollection twt_sampleOfSize:[randomCollection count] + 1]],
+                              [NSCountedSet setWithArray:elements], @"Sample larger than collection does not contain every element");
+    }
+}
+
+
+- (void)testEnumeratorBlockEnumerationSample
+{
+    NSArray *randomNumbers = [self randomNumberArray];
+    NSUInteger size = random() % (randomNumbers.count + 1);
+    uint64_t seed = ((uint64_t)random() << 32) | random();
+    TWTBlockEnumerationGroupBlock groupBlock = ^id<NSCopying>(NSNumber *element) {
+        return @(element.unsignedIntegerValue % 7);
+    };
+
+    // Enumerators are sampled in the same single pass as arrays, so the same seed selects the same elements
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_sampleOfSize:size seed:seed], [randomNumbers twt_sampleOfSize:size seed:seed],
+                          @"Enumerator sample does not match array sample with the same seed");
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_sampleOfSize:size groupedByBlock:groupBlock seed:seed],
+                          [randomNumbers twt_sampleOfSize:size groupedByBlock:groupBlock seed:seed],
+                          @"Enumerator stratified sample does not match array stratified sample with the same seed");
+}
+
+
+- (void)testSampleIsUniform
+{
+    NSUInteger count = 10;
+    NSUInteger size = 3;
+    NSUInteger trialCount = 20000;
+    NSArray *elements = UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    NSCountedSet *sampledElements = [[NSCountedSet alloc] init];
+    uint64_t seed = ((uint64_t)random() << 32) | random();
+    for (NSUInteger trial = 0; trial < trialCount; ++trial) {
+        [sampledElements addObjectsFromArray:[[elements objectEnumerator] twt_sampleOfSize:size seed:seed + trial]];
+    }
+
+    // Each element should be chosen in size / count of the trials. Allow 10%, which is over 9 standard deviations
+    double expectedCount = (double)trialCount * size / count;
+    for (NSNumber *element in elements) {
+        XCTAssertEqualWithAccuracy((double)[sampledElements countForObject:element], expectedCount, expectedCount * 0.1,
+                                   @"Element %@ was not sampled uniformly", element);
+    }
+}
+
+
+- (void)testCollectionBlockEnumerationStratifiedSample
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomNumberArray]];
+        NSUInteger size = random() % 32;
+        uint64_t seed = ((uint64_t)random() << 32) | random();
+        TWTBlockEnumerationGroupBlock groupBlock = ^id<NSCopying>(NSNumber *element) {
+            return element.unsignedIntegerValue % 7 ? @(element.unsignedIntegerValue % 7) : nil;
+        };
+
+        NSDictionary *samples = [randomCollection twt_sampleOfSize:size groupedByBlock:groupBlock seed:seed];
+        NSDictionary *groups = [randomCollection twt_groupWithBlock:groupBlock];
+
+        XCTAssertEqualObjects([NSSet setWithArray:samples.allKeys], [NSSet setWithArray:groups.allKeys], @"Sample keys do not match group keys");
+        for (id groupKey in groups) {
+            NSArray *groupElements = [[groups[groupKey] objectEnumerator] allObjects];
+            XCTAssertEqual([samples[groupKey] count], MIN(size, groupElements.count), @"Group sample has incorrect size");
+            [self assertSample:samples[groupKey] isSubmultisetOfArray:groupElements];
+        }
+
+        XCTAssertEqualObjects([randomCollection twt_sampleOfSize:size groupedByBlock:groupBlock seed:seed], samples,
+                              @"Stratified samples with the same seed differ");
+    }
+}
+
+
+- (void)testCollectionBlockEnumerationCountBy
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomNumberArray]];
+        TWTBlockEnumerationGroupBlock groupBlock = ^id<NSCopying>(NSNumber *element) {
+            return element.unsignedIntegerValue % 7 ? @(element.unsignedIntegerValue % 7) : nil;
+        };
+
+        NSDictionary *counts = [randomCollection twt_countByBlock:groupBlock];
+        NSDictionary *groups = [randomCollection twt_groupWithBlock:groupBlock];
+
+        XCTAssertEqual(counts.count, groups.count, @"Count keys do not match group keys");
+        for (id groupKey in groups) {
+            XCTAssertEqualObjects(counts[groupKey], @([groups[groupKey] count]), @"Count does not match group size");
+        }
+    }
+}
+
+
+- (void)testCollectionBlockEnumerationDistinct
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomStringArray]];
+
+        id distinctCollection = [randomCollection twt_distinctByBlock:^id<NSCopying>(NSString *element) {
+            return @(element.length);
+        }];
+
+        XCTAssertTrue([distinctCollection isKindOfClass:class], @"Returned collection is not an instance of %@", class);
+
+        NSMutableSet *expectedLengths = [[NSMutableSet alloc] init];
+        NSMutableArray *expectedElements = [[NSMutableArray alloc] init];
+        for (NSString *element in randomCollection) {
+            if (![expectedLengths containsObject:@(element.length)]) {
+                [expectedLengths addObject:@(element.length)];
+                [expectedElements addObject:element];
+            }
+        }
+
+        XCTAssertEqualObjects([[distinctCollection objectEnumerator] allObjects], expectedElements, @"Returned collection does not contain the first element of each length");
+    }
+}
+
+
+- (void)testCollectionBlockEnumerationPartition
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomNumberArray]];
+        NSNumber *randomMaximumNumber = UMKRandomUnsignedNumber();
+        TWTBlockEnumerationPredicateBlock predicate = ^BOOL(id element) {
+            return [element compare:randomMaximumNumber] == NSOrderedDescending;
+        };
+
+        __block NSUInteger invocationCount = 0;
+        NSArray *partitions = [randomCollection twt_partitionWithBlock:^BOOL(id element) {
+            ++invocationCount;
+            return predicate(element);
+        }];
+
+        XCTAssertEqual(invocationCount, [randomCollection count], @"Predicate was not invoked exactly once per element");
+        XCTAssertEqual(partitions.count, 2, @"Partition did not return two collections");
+        XCTAssertTrue([partitions[0] isKindOfClass:class] && [partitions[1] isKindOfClass:class], @"Partitions are not instances of %@", class);
+        XCTAssertEqualObjects(partitions[0], [randomCollection twt_selectWithBlock:predicate], @"Selected partition does not match selected collection");
+        XCTAssertEqualObjects(partitions[1], [randomCollection twt_rejectWithBlock:predicate], @"Rejected partition does not match rejected collection");
+    }
+}
+
+
+- (void)testEnumeratorBlockEnumerationPartitionCountByAndDistinct
+{
+    NSArray *randomNumbers = [self randomNumberArray];
+    TWTBlockEnumerationPredicateBlock predicate = ^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue % 2 == 0;
+    };
+
+    TWTBlockEnumerationGroupBlock groupBlock = ^id<NSCopying>(NSNumber *element) {
+        return @(element.unsignedIntegerValue % 5);
+    };
+
+    NSArray *partitions = [[randomNumbers objectEnumerator] twt_partitionWithBlock:predicate];
+    XCTAssertEqualObjects(partitions, (@[ [randomNumbers twt_selectWithBlock:predicate], [randomNumbers twt_rejectWithBlock:predicate] ]),
+                          @"Partitions do not match selected and rejected arrays");
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_countByBlock:groupBlock], [randomNumbers twt_countByBlock:groupBlock],
+                          @"Counts do not match array counts");
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_distinctByBlock:groupBlock], [randomNumbers twt_distinctByBlock:groupBlock],
+                          @"Distinct elements do not match array distinct elements");
+}
+
+
+- (void)testCollectionBlockEnumerationIntoCollection
+{
+    for (Class class in [self collectionClasses]) {
+        id randomCollection = [[class alloc] initWithArray:[self randomNumberArray]];
+        NSNumber *randomMaximumNumber = UMKRandomUnsignedNumber();
+        TWTBlockEnumerationPredicateBlock predicate = ^BOOL(id element) {
+            return [element compare:randomMaximumNumber] == NSOrderedDescending;
+        };
+
+        TWTBlockEnumerationCollectBlock collectBlock = ^id(NSNumber *element) {
+            return element.unsignedIntegerValue % 3 ? @(element.unsignedIntegerValue + 1) : nil;
+        };
+
+        // Existing contents should be kept
+        NSString *existingObject = UMKRandomUnicodeString();
+        id collected = [[[class alloc] init] mutableCopy];
+        id selected = [[[class alloc] init] mutableCopy];
+        id rejected = [[[class alloc] init] mutableCopy];
+        for (id collection in @[ collected, selected, rejected ]) {
+            [collection addObject:existingObject];
+        }
+
+        [randomCollection twt_collectWithBlock:collectBlock intoCollection:collected];
+        [randomCollection twt_selectWithBlock:predicate intoCollection:selected];
+        [randomCollection twt_rejectWithBlock:predicate intoCollection:rejected];
+
+        NSMutableArray *expectedResults = [[NSMutableArray alloc] init];
+        for (NSArray *results in @[ [randomCollection twt_collectWithBlock:collectBlock], [randomCollection twt_selectWithBlock:predicate],
+                                    [randomCollection twt_rejectWithBlock:predicate] ]) {
+            id expectedCollection = [[[class alloc] initWithObjects:existingObject, nil] mutableCopy];
+            for (id element in results) {
+                [expectedCollection addObject:element];
+            }
+
+            [expectedResults addObject:expectedCollection];
+        }
+
+        id expectedCollected = expectedResults[0];
+        id expectedSelected = expectedResults[1];
+        id expectedRejected = expectedResults[2];
+
+        XCTAssertEqualObjects(collected, expectedCollected, @"Collected collection does not match expected collection");
+        XCTAssertEqualObjects(selected, expectedSelected, @"Selected collection does not match expected collection");
+        XCTAssertEqualObjects(rejected, expectedRejected, @"Rejected collection does not match expected collection");
+
+        [selected removeAllObjects];
+        [rejected removeAllObjects];
+        [randomCollection twt_partitionWithBlock:predicate intoSelectedCollection:selected rejectedCollection:rejected];
+        XCTAssertEqualObjects((@[ selected, rejected ]), [randomCollection twt_partitionWithBlock:predicate], @"Partitions do not match expected partitions");
+    }
+}
+
+
+- (void)testDictionaryBlockEnumerationIntoCollection
+{
+    NSDictionary *randomNumbers = [self randomNumberDictionary];
+    NSNumber *randomMaximumNumber = UMKRandomUnsignedNumber();
+    TWTBlockEnumerationPredicateBlock predicate = ^BOOL(id element) {
+        return [randomNumbers[element] compare:randomMaximumNumber] == NSOrderedDescending;
+    };
+
+    TWTBlockEnumerationCollectBlock collectBlock = ^id(id element) {
+        return [randomNumbers[element] description];
+    };
+
+    NSMutableDictionary *collected = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary *selected = [[NSMutableDictionary alloc] init];
+    NSMutableDictionary *rejected = [[NSMutableDictionary alloc] init];
+    [randomNumbers twt_collectWithBlock:collectBlock intoCollection:collected];
+    [randomNumbers twt_selectWithBlock:predicate intoCollection:selected];
+    [randomNumbers twt_rejectWithBlock:predicate intoCollection:rejected];
+
+    XCTAssertEqualObjects(collected, [randomNumbers twt_collectWithBlock:collectBlock], @"Collected dictionary does not match expected dictionary");
+    XCTAssertEqualObjects(selected, [randomNumbers twt_selectWithBlock:predicate], @"Selected dictionary does not match expected dictionary");
+    XCTAssertEqualObjects(rejected, [randomNumbers twt_rejectWithBlock:predicate], @"Rejected dictionary does not match expected dictionary");
+}
+
+
+- (void)testIntoCollectionWithReusedCollectionDoesNotAllocate
+{
+    NSArray *randomNumbers = [self randomNumberArray];
+    NSMutableArray *collected = [[NSMutableArray alloc] init];
+    NSMutableArray *selected = [[NSMutableArray alloc] init];
+    NSMutableArray *rejected = [[NSMutableArray alloc] init];
+
+    TWTBlockEnumerationCollectBlock collectBlock = ^id(NSNumber *element) {
+        return element;
+    };
+
+    TWTBlockEnumerationPredicateBlock predicate = ^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue % 2 == 0;
+    };
+
+    void (^enumerateIntoReusedCollections)(void) = ^{
+        [collected removeAllObjects];
+        [selected removeAllObjects];
+        [rejected removeAllObjects];
+        [randomNumbers twt_collectWithBlock:collectBlock intoCollection:collected];
+        [randomNumbers twt_selectWithBlock:predicate intoCollection:selected];
+        [randomNumbers twt_partitionWithBlock:predicate intoSelectedCollection:selected rejectedCollection:rejected];
+    };
+
+    // The first pass grows the collections to their steady-state capacity
+    enumerateIntoReusedCollections();
+
+    NSUInteger allocationCount = TWTAllocationCountForBlock(^{
+        for (NSUInteger i = 0; i < 100; ++i) {
+            enumerateIntoReusedCollections();
+        }
+    });
+
+    XCTAssertEqual(allocationCount, 0, @"Enumerating into reused collections allocated memory");
+    XCTAssertEqualObjects(collected, randomNumbers, @"Collected array does not match expected array");
+    XCTAssertEqual(selected.count, 2 * [[randomNumbers twt_selectWithBlock:predicate] count], @"Selected array has the wrong count");
+    XCTAssertEqualObjects(rejected, [randomNumbers twt_rejectWithBlock:predicate], @"Rejected array does not match expected array");
+}
+
+
+- (void)testBlockEnumerationWithDrainAutoreleasePoolsOption
+{
+    NSArray *randomNumbers = UMKGeneratedArrayWithElementCount(20000 + random() % 1000, ^id(NSUInteger index) {
+        return UMKRandomUnsignedNumber();
+    });
+
+    TWTBlockEnumerationOptions options = TWTBlockEnumerationOptionDrainAutoreleasePools;
+    TWTBlockEnumerationCollectBlock collectBlock = ^id(NSNumber *element) {
+        return [element description];
+    };
+
+    TWTBlockEnumerationPredicateBlock predicate = ^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue % 3 == 0;
+    };
+
+    TWTBlockEnumerationGroupBlock groupBlock = ^id<NSCopying>(NSNumber *element) {
+        return @(element.unsignedIntegerValue % 10);
+    };
+
+    TWTBlockEnumerationInjectBlock injectBlock = ^id(NSString *memo, NSNumber *element) {
+        return [NSString stringWithFormat:@"%lu", (unsigned long)((memo.longLongValue + element.unsignedIntegerValue) % 1000)];
+    };
+
+    for (id collection in @[ randomNumbers, [NSOrderedSet orderedSetWithArray:randomNumbers], [NSSet setWithArray:randomNumbers] ]) {
+        XCTAssertEqualObjects([collection twt_collectWithOptions:options block:collectBlock], [collection twt_collectWithBlock:collectBlock],
+                              @"Collected collection does not match collection collected without options");
+        XCTAssertEqualObjects([collection twt_selectWithOptions:options block:predicate], [collection twt_selectWithBlock:predicate],
+                              @"Selected collection does not match collection selected without options");
+        XCTAssertEqualObjects([collection twt_rejectWithOptions:options block:predicate], [collection twt_rejectWithBlock:predicate],
+                              @"Rejected collection does not match collection rejected without options");
+        XCTAssertEqualObjects([collection twt_groupWithOptions:options block:groupBlock], [collection twt_groupWithBlock:groupBlock],
+                              @"Grouped collection does not match collection grouped without options");
+        XCTAssertEqualObjects([collection twt_injectWithOptions:options initialObject:@"0" block:injectBlock],
+                              [collection twt_injectWithInitialObject:@"0" block:injectBlock],
+                              @"Injected value does not match value injected without options");
+    }
+
+    XCTAssertEqualObjects([[randomNumbers objectEnumerator] twt_collectWithOptions:options block:collectBlock], [randomNumbers twt_collectWithBlock:collectBlock],
+                          @"Collected enumerator does not match array collected without options");
+
+    NSDictionary *randomNumberDictionary = [self randomNumberDictionary];
+    TWTBlockEnumerationPredicateBlock keyPredicate = ^BOOL(id key) {
+        return predicate(randomNumberDictionary[key]);
+    };
+
+    XCTAssertEqualObjects([randomNumberDictionary twt_selectWithOptions:options block:keyPredicate], [randomNumberDictionary twt_selectWithBlock:keyPredicate],
+                          @"Selected dictionary does not match dictionary selected without options");
+}
+
+
+- (void)testDrainAutoreleasePoolsOptionFreesTemporariesDuringEnumeration
+{
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(100000, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    for (NSNumber *optionsNumber in @[ @0, @(TWTBlockEnumerationOptionDrainAutoreleasePools) ]) {
+        TWTBlockEnumerationOptions options = optionsNumber.unsignedIntegerValue;
+        __block __weak id firstTemporary = nil;
+        __block BOOL firstTemporaryFreed = NO;
+
+        @autoreleasepool {
+            [[numbers objectEnumerator] twt_collectWithOptions:options block:^id(NSNumber *element) {
+                __autoreleasing id temporary = [[NSObject alloc] init];
+                if (element.unsignedIntegerValue == 0) {
+                    firstTemporary = temporary;
+                } else if (element.unsignedIntegerValue == numbers.count - 1) {
+                    firstTemporaryFreed = firstTemporary == nil;
+                }
+
+                return element;
+            }];
+        }
+
+        if (options & TWTBlockEnumerationOptionDrainAutoreleasePools) {
+            XCTAssertTrue(firstTemporaryFreed, @"Temporary was not freed before enumeration finished");
+        } else {
+            XCTAssertFalse(firstTemporaryFreed, @"Temporary was freed before enumeration finished without draining");
+        }
+    }
+}
+
 
 #pragma mark - Ordered Collection Tests
 
@@ -451,4 +1178,317 @@
     }
 }
 
+
+- (void)testOrderedCollectionBlockEnumerationSortedIsStable
+{
+    for (Class class in [self orderedCollectionClasses]) {
+        // Include a collection large enough to be sorted in parallel
+        for (NSNumber *count in @[ @([self randomCount]), @(100000 + random() % 1000) ]) {
+            id randomCollection = [[class alloc] initWithArray:UMKGeneratedArrayWithElementCount(count.unsignedIntegerValue, ^id(NSUInteger index) {
+                return @(index);
+            })];
+
+            // Few distinct keys, so there are many ties
+            TWTBlockEnumerationSortKeyBlock keyBlock = ^id(NSNumber *element) {
+                return @((element.unsignedIntegerValue * 2654435761u) % 97);
+            };
+
+            NSArray *expectedValues = [[[randomCollection objectEnumerator] allObjects] sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(id element1, id element2) {
+                return [keyBlock(element1) compare:keyBlock(element2)];
+            }];
+
+            XCTAssertEqualObjects([randomCollection twt_sortedByBlock:keyBlock], expectedValues, @"Sorted array is not stably sorted");
+
+            NSUInteger k = random() % ([randomCollection count] + 1);
+            XCTAssertEqualObjects([randomCollection twt_topK:k byBlock:keyBlock], [expectedValues subarrayWithRange:NSMakeRange(0, k)],
+                                  @"Top-k array does not match first k stably sorted elements");
+        }
+    }
+}
+
+
+#pragma mark - Sorted Array Tests
+
+- (void)testMergeSortedArrays
+{
+    // Tag each value with its array’s index so that the test can tell whether ties were merged stably
+    NSComparator comparator = ^NSComparisonResult(NSArray *element1, NSArray *element2) {
+        return [element1[0] compare:element2[0]];
+    };
+
+    NSUInteger arrayCount = random() % 9;
+    NSMutableArray *arrays = [[NSMutableArray alloc] initWithCapacity:arrayCount];
+    NSMutableArray *concatenatedArray = [[NSMutableArray alloc] init];
+    for (NSUInteger arrayIndex = 0; arrayIndex < arrayCount; ++arrayIndex) {
+        NSArray *array = [[self randomSortedNumberArray] twt_collectWithBlock:^id(NSNumber *element) {
+            return @[ element, @(arrayIndex) ];
+        }];
+
+        [arrays addObject:array];
+        [concatenatedArray addObjectsFromArray:array];
+    }
+
+    NSArray *expectedArray = [concatenatedArray sortedArrayWithOptions:NSSortStable usingComparator:comparator];
+    XCTAssertEqualObjects([NSArray twt_mergeSortedArrays:arrays usingComparator:comparator], expectedArray,
+                          @"Merged array does not match stably sorted concatenation");
+
+    XCTAssertEqualObjects([NSArray twt_mergeSortedArrays:@[ ] usingComparator:comparator], @[ ], @"Merge of no arrays is not empty");
+    XCTAssertEqualObjects(([NSArray twt_mergeSortedArrays:@[ @[ ], @[ ] ] usingComparator:comparator]), @[ ],
+                          @"Merge of empty arrays is not empty");
+}
+
+
+- (void)testSortedArrayUnionIntersectionAndDifference
+{
+    NSArray *array1 = [self randomSortedNumberArray];
+    NSArray *array2 = [self randomSortedNumberArray];
+    NSComparator comparator = ^NSComparisonResult(NSNumber *element1, NSNumber *element2) {
+        return [element1 compare:element2];
+    };
+
+    // Equal objects are matched in pairs, so the expected results follow from how often each value occurs
+    NSCountedSet *counts1 = [[NSCountedSet alloc] initWithArray:array1];
+    NSCountedSet *counts2 = [[NSCountedSet alloc] initWithArray:array2];
+    NSMutableSet *values = [[NSMutableSet alloc] initWithArray:array1];
+    [values addObjectsFromArray:array2];
+
+    NSMutableArray *expectedUnion = [[NSMutableArray alloc] init];
+    NSMutableArray *expectedIntersection = [[NSMutableArray alloc] init];
+    NSMutableArray *expectedDifference = [[NSMutableArray alloc] init];
+    for (NSNumber *value in [values.allObjects sortedArrayUsingComparator:comparator]) {
+        NSUInteger count1 = [counts1 countForObject:value];
+        NSUInteger count2 = [counts2 countForObject:value];
+        for (NSUInteger i = 0; i < MAX(count1, count2); ++i) {
+            [expectedUnion addObject:value];
+        }
+
+        for (NSUInteger i = 0; i < MIN(count1, count2); ++i) {
+            [expectedIntersection addObject:value];
+        }
+
+        for (NSUInteger i = count2; i < count1; ++i) {
+            [expectedDifference addObject:value];
+        }
+    }
+
+    XCTAssertEqualObjects([array1 twt_unionWithSortedArray:array2 usingComparator:comparator], expectedUnion,
+                          @"Union does not match expected union");
+    XCTAssertEqualObjects([array1 twt_intersectionWithSortedArray:array2 usingComparator:comparator], expectedIntersection,
+                          @"Intersection does not match expected intersection");
+    XCTAssertEqualObjects([array1 twt_differenceWithSortedArray:array2 usingComparator:comparator], expectedDifference,
+                          @"Difference does not match expected difference");
+
+    XCTAssertEqualObjects([array1 twt_unionWithSortedArray:@[ ] usingComparator:comparator], array1, @"Union with empty array is not receiver");
+    XCTAssertEqualObjects([@[ ] twt_unionWithSortedArray:array2 usingComparator:comparator], array2, @"Union of empty array is not argument");
+    XCTAssertEqualObjects([array1 twt_intersectionWithSortedArray:@[ ] usingComparator:comparator], @[ ],
+                          @"Intersection with empty array is not empty");
+    XCTAssertEqualObjects([array1 twt_differenceWithSortedArray:@[ ] usingComparator:comparator], array1,
+                          @"Difference with empty array is not receiver");
+}
+
+
+- (void)testSortedArrayOperationsUseReceiverObjectsForMatches
+{
+    NSArray *array1 = @[ @"a", @"B", @"d" ];
+    NSArray *array2 = @[ @"A", @"b", @"c" ];
+    NSComparator comparator = ^NSComparisonResult(NSString *element1, NSString *element2) {
+        return [element1 caseInsensitiveCompare:element2];
+    };
+
+    XCTAssertEqualObjects([array1 twt_unionWithSortedArray:array2 usingComparator:comparator], (@[ @"a", @"B", @"c", @"d" ]),
+                          @"Union does not use receiver’s matched objects");
+    XCTAssertEqualObjects([array1 twt_intersectionWithSortedArray:array2 usingComparator:comparator], (@[ @"a", @"B" ]),
+                          @"Intersection does not use receiver’s matched objects");
+    XCTAssertEqualObjects([array1 twt_differenceWithSortedArray:array2 usingComparator:comparator], @[ @"d" ],
+                          @"Difference does not match expected difference");
+}
+
+
+#pragma mark - Performance
+
+- (TWTBlockEnumerationSortKeyBlock)expensiveSortKeyBlock
+{
+    // A moderately expensive key, like most derived sort keys
+    return ^id(NSString *element) {
+        return [element.lowercaseString decomposedStringWithCanonicalMapping];
+    };
+}
+
+
+- (void)testComparatorSortPerformance
+{
+    NSArray *strings = [self randomStringArrayWithCount:20000];
+    TWTBlockEnumerationSortKeyBlock keyBlock = [self expensiveSortKeyBlock];
+
+    [self measureBlock:^{
+        [strings sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(id element1, id element2) {
+            return [keyBlock(element1) compare:keyBlock(element2)];
+        }];
+    }];
+}
+
+
+- (void)testSortedByBlockPerformance
+{
+    NSArray *strings = [self randomStringArrayWithCount:20000];
+    TWTBlockEnumerationSortKeyBlock keyBlock = [self expensiveSortKeyBlock];
+
+    [self measureBlock:^{
+        [strings twt_sortedByBlock:keyBlock];
+    }];
+}
+
+
+- (void)testTopKPerformance
+{
+    NSArray *strings = [self randomStringArrayWithCount:20000];
+    TWTBlockEnumerationSortKeyBlock keyBlock = [self expensiveSortKeyBlock];
+
+    [self measureBlock:^{
+        [strings twt_topK:100 byBlock:keyBlock];
+    }];
+}
+
+
+- (TWTBlockEnumerationCollectBlock)autoreleasingCollectBlock
+{
+    return ^id(NSNumber *element) {
+        // Create an autoreleased temporary, as many real blocks do
+        __autoreleasing NSString *temporary = [NSString stringWithFormat:@"%@ %@ %@", element, element, element];
+        return @(temporary.length);
+    };
+}
+
+
+/*!
+ Measures the elapsed time and peak physical memory of the specified block. Peak memory is what the 
+ TWTBlockEnumerationOptionDrainAutoreleasePools option reduces, but XCTMemoryMetric is only available on iOS 13 and
+ later, so earlier systems only measure time.
+ */
+- (void)measureTimeAndPeakMemoryOfBlock:(void (^)(void))block
+{
+    if (@available(iOS 13.0, *)) {
+        [self measureWithMetrics:@[ [[XCTClockMetric alloc] init], [[XCTMemoryMetric alloc] init] ] block:block];
+    } else {
+        [self measureBlock:block];
+    }
+}
+
+
+- (void)testCollectWithDrainAutoreleasePoolsOptionMemoryPerformance
+{
+    TWTBlockEnumerationCollectBlock block = [self autoreleasingCollectBlock];
+
+    [self measureTimeAndPeakMemoryOfBlock:^{
+        @autoreleasepool {
+            [[[TWTCountingEnumerator alloc] initWithCount:200000] twt_collectWithOptions:TWTBlockEnumerationOptionDrainAutoreleasePools
+                                                                                   block:block];
+        }
+    }];
+}
+
+
+- (void)testCollectWithoutDrainAutoreleasePoolsOptionMemoryPerformance
+{
+    TWTBlockEnumerationCollectBlock block = [self autoreleasingCollectBlock];
+
+    [self measureTimeAndPeakMemoryOfBlock:^{
+        @autoreleasepool {
+            [[[TWTCountingEnumerator alloc] initWithCount:200000] twt_collectWithOptions:0 block:block];
+        }
+    }];
+}
+
+
+- (NSArray *)sortedArraysForMergePerformance
+{
+    NSMutableArray *arrays = [[NSMutableArray alloc] initWithCapacity:16];
+    for (NSUInteger arrayIndex = 0; arrayIndex < 16; ++arrayIndex) {
+        NSArray *array = UMKGeneratedArrayWithElementCount(4000, ^id(NSUInteger index) {
+            return UMKRandomUnsignedNumber();
+        });
+
+        [arrays addObject:[array sortedArrayUsingSelector:@selector(compare:)]];
+    }
+
+    return arrays;
+}
+
+
+- (void)testConcatenateAndSortPerformance
+{
+    NSArray *arrays = [self sortedArraysForMergePerformance];
+
+    [self measureBlock:^{
+        NSMutableArray *concatenatedArray = [[NSMutableArray alloc] init];
+        for (NSArray *array in arrays) {
+            [concatenatedArray addObjectsFromArray:array];
+        }
+
+        [concatenatedArray sortedArrayWithOptions:NSSortStable usingComparator:^NSComparisonResult(NSNumber *element1, NSNumber *element2) {
+            return [element1 compare:element2];
+        }];
+    }];
+}
+
+
+- (void)testMergeSortedArraysPerformance
+{
+    NSArray *arrays = [self sortedArraysForMergePerformance];
+
+    [self measureBlock:^{
+        [NSArray twt_mergeSortedArrays:arrays usingComparator:^NSComparisonResult(NSNumber *element1, NSNumber *element2) {
+            return [element1 compare:element2];
+        }];
+    }];
+}
+
+
+- (void)testSetBasedSortedArrayOperationsPerformance
+{
+    // Distinct multiples of 2 and 3, so that set-based operations are equivalent to the sorted array operations
+    NSArray *array1 = UMKGeneratedArrayWithElementCount(50000, ^id(NSUInteger index) {
+        return @(index * 2);
+    });
+
+    NSArray *array2 = UMKGeneratedArrayWithElementCount(50000, ^id(NSUInteger index) {
+        return @(index * 3);
+    });
+
+    [self measureBlock:^{
+        NSSet *set2 = [NSSet setWithArray:array2];
+        [[[NSSet setWithArray:[array1 arrayByAddingObjectsFromArray:array2]] allObjects] sortedArrayUsingSelector:@selector(compare:)];
+
+        NSMutableSet *intersectionSet = [NSMutableSet setWithArray:array1];
+        [intersectionSet intersectSet:set2];
+        [intersectionSet.allObjects sortedArrayUsingSelector:@selector(compare:)];
+
+        NSMutableSet *differenceSet = [NSMutableSet setWithArray:array1];
+        [differenceSet minusSet:set2];
+        [differenceSet.allObjects sortedArrayUsingSelector:@selector(compare:)];
+    }];
+}
+
+
+- (void)testLinearSortedArrayOperationsPerformance
+{
+    NSArray *array1 = UMKGeneratedArrayWithElementCount(50000, ^id(NSUInteger index) {
+        return @(index * 2);
+    });
+
+    NSArray *array2 = UMKGeneratedArrayWithElementCount(50000, ^id(NSUInteger index) {
+        return @(index * 3);
+    });
+
+    NSComparator comparator = ^NSComparisonResult(NSNumber *element1, NSNumber *element2) {
+        return [element1 compare:element2];
+    };
+
+    [self measureBlock:^{
+        [array1 twt_unionWithSortedArray:array2 usingComparator:comparator];
+        [array1 twt_intersectionWithSortedArray:array2 usingComparator:comparator];
+        [array1 twt_differenceWithSortedArray:array2 usingComparator:comparator];
+    }];
+}
+
 @end
@@ -0,0 +1,591 @@
+//
+//  TWTConcurrentBlockEnumerationTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import <URLMock/UMKTestUtilities.h>
+
+#import "TWTConcurrentBlockEnumeration.h"
+
+
+@interface TWTConcurrentBlockEnumerationTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTConcurrentBlockEnumerationTests
+
+#pragma mark - Helpers
+
+- (NSUInteger)randomConcurrentCount
+{
+    return kTWTConcurrentBlockEnumerationSerialThreshold + random() % 20000;
+}
+
+
+- (NSArray *)randomNumberArrayWithCount:(NSUInteger)count
+{
+    return UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(random() % 100000);
+    });
+}
+
+
+- (NSArray *)collectionClasses
+{
+    return @[ [NSArray class], [NSSet class], [NSOrderedSet class] ];
+}
+
+
+#pragma mark - Tests
+
+- (void)testConcurrentCollectMatchesSerialCollect
+{
+    for (NSUInteger count = random() % 16; count < kTWTConcurrentBlockEnumerationSerialThreshold * 8; count = count * 4 + 1) {
+        NSArray *numbers = [self randomNumberArrayWithCount:count];
+        TWTBlockEnumerationCollectBlock block = ^id(NSNumber *element) {
+            // Return nil for some elements to make sure they become NSNull
+            return element.integerValue % 7 == 0 ? nil : @(element.integerValue * 3);
+        };
+
+        for (Class collectionClass in [self collectionClasses]) {
+            id collection = [[collectionClass alloc] initWithArray:numbers];
+            XCTAssertEqualObjects([collection twt_concurrentCollectWithBlock:block], [collection twt_collectWithBlock:block],
+                                  @"Concurrent collect does not match serial collect for %@ of %lu", collectionClass, (unsigned long)count);
+        }
+
+        XCTAssertEqualObjects([numbers.objectEnumerator twt_concurrentCollectWithBlock:block], [numbers twt_collectWithBlock:block],
+                              @"Concurrent collect does not match serial collect for enumerator");
+    }
+}
+
+
+- (void)testConcurrentDetectReturnsLowestIndexMatch
+{
+    NSUInteger count = [self randomConcurrentCount];
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    // Elements at and after the first match are also matches, so only the lowest-index match is correct
+    NSUInteger firstMatch = random() % count;
+    TWTBlockEnumerationPredicateBlock block = ^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue >= firstMatch;
+    };
+
+    XCTAssertEqualObjects([numbers twt_concurrentDetectWithBlock:block], @(firstMatch), @"Array detect is not the lowest-index match");
+    XCTAssertEqualObjects([[NSOrderedSet orderedSetWithArray:numbers] twt_concurrentDetectWithBlock:block], @(firstMatch),
+                          @"Ordered set detect is not the lowest-index match");
+    XCTAssertEqualObjects([numbers.objectEnumerator twt_concurrentDetectWithBlock:block], @(firstMatch),
+                          @"Enumerator detect is not the lowest-index match");
+
+    TWTBlockEnumerationPredicateBlock noMatchBlock = ^BOOL(id element) {
+        return NO;
+    };
+
+    XCTAssertNil([numbers twt_concurrentDetectWithBlock:noMatchBlock], @"Detect without a match is not nil");
+    XCTAssertNil([numbers twt_concurrentDetectAnyWithBlock:noMatchBlock], @"Detect any without a match is not nil");
+    XCTAssertNil([[NSSet setWithArray:numbers] twt_concurrentDetectWithBlock:noMatchBlock], @"Set detect without a match is not nil");
+}
+
+
+- (void)testConcurrentDetectAny
+{
+    NSUInteger count = [self randomConcurrentCount];
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    NSUInteger modulus = random() % 100 + 2;
+    TWTBlockEnumerationPredicateBlock block = ^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue % modulus == 1;
+    };
+
+    for (Class collectionClass in [self collectionClasses]) {
+        id collection = [[collectionClass alloc] initWithArray:numbers];
+        NSNumber *match = [collection twt_concurrentDetectAnyWithBlock:block];
+        XCTAssertNotNil(match, @"No match found for %@", collectionClass);
+        XCTAssertTrue(block(match), @"Detected element does not match for %@", collectionClass);
+    }
+
+    NSNumber *setMatch = [[NSSet setWithArray:numbers] twt_concurrentDetectWithBlock:block];
+    XCTAssertTrue(setMatch && block(setMatch), @"Set detect does not return a match");
+
+    NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] initWithCapacity:count];
+    for (NSNumber *number in numbers) {
+        dictionary[number] = @(number.unsignedIntegerValue * 2);
+    }
+
+    NSNumber *value = [dictionary twt_concurrentDetectWithBlock:block];
+    XCTAssertNotNil(value, @"No match found for dictionary");
+    XCTAssertTrue(block(@(value.unsignedIntegerValue / 2)), @"Dictionary detect does not return the matching key’s value");
+}
+
+
+- (void)testConcurrentDetectStopsEarly
+{
+    NSUInteger count = kTWTConcurrentBlockEnumerationSerialThreshold * 64;
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    NSUInteger firstMatch = random() % kTWTConcurrentBlockEnumerationSerialThreshold;
+    __block NSUInteger invocationCount = 0;
+    NSObject *countLock = [[NSObject alloc] init];
+
+    NSNumber *match = [numbers twt_concurrentDetectWithBlock:^BOOL(NSNumber *element) {
+        @synchronized (countLock) {
+            ++invocationCount;
+        }
+
+        return element.unsignedIntegerValue == firstMatch;
+    }];
+
+    XCTAssertEqualObjects(match, @(firstMatch), @"Incorrect match");
+    XCTAssertLessThan(invocationCount, count / 2, @"Workers did not stop after a match was found");
+}
+
+
+- (void)testConcurrentGroupMatchesSerialGroup
+{
+    for (NSUInteger count = random() % 16; count < kTWTConcurrentBlockEnumerationSerialThreshold * 8; count = count * 4 + 1) {
+        NSArray *numbers = [self randomNumberArrayWithCount:count];
+        NSUInteger modulus = random() % 1000 + 2;
+        TWTBlockEnumerationGroupBlock block = ^id<NSCopying>(NSNumber *element) {
+            // Return nil for some elements to make sure they are grouped under NSNull
+            NSUInteger key = element.unsignedIntegerValue % modulus;
+            return key == 1 ? nil : @(key);
+        };
+
+        for (Class collectionClass in [self collectionClasses]) {
+            id collection = [[collectionClass alloc] initWithArray:numbers];
+            XCTAssertEqualObjects([collection twt_concurrentGroupWithBlock:block], [collection twt_groupWithBlock:block],
+                                  @"Concurrent group does not match serial group for %@ of %lu", collectionClass, (unsigned long)count);
+        }
+
+        XCTAssertEqualObjects([numbers.objectEnumerator twt_concurrentGroupWithBlock:block], [numbers twt_groupWithBlock:block],
+                              @"Concurrent group does not match serial group for enumerator");
+    }
+}
+
+
+- (void)testConcurrentGroupPreservesOrderWithinGroups
+{
+    NSUInteger count = [self randomConcurrentCount];
+    NSUInteger groupCount = random() % 100 + 1;
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    NSDictionary *groups = [numbers twt_concurrentGroupWithBlock:^id<NSCopying>(NSNumber *element) {
+        return @(element.unsignedIntegerValue % groupCount);
+    }];
+
+    XCTAssertEqual(groups.count, MIN(groupCount, count), @"Incorrect number of groups");
+    [groups enumerateKeysAndObjectsUsingBlock:^(NSNumber *groupKey, NSArray *group, BOOL *stop) {
+        for (NSUInteger i = 0; i < group.count; ++i) {
+            XCTAssertEqualObjects(group[i], @(groupKey.unsignedIntegerValue + i * groupCount), @"Group is out of order");
+        }
+    }];
+}
+
+
+- (void)testReduceMatchesInject
+{
+    for (NSUInteger count = random() % 16; count < kTWTConcurrentBlockEnumerationSerialThreshold * 8; count = count * 4 + 1) {
+        NSArray *numbers = [self randomNumberArrayWithCount:count];
+        TWTBlockEnumerationInjectBlock block = ^id(NSNumber *memo, NSNumber *element) {
+            return @(memo.longLongValue + element.longLongValue);
+        };
+
+        TWTBlockEnumerationCombineBlock combiner = ^id(NSNumber *partialResult, NSNumber *nextPartialResult) {
+            return @(partialResult.longLongValue + nextPartialResult.longLongValue);
+        };
+
+        id expectedSum = [numbers twt_injectWithInitialObject:@0 block:block];
+        for (Class collectionClass in [self collectionClasses]) {
+            id collection = [[collectionClass alloc] initWithArray:numbers];
+            XCTAssertEqualObjects([collection twt_reduceWithIdentity:@0 block:block combiner:combiner],
+                                  [collection twt_injectWithInitialObject:@0 block:block],
+                                  @"Reduce does not match inject for %@ of %lu", collectionClass, (unsigned long)count);
+        }
+
+        XCTAssertEqualObjects([numbers.objectEnumerator twt_reduceWithIdentity:@0 block:block combiner:combiner], expectedSum,
+                              @"Reduce does not match inject for enumerator");
+    }
+}
+
+
+- (void)testReducePreservesOrder
+{
+    // String concatenation is associative but not commutative, so any misordering of partial results shows up
+    NSArray *strings = UMKGeneratedArrayWithElementCount([self randomConcurrentCount], ^id(NSUInteger index) {
+        return [NSString stringWithFormat:@"%lu,", (unsigned long)index];
+    });
+
+    NSString *result = [strings twt_reduceWithIdentity:@"" block:^id(NSString *memo, NSString *element) {
+        return [memo stringByAppendingString:element];
+    } combiner:^id(NSString *partialResult, NSString *nextPartialResult) {
+        return [partialResult stringByAppendingString:nextPartialResult];
+    }];
+
+    XCTAssertEqualObjects(result, [strings componentsJoinedByString:@""], @"Partial results were combined out of order");
+
+    NSMutableArray *accumulatedStrings = [strings twt_reduceWithAccumulatorBlock:^id{
+        return [[NSMutableArray alloc] init];
+    } block:^(NSMutableArray *accumulator, NSString *element) {
+        [accumulator addObject:element];
+    } merger:^(NSMutableArray *accumulator, NSMutableArray *nextAccumulator) {
+        [accumulator addObjectsFromArray:nextAccumulator];
+    }];
+
+    XCTAssertEqualObjects(accumulatedStrings, strings, @"Accumulators were merged out of order");
+}
+
+
+- (void)testReduceWithAccumulatorBlock
+{
+    for (NSUInteger count = random() % 16; count < kTWTConcurrentBlockEnumerationSerialThreshold * 8; count = count * 4 + 1) {
+        NSArray *numbers = [self randomNumberArrayWithCount:count];
+        NSUInteger modulus = random() % 1000 + 1;
+        __block NSUInteger accumulatorCount = 0;
+        NSObject *countLock = [[NSObject alloc] init];
+
+        TWTBlockEnumerationAccumulatorBlock accumulatorBlock = ^id{
+            @synchronized (countLock) {
+                ++accumulatorCount;
+            }
+
+            return [[NSMutableSet alloc] init];
+        };
+
+        TWTBlockEnumerationAccumulateBlock block = ^(NSMutableSet *accumulator, NSNumber *element) {
+            [accumulator addObject:@(element.unsignedIntegerValue % modulus)];
+        };
+
+        TWTBlockEnumerationMergeBlock merger = ^(NSMutableSet *accumulator, NSMutableSet *nextAccumulator) {
+            [accumulator unionSet:nextAccumulator];
+        };
+
+        NSSet *expectedResult = [NSSet setWithArray:[numbers twt_collectWithBlock:^id(NSNumber *element) {
+            return @(element.unsignedIntegerValue % modulus);
+        }]];
+
+        for (Class collectionClass in [self collectionClasses]) {
+            id collection = [[collectionClass alloc] initWithArray:numbers];
+            accumulatorCount = 0;
+            XCTAssertEqualObjects([collection twt_reduceWithAccumulatorBlock:accumulatorBlock block:block merger:merger], expectedResult,
+                                  @"Accumulated result is incorrect for %@ of %lu", collectionClass, (unsigned long)count);
+            XCTAssertLessThanOrEqual(accumulatorCount, [collection count] / 1024 + 1, @"Accumulator was created per element");
+        }
+
+        XCTAssertEqualObjects([numbers.objectEnumerator twt_reduceWithAccumulatorBlock:accumulatorBlock block:block merger:merger],
+                              expectedResult, @"Accumulated result is incorrect for enumerator");
+    }
+}
+
+
+- (void)testConcurrentSelectAndRejectMatchSerial
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:[self randomConcurrentCount]];
+    NSUInteger modulus = random() % 8 + 2;
+    TWTBlockEnumerationPredicateBlock block = ^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue % modulus == 0;
+    };
+
+    for (Class collectionClass in [self collectionClasses]) {
+        id collection = [[collectionClass alloc] initWithArray:numbers];
+        XCTAssertEqualObjects([collection twt_concurrentSelectWithBlock:block], [collection twt_selectWithBlock:block],
+                              @"Concurrent select does not match serial select for %@", collectionClass);
+        XCTAssertEqualObjects([collection twt_concurrentRejectWithBlock:block], [collection twt_rejectWithBlock:block],
+                              @"Concurrent reject does not match serial reject for %@", collectionClass);
+    }
+
+    XCTAssertEqualObjects([numbers.objectEnumerator twt_concurrentSelectWithBlock:block], [numbers twt_selectWithBlock:block],
+                          @"Concurrent select does not match serial select for enumerator");
+}
+
+
+- (void)testConcurrentDictionaryEnumeration
+{
+    NSUInteger count = [self randomConcurrentCount];
+    NSMutableDictionary *dictionary = [[NSMutableDictionary alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        dictionary[@(i)] = UMKRandomAlphanumericString();
+    }
+
+    TWTBlockEnumerationCollectBlock collectBlock = ^id(NSNumber *key) {
+        return @(key.integerValue * 2);
+    };
+
+    TWTBlockEnumerationPredicateBlock selectBlock = ^BOOL(NSNumber *key) {
+        return key.integerValue % 3 == 0;
+    };
+
+    XCTAssertEqualObjects([dictionary twt_concurrentCollectWithBlock:collectBlock], [dictionary twt_collectWithBlock:collectBlock],
+                          @"Concurrent collect does not match serial collect");
+    TWTBlockEnumerationGroupBlock groupBlock = ^id<NSCopying>(NSNumber *key) {
+        return @(key.integerValue % 5);
+    };
+
+    XCTAssertEqualObjects([dictionary twt_concurrentGroupWithBlock:groupBlock], [dictionary twt_groupWithBlock:groupBlock],
+                          @"Concurrent group does not match serial group");
+    XCTAssertEqualObjects([dictionary twt_concurrentSelectWithBlock:selectBlock], [dictionary twt_selectWithBlock:selectBlock],
+                          @"Concurrent select does not match serial select");
+    XCTAssertEqualObjects([dictionary twt_concurrentRejectWithBlock:selectBlock], [dictionary twt_rejectWithBlock:selectBlock],
+                          @"Concurrent reject does not match serial reject");
+}
+
+
+- (void)testSmallInputsAreEnumeratedSerially
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:random() % (kTWTConcurrentBlockEnumerationSerialThreshold - 1) + 1];
+    NSThread *callingThread = [NSThread currentThread];
+
+    [numbers twt_concurrentCollectWithBlock:^id(id element) {
+        XCTAssertEqualObjects([NSThread currentThread], callingThread, @"Small input was not enumerated on the calling thread");
+        return element;
+    }];
+}
+
+
+#pragma mark - Performance
+
+- (TWTBlockEnumerationCollectBlock)expensiveCollectBlock
+{
+    return ^id(NSNumber *element) {
+        double value = element.doubleValue;
+        for (NSUInteger i = 0; i < 100; ++i) {
+            value = sqrt(value + i);
+        }
+
+        return @(value);
+    };
+}
+
+
+- (void)testCollectPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+    TWTBlockEnumerationCollectBlock block = [self expensiveCollectBlock];
+
+    [self measureBlock:^{
+        [numbers twt_collectWithBlock:block];
+    }];
+}
+
+
+- (void)testConcurrentCollectPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+    TWTBlockEnumerationCollectBlock block = [self expensiveCollectBlock];
+
+    [self measureBlock:^{
+        [numbers twt_concurrentCollectWithBlock:block];
+    }];
+}
+
+
+- (TWTBlockEnumerationPredicateBlock)expensivePredicateBlockMatchingFromIndex:(NSUInteger)firstMatch
+{
+    return ^BOOL(NSNumber *element) {
+        double value = element.doubleValue;
+        for (NSUInteger i = 0; i < 100; ++i) {
+            value = sqrt(value + i);
+        }
+
+        return value > 0 && element.unsignedIntegerValue >= firstMatch;
+    };
+}
+
+
+- (void)testDetectPerformance
+{
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(50000, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    TWTBlockEnumerationPredicateBlock block = [self expensivePredicateBlockMatchingFromIndex:numbers.count * 3 / 4];
+    [self measureBlock:^{
+        [numbers twt_detectWithBlock:block];
+    }];
+}
+
+
+- (void)testConcurrentDetectPerformance
+{
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(50000, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    TWTBlockEnumerationPredicateBlock block = [self expensivePredicateBlockMatchingFromIndex:numbers.count * 3 / 4];
+    [self measureBlock:^{
+        [numbers twt_concurrentDetectWithBlock:block];
+    }];
+}
+
+
+- (void)testConcurrentDetectAnyPerformance
+{
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(50000, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    TWTBlockEnumerationPredicateBlock block = [self expensivePredicateBlockMatchingFromIndex:numbers.count * 3 / 4];
+    [self measureBlock:^{
+        [numbers twt_concurrentDetectAnyWithBlock:block];
+    }];
+}
+
+
+/*!
+ Measures grouping 2x10^5 random numbers by their remainders modulo keyCount, either serially or concurrently. Few 
+ keys make a few large groups, while many keys make the per-worker partial group maps and their merge expensive. 
+ With 10^6 possible keys, most elements are in a group of their own.
+ */
+- (void)measureGroupWithKeyCount:(NSUInteger)keyCount concurrent:(BOOL)concurrent
+{
+    // Draw from the full range of random() so that every key is possible
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(200000, ^id(NSUInteger index) {
+        return @(random());
+    });
+
+    TWTBlockEnumerationGroupBlock block = ^id<NSCopying>(NSNumber *element) {
+        return @(element.unsignedIntegerValue % keyCount);
+    };
+
+    [self measureBlock:^{
+        if (concurrent) {
+            [numbers twt_concurrentGroupWithBlock:block];
+        } else {
+            [numbers twt_groupWithBlock:block];
+        }
+    }];
+}
+
+
+- (void)testGroupWith10KeysPerformance
+{
+    [self measureGroupWithKeyCount:10 concurrent:NO];
+}
+
+
+- (void)testConcurrentGroupWith10KeysPerformance
+{
+    [self measureGroupWithKeyCount:10 concurrent:YES];
+}
+
+
+- (void)testGroupWith1000KeysPerformance
+{
+    [self measureGroupWithKeyCount:1000 concurrent:NO];
+}
+
+
+- (void)testConcurrentGroupWith1000KeysPerformance
+{
+    [self measureGroupWithKeyCount:1000 concurrent:YES];
+}
+
+
+- (void)testGroupWith100000KeysPerformance
+{
+    [self measureGroupWithKeyCount:100000 concurrent:NO];
+}
+
+
+- (void)testConcurrentGroupWith100000KeysPerformance
+{
+    [self measureGroupWithKeyCount:100000 concurrent:YES];
+}
+
+
+- (void)testGroupWith1000000KeysPerformance
+{
+    [self measureGroupWithKeyCount:1000000 concurrent:NO];
+}
+
+
+- (void)testConcurrentGroupWith1000000KeysPerformance
+{
+    [self measureGroupWithKeyCount:1000000 concurrent:YES];
+}
+
+
+- (void)testInjectSumPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+
+    [self measureBlock:^{
+        [numbers twt_injectWithInitialObject:@0 block:^id(NSNumber *memo, NSNumber *element) {
+            return @(memo.longLongValue + element.longLongValue);
+        }];
+    }];
+}
+
+
+- (void)testReduceSumPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+
+    [self measureBlock:^{
+        [numbers twt_reduceWithIdentity:@0 block:^id(NSNumber *memo, NSNumber *element) {
+            return @(memo.longLongValue + element.longLongValue);
+        } combiner:^id(NSNumber *partialResult, NSNumber *nextPartialResult) {
+            return @(partialResult.longLongValue + nextPartialResult.longLongValue);
+        }];
+    }];
+}
+
+
+- (void)testInjectUnionPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:20000];
+
+    [self measureBlock:^{
+        [numbers twt_injectWithInitialObject:[NSSet set] block:^id(NSSet *memo, NSNumber *element) {
+            return [memo setByAddingObject:@(element.integerValue % 100)];
+        }];
+    }];
+}
+
+
+- (void)testAccumulatorUnionPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:20000];
+
+    [self measureBlock:^{
+        [numbers twt_reduceWithAccumulatorBlock:^id{
+            return [[NSMutableSet alloc] init];
+        } block:^(NSMutableSet *accumulator, NSNumber *element) {
+            [accumulator addObject:@(element.integerValue % 100)];
+        } merger:^(NSMutableSet *accumulator, NSMutableSet *nextAccumulator) {
+            [accumulator unionSet:nextAccumulator];
+        }];
+    }];
+}
+
+@end
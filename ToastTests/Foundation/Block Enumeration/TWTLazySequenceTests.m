@@ -0,0 +1,298 @@
+//
+//  TWTLazySequenceTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import <URLMock/UMKTestUtilities.h>
+
+#import "TWTLazySequence.h"
+
+
+@interface TWTLazySequenceTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTLazySequenceTests
+
+#pragma mark - Helpers
+
+- (NSArray *)randomNumberArrayWithCount:(NSUInteger)count
+{
+    return UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(random() % 100000);
+    });
+}
+
+
+#pragma mark - Tests
+
+- (void)testInit
+{
+    XCTAssertThrows([[TWTLazySequence alloc] initWithCollection:nil], @"nil collection does not throw");
+
+    NSArray *array = [self randomNumberArrayWithCount:random() % 100];
+    TWTLazySequence *sequence = [[TWTLazySequence alloc] initWithCollection:array];
+    XCTAssertNotNil(sequence, @"returns nil");
+    XCTAssertEqualObjects(sequence.allObjects, array, @"allObjects does not match collection");
+    XCTAssertEqual(sequence.count, array.count, @"count does not match collection");
+}
+
+
+- (void)testChainedOperationsMatchEagerOperations
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:random() % 1000 + 1];
+    NSUInteger modulus = random() % 8 + 2;
+
+    TWTBlockEnumerationPredicateBlock selectBlock = ^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue % modulus == 0;
+    };
+
+    TWTBlockEnumerationCollectBlock collectBlock = ^id(NSNumber *element) {
+        // Return nil for some elements to make sure they become NSNull
+        return element.integerValue % 7 == 0 ? nil : @(element.integerValue * 3);
+    };
+
+    TWTBlockEnumerationPredicateBlock rejectBlock = ^BOOL(id element) {
+        return [element isEqual:[NSNull null]];
+    };
+
+    NSArray *eagerResults = [[[numbers twt_selectWithBlock:selectBlock] twt_collectWithBlock:collectBlock] twt_rejectWithBlock:rejectBlock];
+    TWTLazySequence *sequence = [[[numbers.twt_lazySequence selectWithBlock:selectBlock] collectWithBlock:collectBlock] rejectWithBlock:rejectBlock];
+
+    XCTAssertEqualObjects(sequence.allObjects, eagerResults, @"Lazy results do not match eager results");
+    XCTAssertEqual(sequence.count, eagerResults.count, @"count does not match eager results");
+    XCTAssertEqualObjects(sequence.firstObject, eagerResults.firstObject, @"firstObject does not match eager results");
+
+    // Sequences re-evaluate from the beginning each time
+    XCTAssertEqualObjects(sequence.allObjects, eagerResults, @"Second evaluation does not match eager results");
+
+    id eagerSum = [eagerResults twt_injectWithInitialObject:@0 block:^id(NSNumber *memo, NSNumber *element) {
+        return @(memo.integerValue + element.integerValue);
+    }];
+
+    id lazySum = [sequence injectWithInitialObject:@0 block:^id(NSNumber *memo, NSNumber *element) {
+        return @(memo.integerValue + element.integerValue);
+    }];
+
+    XCTAssertEqualObjects(lazySum, eagerSum, @"inject does not match eager results");
+}
+
+
+- (void)testOperationsAreDeferredUntilTerminalOperation
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:random() % 100 + 1];
+    __block NSUInteger invocationCount = 0;
+
+    TWTLazySequence *sequence = [[numbers.twt_lazySequence selectWithBlock:^BOOL(id element) {
+        ++invocationCount;
+        return YES;
+    }] collectWithBlock:^id(id element) {
+        ++invocationCount;
+        return element;
+    }];
+
+    XCTAssertEqual(invocationCount, 0, @"Blocks were invoked before a terminal operation");
+
+    [sequence allObjects];
+    XCTAssertEqual(invocationCount, numbers.count * 2, @"Blocks were not invoked once per element");
+}
+
+
+- (void)testOperationsAreFused
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:random() % 100 + 10];
+    NSMutableArray *events = [[NSMutableArray alloc] init];
+
+    [[[numbers.twt_lazySequence selectWithBlock:^BOOL(id element) {
+        [events addObject:@"select"];
+        return YES;
+    }] collectWithBlock:^id(id element) {
+        [events addObject:@"collect"];
+        return element;
+    }] allObjects];
+
+    // Each element passes through every stage before the next element is read
+    for (NSUInteger i = 0; i < events.count; i += 2) {
+        XCTAssertEqualObjects(events[i], @"select", @"Stages were not interleaved");
+        XCTAssertEqualObjects(events[i + 1], @"collect", @"Stages were not interleaved");
+    }
+}
+
+
+- (void)testShortCircuiting
+{
+    NSUInteger count = random() % 1000 + 100;
+    NSUInteger targetIndex = random() % (count / 2);
+    NSArray *numbers = UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(index);
+    });
+
+    __block NSUInteger selectCount = 0;
+    __block NSUInteger collectCount = 0;
+    TWTLazySequence *sequence = [[numbers.twt_lazySequence selectWithBlock:^BOOL(NSNumber *element) {
+        ++selectCount;
+        return element.unsignedIntegerValue >= targetIndex;
+    }] collectWithBlock:^id(NSNumber *element) {
+        ++collectCount;
+        return @(element.unsignedIntegerValue * 2);
+    }];
+
+    XCTAssertEqualObjects(sequence.firstObject, @(targetIndex * 2), @"firstObject is incorrect");
+    XCTAssertEqual(selectCount, targetIndex + 1, @"Enumeration did not stop at the first selected element");
+    XCTAssertEqual(collectCount, 1, @"Collect block was invoked more than once");
+
+    selectCount = 0;
+    NSNumber *detectedObject = [sequence detectWithBlock:^BOOL(NSNumber *element) {
+        return element.unsignedIntegerValue == (targetIndex + 1) * 2;
+    }];
+
+    XCTAssertEqualObjects(detectedObject, @((targetIndex + 1) * 2), @"detected object is incorrect");
+    XCTAssertEqual(selectCount, targetIndex + 2, @"Enumeration did not stop at the detected element");
+    XCTAssertNil([sequence detectWithBlock:^BOOL(id element) { return NO; }], @"detect without a match is not nil");
+
+    __block NSUInteger enumerationCount = 0;
+    [numbers.twt_lazySequence enumerateObjectsUsingBlock:^(id object, BOOL *stop) {
+        *stop = ++enumerationCount == targetIndex + 1;
+    }];
+
+    XCTAssertEqual(enumerationCount, targetIndex + 1, @"Enumeration did not stop when requested");
+}
+
+
+- (void)testTake
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:random() % 100 + 10];
+    NSUInteger takeCount = random() % numbers.count;
+
+    __block NSUInteger readCount = 0;
+    TWTLazySequence *sequence = [[numbers.twt_lazySequence collectWithBlock:^id(id element) {
+        ++readCount;
+        return element;
+    }] take:takeCount];
+
+    XCTAssertEqualObjects(sequence.allObjects, [numbers subarrayWithRange:NSMakeRange(0, takeCount)], @"take returns incorrect objects");
+    XCTAssertLessThanOrEqual(readCount, MAX(takeCount, 1), @"take read more elements than necessary");
+
+    XCTAssertEqualObjects([numbers.twt_lazySequence take:numbers.count * 2].allObjects, numbers, @"take beyond count is incorrect");
+    XCTAssertEqual([sequence take:takeCount + 1].count, takeCount, @"take of take is incorrect");
+}
+
+
+- (void)testCollectionClasses
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:random() % 100 + 1];
+    TWTBlockEnumerationPredicateBlock block = ^BOOL(NSNumber *element) {
+        return element.integerValue % 2 == 0;
+    };
+
+    NSSet *set = [NSSet setWithArray:numbers];
+    XCTAssertEqualObjects([NSSet setWithArray:[set.twt_lazySequence selectWithBlock:block].allObjects], [set twt_selectWithBlock:block],
+                          @"Set results are incorrect");
+
+    NSOrderedSet *orderedSet = [NSOrderedSet orderedSetWithArray:numbers];
+    XCTAssertEqualObjects([orderedSet.twt_lazySequence selectWithBlock:block].allObjects, [orderedSet twt_selectWithBlock:block].array,
+                          @"Ordered set results are incorrect");
+
+    XCTAssertEqualObjects([numbers.objectEnumerator.twt_lazySequence selectWithBlock:block].allObjects, [numbers twt_selectWithBlock:block],
+                          @"Enumerator results are incorrect");
+
+    NSDictionary *dictionary = [NSDictionary dictionaryWithObjects:numbers forKeys:numbers];
+    XCTAssertEqualObjects([NSSet setWithArray:[dictionary.twt_lazySequence selectWithBlock:block].allObjects],
+                          [NSSet setWithArray:[dictionary twt_selectWithBlock:block].allKeys], @"Dictionary results are incorrect");
+}
+
+
+#pragma mark - Performance
+
+- (TWTBlockEnumerationPredicateBlock)selectBlock
+{
+    return ^BOOL(NSNumber *element) {
+        return element.integerValue % 3 != 0;
+    };
+}
+
+
+- (TWTBlockEnumerationCollectBlock)collectBlock
+{
+    return ^id(NSNumber *element) {
+        return @(element.integerValue + 1);
+    };
+}
+
+
+- (void)testEagerSelectCollectDetectPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+    TWTBlockEnumerationPredicateBlock selectBlock = [self selectBlock];
+    TWTBlockEnumerationCollectBlock collectBlock = [self collectBlock];
+
+    [self measureBlock:^{
+        [[[numbers twt_selectWithBlock:selectBlock] twt_collectWithBlock:collectBlock] twt_detectWithBlock:^BOOL(NSNumber *element) {
+            return element.integerValue > 99000;
+        }];
+    }];
+}
+
+
+- (void)testLazySelectCollectDetectPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+    TWTBlockEnumerationPredicateBlock selectBlock = [self selectBlock];
+    TWTBlockEnumerationCollectBlock collectBlock = [self collectBlock];
+
+    [self measureBlock:^{
+        [[[numbers.twt_lazySequence selectWithBlock:selectBlock] collectWithBlock:collectBlock] detectWithBlock:^BOOL(NSNumber *element) {
+            return element.integerValue > 99000;
+        }];
+    }];
+}
+
+
+- (void)testEagerSelectCollectPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+    TWTBlockEnumerationPredicateBlock selectBlock = [self selectBlock];
+    TWTBlockEnumerationCollectBlock collectBlock = [self collectBlock];
+
+    [self measureBlock:^{
+        [[numbers twt_selectWithBlock:selectBlock] twt_collectWithBlock:collectBlock];
+    }];
+}
+
+
+- (void)testLazySelectCollectPerformance
+{
+    NSArray *numbers = [self randomNumberArrayWithCount:50000];
+    TWTBlockEnumerationPredicateBlock selectBlock = [self selectBlock];
+    TWTBlockEnumerationCollectBlock collectBlock = [self collectBlock];
+
+    [self measureBlock:^{
+        [[[numbers.twt_lazySequence selectWithBlock:selectBlock] collectWithBlock:collectBlock] allObjects];
+    }];
+}
+
+@end
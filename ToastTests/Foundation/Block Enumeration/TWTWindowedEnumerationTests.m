@@ -0,0 +1,196 @@
+//
+//  TWTWindowedEnumerationTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import <URLMock/UMKTestUtilities.h>
+
+#import "TWTWindowedEnumeration.h"
+
+
+@interface TWTWindowedEnumerationTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTWindowedEnumerationTests
+
+#pragma mark - Helpers
+
+- (NSArray *)randomNumberArrayWithCount:(NSUInteger)count
+{
+    return UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @(index * 100000 + random() % 100000);
+    });
+}
+
+
+- (NSArray *)expectedChunksOfArray:(NSArray *)array size:(NSUInteger)size
+{
+    NSMutableArray *chunks = [[NSMutableArray alloc] init];
+    for (NSUInteger location = 0; location < array.count; location += size) {
+        [chunks addObject:[array subarrayWithRange:NSMakeRange(location, MIN(size, array.count - location))]];
+    }
+
+    return chunks;
+}
+
+
+- (NSArray *)expectedSlidingWindowsOfArray:(NSArray *)array size:(NSUInteger)size
+{
+    NSMutableArray *windows = [[NSMutableArray alloc] init];
+    for (NSUInteger location = 0; location + size <= array.count; ++location) {
+        [windows addObject:[array subarrayWithRange:NSMakeRange(location, size)]];
+    }
+
+    return windows;
+}
+
+
+#pragma mark - Tests
+
+- (void)testChunksOfSize
+{
+    NSArray *array = [self randomNumberArrayWithCount:random() % 100];
+    NSUInteger size = random() % 10 + 1;
+    NSArray *expectedChunks = [self expectedChunksOfArray:array size:size];
+
+    XCTAssertEqualObjects([[array twt_chunksOfSize:size] allObjects], expectedChunks, @"Array chunks are incorrect");
+    XCTAssertEqualObjects([[[NSOrderedSet orderedSetWithArray:array] twt_chunksOfSize:size] allObjects], expectedChunks,
+                          @"Ordered set chunks are incorrect");
+    XCTAssertEqualObjects([[[array objectEnumerator] twt_chunksOfSize:size] allObjects], expectedChunks,
+                          @"Enumerator chunks are incorrect");
+
+    // Unordered collections have no defined order, but should be chunked in their enumeration order
+    NSSet *set = [NSSet setWithArray:array];
+    XCTAssertEqualObjects([[set twt_chunksOfSize:size] allObjects], [self expectedChunksOfArray:set.allObjects size:size],
+                          @"Set chunks are incorrect");
+
+    NSDictionary *dictionary = [NSDictionary dictionaryWithObjects:array forKeys:array];
+    NSArray *keys = [[dictionary keyEnumerator] allObjects];
+    XCTAssertEqualObjects([[dictionary twt_chunksOfSize:size] allObjects], [self expectedChunksOfArray:keys size:size],
+                          @"Dictionary chunks are incorrect");
+
+    XCTAssertThrows([array twt_chunksOfSize:0], @"Size of 0 does not throw");
+    XCTAssertThrows([[array objectEnumerator] twt_chunksOfSize:0], @"Size of 0 does not throw");
+}
+
+
+- (void)testSlidingWindowOfSize
+{
+    NSArray *array = [self randomNumberArrayWithCount:random() % 100];
+    NSUInteger size = random() % 10 + 1;
+    NSArray *expectedWindows = [self expectedSlidingWindowsOfArray:array size:size];
+
+    XCTAssertEqualObjects([[array twt_slidingWindowOfSize:size] allObjects], expectedWindows, @"Array windows are incorrect");
+    XCTAssertEqualObjects([[[NSOrderedSet orderedSetWithArray:array] twt_slidingWindowOfSize:size] allObjects], expectedWindows,
+                          @"Ordered set windows are incorrect");
+    XCTAssertEqualObjects([[[array objectEnumerator] twt_slidingWindowOfSize:size] allObjects], expectedWindows,
+                          @"Enumerator windows are incorrect");
+
+    NSSet *set = [NSSet setWithArray:array];
+    XCTAssertEqualObjects([[set twt_slidingWindowOfSize:size] allObjects], [self expectedSlidingWindowsOfArray:set.allObjects size:size],
+                          @"Set windows are incorrect");
+
+    NSArray *shortArray = [self randomNumberArrayWithCount:size - 1];
+    XCTAssertEqualObjects([[shortArray twt_slidingWindowOfSize:size] allObjects], @[ ], @"Array shorter than size has windows");
+    XCTAssertEqualObjects([[[shortArray objectEnumerator] twt_slidingWindowOfSize:size] allObjects], @[ ],
+                          @"Enumerator shorter than size has windows");
+}
+
+
+- (void)testWindowsAreViewsOfArray
+{
+    NSMutableArray *array = [[self randomNumberArrayWithCount:random() % 100 + 10] mutableCopy];
+    NSUInteger size = random() % 5 + 2;
+
+    NSArray *chunk = [[array twt_chunksOfSize:size] nextObject];
+    NSArray *window = [[array twt_slidingWindowOfSize:size] nextObject];
+    XCTAssertEqual(chunk.count, size, @"Chunk has wrong count");
+    XCTAssertEqual(window.count, size, @"Window has wrong count");
+    XCTAssertEqualObjects(chunk[size - 1], array[size - 1], @"Chunk has wrong last object");
+    XCTAssertThrows(chunk[size], @"Index beyond chunk does not throw");
+
+    // Replacing an object in the array should be visible through the views, since they are not copies
+    NSNumber *replacement = @(-1);
+    array[0] = replacement;
+    XCTAssertEqualObjects(chunk[0], replacement, @"Chunk is not a view of the array");
+    XCTAssertEqualObjects(window[0], replacement, @"Window is not a view of the array");
+
+    // Copies of views should be independent
+    NSArray *chunkCopy = [chunk copy];
+    array[0] = @(-2);
+    XCTAssertEqualObjects(chunkCopy[0], replacement, @"Copy of chunk is still a view of the array");
+}
+
+
+- (void)testZipWith
+{
+    NSArray *array = [self randomNumberArrayWithCount:random() % 100];
+    NSArray *otherArray = [self randomNumberArrayWithCount:random() % 100];
+    NSUInteger pairCount = MIN(array.count, otherArray.count);
+
+    NSMutableArray *expectedPairs = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < pairCount; ++i) {
+        [expectedPairs addObject:@[ array[i], otherArray[i] ]];
+    }
+
+    XCTAssertEqualObjects([[array twt_zipWith:otherArray] allObjects], expectedPairs, @"Array pairs are incorrect");
+    XCTAssertEqualObjects([[array twt_zipWith:[otherArray objectEnumerator]] allObjects], expectedPairs,
+                          @"Array and enumerator pairs are incorrect");
+    XCTAssertEqualObjects([[[array objectEnumerator] twt_zipWith:[NSOrderedSet orderedSetWithArray:otherArray]] allObjects], expectedPairs,
+                          @"Enumerator and ordered set pairs are incorrect");
+    XCTAssertEqualObjects([[[NSOrderedSet orderedSetWithArray:array] twt_zipWith:otherArray] allObjects], expectedPairs,
+                          @"Ordered set pairs are incorrect");
+
+    // Dictionaries contribute their keys
+    NSDictionary *dictionary = [NSDictionary dictionaryWithObjects:otherArray forKeys:otherArray];
+    NSArray *keys = [[dictionary keyEnumerator] allObjects];
+    NSArray *pairs = [[array twt_zipWith:dictionary] allObjects];
+    XCTAssertEqual(pairs.count, pairCount, @"Dictionary pairs have wrong count");
+    for (NSUInteger i = 0; i < pairCount; ++i) {
+        XCTAssertEqualObjects(pairs[i], (@[ array[i], keys[i] ]), @"Dictionary pair is incorrect");
+    }
+}
+
+
+- (void)testWindowsComposeWithBlockEnumeration
+{
+    NSArray *array = [self randomNumberArrayWithCount:random() % 1000 + 1];
+    NSUInteger size = random() % 50 + 1;
+
+    NSArray *chunkCounts = [[array twt_chunksOfSize:size] twt_collectWithBlock:^id(NSArray *chunk) {
+        return @(chunk.count);
+    }];
+
+    NSNumber *total = [chunkCounts twt_injectWithInitialObject:@0 block:^id(NSNumber *memo, NSNumber *count) {
+        return @(memo.unsignedIntegerValue + count.unsignedIntegerValue);
+    }];
+
+    XCTAssertEqualObjects(total, @(array.count), @"Chunks do not cover the array");
+}
+
+@end
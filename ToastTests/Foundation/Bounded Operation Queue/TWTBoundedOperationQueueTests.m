@@ -0,0 +1,173 @@
+//
+//  TWTBoundedOperationQueueTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTAsynchronousOperation.h"
+#import "TWTBoundedOperationQueue.h"
+
+
+@interface TWTBoundedOperationQueueTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTBoundedOperationQueueTests
+
+- (TWTAsynchronousOperation *)operationFinishedBySemaphore:(dispatch_semaphore_t)semaphore
+{
+    return [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+            dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+            [operation finishOperationExecution];
+        });
+    }];
+}
+
+
+- (void)testFailPolicyRejectsWhenFull
+{
+    NSUInteger capacity = random() % 8 + 1;
+    TWTBoundedOperationQueue *queue = [[TWTBoundedOperationQueue alloc] initWithCapacity:capacity
+                                                                          overflowPolicy:TWTBoundedOperationQueueOverflowPolicyFail];
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+
+    for (NSUInteger i = 0; i < capacity; ++i) {
+        XCTAssertTrue([queue addOperation:[self operationFinishedBySemaphore:semaphore] error:NULL], @"Operation was rejected below capacity");
+    }
+
+    NSError *error = nil;
+    XCTAssertFalse([queue addOperation:[self operationFinishedBySemaphore:semaphore] error:&error], @"Operation was admitted at capacity");
+    XCTAssertEqualObjects(error.domain, kTWTBoundedOperationQueueErrorDomain, @"Incorrect error domain");
+    XCTAssertEqual(error.code, TWTBoundedOperationQueueErrorFull, @"Incorrect error code");
+    XCTAssertEqual(queue.depth, capacity, @"Incorrect depth");
+    XCTAssertEqual(queue.rejectedOperationCount, 1, @"Incorrect rejected count");
+
+    for (NSUInteger i = 0; i < capacity; ++i) {
+        dispatch_semaphore_signal(semaphore);
+    }
+
+    [queue waitUntilAllOperationsAreFinished];
+    XCTAssertEqual(queue.depth, 0, @"Incorrect depth after finishing");
+    XCTAssertEqual(queue.highWaterMark, capacity, @"Incorrect high-water mark");
+}
+
+
+- (void)testBlockPolicyNeverExceedsCapacity
+{
+    NSUInteger capacity = random() % 4 + 1;
+    TWTBoundedOperationQueue *queue = [[TWTBoundedOperationQueue alloc] initWithCapacity:capacity
+                                                                          overflowPolicy:TWTBoundedOperationQueueOverflowPolicyBlock];
+
+    NSUInteger operationCount = capacity * (random() % 8 + 2);
+    __block NSInteger executingCount = 0;
+    __block NSInteger maximumExecutingCount = 0;
+    NSObject *countLock = [[NSObject alloc] init];
+
+    for (NSUInteger i = 0; i < operationCount; ++i) {
+        TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+            @synchronized (countLock) {
+                maximumExecutingCount = MAX(maximumExecutingCount, ++executingCount);
+            }
+
+            dispatch_after(dispatch_time(DISPATCH_TIME_NOW, NSEC_PER_MSEC), dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                @synchronized (countLock) {
+                    --executingCount;
+                }
+
+                [operation finishOperationExecution];
+            });
+        }];
+
+        XCTAssertTrue([queue addOperation:operation error:NULL], @"Blocking add failed");
+        XCTAssertLessThanOrEqual(queue.depth, capacity, @"Depth exceeded capacity");
+    }
+
+    [queue waitUntilAllOperationsAreFinished];
+    XCTAssertLessThanOrEqual(maximumExecutingCount, capacity, @"More operations than the capacity were outstanding");
+    XCTAssertEqual(queue.highWaterMark, capacity, @"Incorrect high-water mark");
+    XCTAssertEqual(queue.rejectedOperationCount, 0, @"Blocking queue rejected operations");
+}
+
+
+- (void)testDropOldestPolicyCancelsOldestPendingOperation
+{
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    operationQueue.suspended = YES;
+
+    NSUInteger capacity = random() % 8 + 2;
+    TWTBoundedOperationQueue *queue = [[TWTBoundedOperationQueue alloc] initWithCapacity:capacity
+                                                                          overflowPolicy:TWTBoundedOperationQueueOverflowPolicyDropOldest
+                                                                          operationQueue:operationQueue];
+
+    NSMutableArray *operations = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < capacity + 1; ++i) {
+        TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+            [operation finishOperationExecution];
+        }];
+
+        XCTAssertTrue([queue addOperation:operation error:NULL], @"Operation was rejected");
+        [operations addObject:operation];
+    }
+
+    XCTAssertTrue([operations.firstObject isCancelled], @"Oldest operation was not dropped");
+    XCTAssertFalse([operations.lastObject isCancelled], @"Newest operation was dropped");
+    XCTAssertEqual(queue.depth, capacity, @"Incorrect depth");
+    XCTAssertEqual(queue.droppedOperationCount, 1, @"Incorrect dropped count");
+
+    operationQueue.suspended = NO;
+    [queue waitUntilAllOperationsAreFinished];
+    [operationQueue waitUntilAllOperationsAreFinished];
+}
+
+
+- (void)testSpaceAvailableHandler
+{
+    TWTBoundedOperationQueue *queue = [[TWTBoundedOperationQueue alloc] initWithCapacity:1
+                                                                          overflowPolicy:TWTBoundedOperationQueueOverflowPolicyFail];
+    dispatch_semaphore_t finishSemaphore = dispatch_semaphore_create(0);
+    XCTAssertTrue([queue tryAddOperation:[self operationFinishedBySemaphore:finishSemaphore] spaceAvailableHandler:nil],
+                  @"Operation was rejected below capacity");
+
+    dispatch_semaphore_t handlerSemaphore = dispatch_semaphore_create(0);
+    XCTAssertFalse([queue tryAddOperation:[self operationFinishedBySemaphore:finishSemaphore] spaceAvailableHandler:^{
+        dispatch_semaphore_signal(handlerSemaphore);
+    }], @"Operation was admitted at capacity");
+
+    XCTAssertNotEqual(dispatch_semaphore_wait(handlerSemaphore, dispatch_time(DISPATCH_TIME_NOW, 50 * NSEC_PER_MSEC)), 0,
+                      @"Handler was invoked while the queue was full");
+
+    dispatch_semaphore_signal(finishSemaphore);
+    XCTAssertEqual(dispatch_semaphore_wait(handlerSemaphore, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)), 0,
+                   @"Handler was not invoked when space became available");
+    XCTAssertTrue([queue tryAddOperation:[self operationFinishedBySemaphore:finishSemaphore] spaceAvailableHandler:nil],
+                  @"Operation was rejected after space became available");
+
+    dispatch_semaphore_signal(finishSemaphore);
+    [queue waitUntilAllOperationsAreFinished];
+}
+
+@end
@@ -0,0 +1,302 @@
+//
+//  TWTFutureTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTFuture.h"
+
+
+@interface TWTFutureTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTFutureTests
+
+- (NSError *)randomError
+{
+    return [NSError errorWithDomain:UMKRandomUnicodeString() code:random() userInfo:nil];
+}
+
+
+- (void)testPromiseResolvesOnce
+{
+    TWTPromise *promise = [[TWTPromise alloc] init];
+    XCTAssertFalse(promise.future.isResolved, @"Future is resolved before promise is fulfilled");
+
+    id result = UMKRandomUnicodeString();
+    XCTAssertTrue([promise fulfillWithResult:result], @"Promise was not fulfilled");
+    XCTAssertFalse([promise rejectWithError:[self randomError]], @"Promise was resolved twice");
+    XCTAssertFalse([promise.future cancel], @"Resolved future was cancelled");
+
+    XCTAssertTrue(promise.future.isResolved, @"Future is not resolved");
+    XCTAssertEqualObjects(promise.future.result, result, @"Incorrect result");
+    XCTAssertNil(promise.future.error, @"Error is non-nil");
+}
+
+
+- (void)testMapAndFlatMap
+{
+    TWTPromise *promise = [[TWTPromise alloc] init];
+    NSInteger value = random() % 1024;
+
+    TWTFuture *future = [[promise.future map:^id(NSNumber *result, NSError *__autoreleasing *error) {
+        return @(result.integerValue * 2);
+    }] flatMap:^TWTFuture *(NSNumber *result) {
+        return [TWTFuture futureWithResult:@(result.integerValue + 1)];
+    }];
+
+    XCTAssertFalse(future.isResolved, @"Chained future resolved before its source");
+    [promise fulfillWithResult:@(value)];
+    XCTAssertEqualObjects(future.result, @(value * 2 + 1), @"Incorrect chained result");
+}
+
+
+- (void)testErrorsPropagateWithoutInvokingBlocks
+{
+    NSError *expectedError = [self randomError];
+    __block BOOL blockInvoked = NO;
+    __block NSError *observedError = nil;
+
+    TWTFuture *future = [[[[TWTFuture futureWithError:expectedError] map:^id(id result, NSError *__autoreleasing *error) {
+        blockInvoked = YES;
+        return result;
+    }] flatMap:^TWTFuture *(id result) {
+        blockInvoked = YES;
+        return nil;
+    }] then:^(id result, NSError *error) {
+        observedError = error;
+    }];
+
+    XCTAssertFalse(blockInvoked, @"Block invoked for failed future");
+    XCTAssertEqualObjects(observedError, expectedError, @"then: did not receive the error");
+    XCTAssertEqualObjects(future.error, expectedError, @"Error did not propagate");
+
+    // Errors returned by map: blocks fail the mapped future
+    TWTFuture *mappedFuture = [[TWTFuture futureWithResult:@1] map:^id(id result, NSError *__autoreleasing *error) {
+        *error = expectedError;
+        return nil;
+    }];
+
+    XCTAssertEqualObjects(mappedFuture.error, expectedError, @"map: error was not propagated");
+}
+
+
+- (void)testCancellationPropagates
+{
+    TWTPromise *promise = [[TWTPromise alloc] init];
+    TWTFuture *mappedFuture = [promise.future map:^id(id result, NSError *__autoreleasing *error) {
+        return result;
+    }];
+
+    XCTAssertTrue([promise.future cancel], @"Pending future was not cancelled");
+    XCTAssertTrue(mappedFuture.isCancelled, @"Cancellation did not propagate to derived future");
+    XCTAssertEqualObjects(mappedFuture.error.domain, kTWTFutureErrorDomain, @"Incorrect error domain");
+    XCTAssertEqual(mappedFuture.error.code, TWTFutureErrorCancelled, @"Incorrect error code");
+
+    // Cancelling a flat-mapped future cancels the chained future
+    TWTPromise *chainedPromise = [[TWTPromise alloc] init];
+    TWTFuture *flatMappedFuture = [[TWTFuture futureWithResult:nil] flatMap:^TWTFuture *(id result) {
+        return chainedPromise.future;
+    }];
+
+    [flatMappedFuture cancel];
+    XCTAssertTrue(chainedPromise.future.isCancelled, @"Chained future was not cancelled");
+}
+
+
+- (void)testCancellationPropagatesUpstream
+{
+    TWTPromise *promise = [[TWTPromise alloc] init];
+    TWTFuture *mappedFuture = [promise.future map:^id(id result, NSError *__autoreleasing *error) {
+        return result;
+    }];
+
+    __block BOOL thenBlockInvoked = NO;
+    TWTFuture *thenFuture = [mappedFuture then:^(id result, NSError *error) {
+        thenBlockInvoked = YES;
+    }];
+
+    XCTAssertTrue([thenFuture cancel], @"Pending future was not cancelled");
+    XCTAssertTrue(mappedFuture.isCancelled, @"Cancellation did not propagate through then:");
+    XCTAssertTrue(promise.future.isCancelled, @"Cancellation did not propagate through map:");
+    XCTAssertTrue(thenBlockInvoked, @"then: block was not invoked");
+
+    // Cancelling a flat-mapped future before its block executes cancels the receiver
+    TWTPromise *flatMappedPromise = [[TWTPromise alloc] init];
+    __block BOOL flatMapBlockInvoked = NO;
+    TWTFuture *flatMappedFuture = [flatMappedPromise.future flatMap:^TWTFuture *(id result) {
+        flatMapBlockInvoked = YES;
+        return nil;
+    }];
+
+    [flatMappedFuture cancel];
+    XCTAssertTrue(flatMappedPromise.future.isCancelled, @"Cancellation did not propagate through flatMap:");
+    XCTAssertFalse(flatMapBlockInvoked, @"flatMap: block was invoked");
+
+    // Cancelling a future derived from an operation-backed future cancels the operation
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    operationQueue.suspended = YES;
+    __block BOOL operationBlockInvoked = NO;
+    TWTFuture *operationFuture = [TWTFuture futureWithOperationQueue:operationQueue block:^(TWTAsynchronousOperation *operation, TWTFutureResolveBlock resolveBlock) {
+        operationBlockInvoked = YES;
+        resolveBlock(nil, nil);
+    }];
+
+    [[operationFuture map:^id(id result, NSError *__autoreleasing *error) {
+        return result;
+    }] cancel];
+
+    operationQueue.suspended = NO;
+    [operationQueue waitUntilAllOperationsAreFinished];
+
+    XCTAssertTrue(operationFuture.operation.isCancelled, @"Operation was not cancelled");
+    XCTAssertFalse(operationBlockInvoked, @"Cancelled operation executed its block");
+}
+
+
+- (void)testOperationBackedFutures
+{
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    id expectedResult = UMKRandomUnicodeString();
+
+    TWTFuture *future = [TWTFuture futureWithOperationQueue:operationQueue block:^(TWTAsynchronousOperation *operation, TWTFutureResolveBlock resolveBlock) {
+        resolveBlock(expectedResult, nil);
+    }];
+
+    XCTAssertNotNil(future.operation, @"Future has no operation");
+    [operationQueue waitUntilAllOperationsAreFinished];
+    XCTAssertTrue(future.operation.isFinished, @"Operation did not finish");
+    XCTAssertEqualObjects(future.result, expectedResult, @"Incorrect result");
+
+    // Cancelling the future cancels the operation before its block executes
+    operationQueue.suspended = YES;
+    __block BOOL blockInvoked = NO;
+    TWTFuture *cancelledFuture = [TWTFuture futureWithOperationQueue:operationQueue block:^(TWTAsynchronousOperation *operation, TWTFutureResolveBlock resolveBlock) {
+        blockInvoked = YES;
+        resolveBlock(nil, nil);
+    }];
+
+    [cancelledFuture cancel];
+    operationQueue.suspended = NO;
+    [operationQueue waitUntilAllOperationsAreFinished];
+
+    XCTAssertTrue(cancelledFuture.operation.isCancelled, @"Operation was not cancelled");
+    XCTAssertFalse(blockInvoked, @"Cancelled operation executed its block");
+}
+
+
+- (void)testAll
+{
+    NSUInteger count = random() % 16 + 1;
+    NSMutableArray *promises = [[NSMutableArray alloc] initWithCapacity:count];
+    NSMutableArray *futures = [[NSMutableArray alloc] initWithCapacity:count];
+    for (NSUInteger i = 0; i < count; ++i) {
+        TWTPromise *promise = [[TWTPromise alloc] init];
+        [promises addObject:promise];
+        [futures addObject:promise.future];
+    }
+
+    TWTFuture *allFuture = [TWTFuture all:futures];
+
+    // Fulfill in reverse to make sure results are ordered by input, not completion
+    [promises enumerateObjectsWithOptions:NSEnumerationReverse usingBlock:^(TWTPromise *promise, NSUInteger i, BOOL *stop) {
+        XCTAssertFalse(allFuture.isResolved, @"all: resolved before every input");
+        [promise fulfillWithResult:(i == 0 ? nil : @(i))];
+    }];
+
+    NSMutableArray *expectedResults = [[NSMutableArray alloc] initWithObjects:[NSNull null], nil];
+    for (NSUInteger i = 1; i < count; ++i) {
+        [expectedResults addObject:@(i)];
+    }
+
+    XCTAssertEqualObjects(allFuture.result, expectedResults, @"Incorrect results");
+    XCTAssertEqualObjects([TWTFuture all:@[ ]].result, @[ ], @"Incorrect result for no inputs");
+
+    // A single failure fails immediately
+    NSError *expectedError = [self randomError];
+    TWTPromise *pendingPromise = [[TWTPromise alloc] init];
+    TWTFuture *failedFuture = [TWTFuture all:@[ pendingPromise.future, [TWTFuture futureWithError:expectedError] ]];
+    XCTAssertEqualObjects(failedFuture.error, expectedError, @"all: did not fail fast");
+    XCTAssertTrue(pendingPromise.future.isCancelled, @"all: did not cancel remaining inputs after failing");
+
+    // Cancelling the combined future cancels every input
+    TWTPromise *firstPromise = [[TWTPromise alloc] init];
+    TWTPromise *secondPromise = [[TWTPromise alloc] init];
+    [[TWTFuture all:@[ firstPromise.future, secondPromise.future ]] cancel];
+    XCTAssertTrue(firstPromise.future.isCancelled && secondPromise.future.isCancelled, @"all: inputs were not cancelled");
+}
+
+
+- (void)testAny
+{
+    TWTPromise *slowPromise = [[TWTPromise alloc] init];
+    TWTPromise *fastPromise = [[TWTPromise alloc] init];
+    TWTFuture *anyFuture = [TWTFuture any:@[ slowPromise.future, [TWTFuture futureWithError:[self randomError]], fastPromise.future ]];
+
+    id expectedResult = UMKRandomUnicodeString();
+    [fastPromise fulfillWithResult:expectedResult];
+    XCTAssertEqualObjects(anyFuture.result, expectedResult, @"Incorrect result");
+
+    NSArray *errors = @[ [self randomError], [self randomError] ];
+    TWTFuture *failedFuture = [TWTFuture any:@[ [TWTFuture futureWithError:errors[0]], [TWTFuture futureWithError:errors[1]] ]];
+    XCTAssertEqual(failedFuture.error.code, TWTFutureErrorAllFailed, @"Incorrect error code");
+    XCTAssertEqualObjects(failedFuture.error.userInfo[kTWTFutureUnderlyingErrorsKey], errors, @"Incorrect underlying errors");
+
+    XCTAssertEqual([TWTFuture any:@[ ]].error.code, TWTFutureErrorAllFailed, @"Incorrect error for no inputs");
+
+    // Cancelling the combined future cancels every input
+    [[TWTFuture any:@[ slowPromise.future ]] cancel];
+    XCTAssertTrue(slowPromise.future.isCancelled, @"any: input was not cancelled");
+}
+
+
+- (void)testDeepChainsDoNotBlockThreads
+{
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    operationQueue.maxConcurrentOperationCount = 1;
+
+    // With a single-threaded queue, any continuation that blocked waiting for the next stage would deadlock
+    NSUInteger depth = random() % 64 + 64;
+    TWTFuture *future = [TWTFuture futureWithResult:@0];
+    for (NSUInteger i = 0; i < depth; ++i) {
+        future = [future flatMap:^TWTFuture *(NSNumber *result) {
+            return [TWTFuture futureWithOperationQueue:operationQueue block:^(TWTAsynchronousOperation *operation, TWTFutureResolveBlock resolveBlock) {
+                resolveBlock(@(result.integerValue + 1), nil);
+            }];
+        }];
+    }
+
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [future then:^(id result, NSError *error) {
+        dispatch_semaphore_signal(semaphore);
+    }];
+
+    XCTAssertEqual(dispatch_semaphore_wait(semaphore, dispatch_time(DISPATCH_TIME_NOW, 10 * NSEC_PER_SEC)), 0, @"Chain did not resolve");
+    XCTAssertEqualObjects(future.result, @(depth), @"Incorrect result");
+}
+
+@end
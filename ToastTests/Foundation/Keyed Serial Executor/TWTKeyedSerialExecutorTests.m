@@ -0,0 +1,212 @@
+//
+//  TWTKeyedSerialExecutorTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTKeyedSerialExecutor.h"
+
+
+@interface TWTKeyedSerialExecutorTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTKeyedSerialExecutorTests
+
+- (void)testOperationsExecuteInOrderPerKey
+{
+    TWTKeyedSerialExecutor *executor = [[TWTKeyedSerialExecutor alloc] init];
+
+    NSUInteger keyCount = random() % 16 + 1;
+    NSUInteger operationCount = random() % 64 + 1;
+    NSMutableArray *executionOrders = [[NSMutableArray alloc] initWithCapacity:keyCount];
+    for (NSUInteger key = 0; key < keyCount; ++key) {
+        [executionOrders addObject:[[NSMutableArray alloc] init]];
+    }
+
+    // Finish asynchronously so that ordering depends on the executor, not on the worker that happens to run each block
+    for (NSUInteger i = 0; i < operationCount; ++i) {
+        for (NSUInteger key = 0; key < keyCount; ++key) {
+            NSMutableArray *executionOrder = executionOrders[key];
+            [executor addOperationForKey:@(key) block:^(TWTAsynchronousOperation *operation) {
+                [executionOrder addObject:@(i)];
+                dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                    [operation finishOperationExecution];
+                });
+            }];
+        }
+    }
+
+    [executor waitUntilAllOperationsAreFinished];
+
+    for (NSMutableArray *executionOrder in executionOrders) {
+        XCTAssertEqual(executionOrder.count, operationCount, @"Incorrect number of operations executed");
+        for (NSUInteger i = 0; i < executionOrder.count; ++i) {
+            XCTAssertEqualObjects(executionOrder[i], @(i), @"Operations executed out of order");
+        }
+    }
+}
+
+
+- (void)testDifferentKeysExecuteConcurrently
+{
+    TWTKeyedSerialExecutor *executor = [[TWTKeyedSerialExecutor alloc] initWithWorkerCount:2];
+
+    // Each operation waits for the other, so this only finishes if the two keys run at the same time
+    dispatch_semaphore_t firstSemaphore = dispatch_semaphore_create(0);
+    dispatch_semaphore_t secondSemaphore = dispatch_semaphore_create(0);
+
+    [executor addOperationForKey:@"first" block:^(TWTAsynchronousOperation *operation) {
+        dispatch_semaphore_signal(secondSemaphore);
+        dispatch_semaphore_wait(firstSemaphore, DISPATCH_TIME_FOREVER);
+        [operation finishOperationExecution];
+    }];
+
+    [executor addOperationForKey:@"second" block:^(TWTAsynchronousOperation *operation) {
+        dispatch_semaphore_signal(firstSemaphore);
+        dispatch_semaphore_wait(secondSemaphore, DISPATCH_TIME_FOREVER);
+        [operation finishOperationExecution];
+    }];
+
+    [executor waitUntilAllOperationsAreFinished];
+}
+
+
+- (void)testIdleLanesAreReclaimed
+{
+    TWTKeyedSerialExecutor *executor = [[TWTKeyedSerialExecutor alloc] init];
+
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    NSUInteger keyCount = random() % 32 + 1;
+    for (NSUInteger key = 0; key < keyCount; ++key) {
+        [executor addOperationForKey:@(key) block:^(TWTAsynchronousOperation *operation) {
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+                [operation finishOperationExecution];
+            });
+        }];
+    }
+
+    XCTAssertEqual(executor.laneCount, keyCount, @"Incorrect lane count");
+
+    for (NSUInteger key = 0; key < keyCount; ++key) {
+        dispatch_semaphore_signal(semaphore);
+    }
+
+    [executor waitUntilAllOperationsAreFinished];
+    XCTAssertEqual(executor.laneCount, 0, @"Idle lanes were not reclaimed");
+}
+
+
+- (void)testCancelledOperationsDoNotBlockTheirLane
+{
+    TWTKeyedSerialExecutor *executor = [[TWTKeyedSerialExecutor alloc] initWithWorkerCount:1];
+
+    dispatch_semaphore_t semaphore = dispatch_semaphore_create(0);
+    [executor addOperationForKey:@0 block:^(TWTAsynchronousOperation *operation) {
+        dispatch_semaphore_wait(semaphore, DISPATCH_TIME_FOREVER);
+        [operation finishOperationExecution];
+    }];
+
+    __block BOOL cancelledBlockExecuted = NO;
+    TWTAsynchronousOperation *cancelledOperation = [executor addOperationForKey:@0 block:^(TWTAsynchronousOperation *operation) {
+        cancelledBlockExecuted = YES;
+        [operation finishOperationExecution];
+    }];
+
+    __block BOOL lastBlockExecuted = NO;
+    [executor addOperationForKey:@0 block:^(TWTAsynchronousOperation *operation) {
+        lastBlockExecuted = YES;
+        [operation finishOperationExecution];
+    }];
+
+    [cancelledOperation cancel];
+    dispatch_semaphore_signal(semaphore);
+    [executor waitUntilAllOperationsAreFinished];
+
+    XCTAssertFalse(cancelledBlockExecuted, @"Cancelled operation executed");
+    XCTAssertTrue(lastBlockExecuted, @"Operation after cancelled operation did not execute");
+}
+
+
+#pragma mark - Performance
+
+- (void (^)(void))busyWorkBlock
+{
+    return ^{
+        volatile double value = 0;
+        for (NSUInteger i = 0; i < 200; ++i) {
+            value += sqrt((double)i);
+        }
+    };
+}
+
+
+- (void)testKeyedSerialExecutorPerformance
+{
+    void (^workBlock)(void) = [self busyWorkBlock];
+
+    [self measureBlock:^{
+        TWTKeyedSerialExecutor *executor = [[TWTKeyedSerialExecutor alloc] init];
+        for (NSUInteger i = 0; i < 10; ++i) {
+            for (NSUInteger key = 0; key < 1000; ++key) {
+                [executor addOperationForKey:@(key) block:^(TWTAsynchronousOperation *operation) {
+                    workBlock();
+                    [operation finishOperationExecution];
+                }];
+            }
+        }
+
+        [executor waitUntilAllOperationsAreFinished];
+    }];
+}
+
+
+- (void)testQueuePerKeyPerformance
+{
+    void (^workBlock)(void) = [self busyWorkBlock];
+
+    // The approach being replaced: one serial queue per key, created on demand and kept in a dictionary
+    [self measureBlock:^{
+        dispatch_group_t group = dispatch_group_create();
+        NSMutableDictionary *queues = [[NSMutableDictionary alloc] init];
+        for (NSUInteger i = 0; i < 10; ++i) {
+            for (NSUInteger key = 0; key < 1000; ++key) {
+                dispatch_queue_t queue = queues[@(key)];
+                if (!queue) {
+                    queue = dispatch_queue_create("TWTKeyedSerialExecutorTests.queuePerKey", DISPATCH_QUEUE_SERIAL);
+                    queues[@(key)] = queue;
+                }
+
+                dispatch_group_async(group, queue, workBlock);
+            }
+        }
+
+        dispatch_group_wait(group, DISPATCH_TIME_FOREVER);
+    }];
+}
+
+@end
@@ -0,0 +1,248 @@
+//
+//  TWTNumericArrayTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import <URLMock/UMKTestUtilities.h>
+
+#import "TWTBlockEnumeration.h"
+#import "TWTNumericArray.h"
+
+
+@interface TWTNumericArrayTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTNumericArrayTests
+
+#pragma mark - Helpers
+
+- (NSArray *)randomDoubleNumbersWithCount:(NSUInteger)count
+{
+    return UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @((random() % 2000000) / 100.0 - 10000.0);
+    });
+}
+
+
+- (NSArray *)randomInt64NumbersWithCount:(NSUInteger)count
+{
+    return UMKGeneratedArrayWithElementCount(count, ^id(NSUInteger index) {
+        return @((int64_t)(random() % 2000000) - 1000000);
+    });
+}
+
+
+#pragma mark - Tests
+
+- (void)testConversion
+{
+    NSArray *doubleNumbers = [self randomDoubleNumbersWithCount:random() % 1000];
+    TWTDoubleArray *doubleArray = [[TWTDoubleArray alloc] initWithArray:doubleNumbers];
+    XCTAssertEqual(doubleArray.count, doubleNumbers.count, @"count is incorrect");
+    XCTAssertEqualObjects(doubleArray.arrayValue, doubleNumbers, @"Round trip does not preserve values");
+
+    NSArray *int64Numbers = [self randomInt64NumbersWithCount:random() % 1000];
+    TWTInt64Array *int64Array = [[TWTInt64Array alloc] initWithArray:int64Numbers];
+    XCTAssertEqual(int64Array.count, int64Numbers.count, @"count is incorrect");
+    XCTAssertEqualObjects(int64Array.arrayValue, int64Numbers, @"Round trip does not preserve values");
+
+    int64_t values[] = { 1, -2, INT64_MAX };
+    TWTInt64Array *valuesArray = [[TWTInt64Array alloc] initWithValues:values count:3];
+    XCTAssertEqual([valuesArray valueAtIndex:2], INT64_MAX, @"Value is incorrect");
+    XCTAssertThrows([valuesArray valueAtIndex:3], @"Out of bounds index does not throw");
+    XCTAssertEqualObjects(valuesArray, [[TWTInt64Array alloc] initWithArray:@[ @1, @-2, @(INT64_MAX) ]], @"Equal arrays are not equal");
+    XCTAssertNotEqualObjects(valuesArray, [[TWTDoubleArray alloc] initWithArray:@[ @1, @-2, @(INT64_MAX) ]],
+                             @"Arrays of different classes are equal");
+    XCTAssertEqual(valuesArray.copy, valuesArray, @"Copy is not the same object");
+}
+
+
+
+- (void)testEqualityIsBitwise
+{
+    double zeroValues[] = { 0.0 };
+    double negativeZeroValues[] = { -0.0 };
+    XCTAssertNotEqualObjects([[TWTDoubleArray alloc] initWithValues:zeroValues count:1],
+                             [[TWTDoubleArray alloc] initWithValues:negativeZeroValues count:1], @"0.0 and -0.0 are equal");
+
+    double nanValues[] = { NAN };
+    XCTAssertEqualObjects([[TWTDoubleArray alloc] initWithValues:nanValues count:1],
+                          [[TWTDoubleArray alloc] initWithValues:nanValues count:1], @"Identical NaNs are not equal");
+}
+
+- (void)testDoubleReductions
+{
+    NSArray *numbers = [self randomDoubleNumbersWithCount:random() % 1000 + 1];
+    TWTDoubleArray *array = [[TWTDoubleArray alloc] initWithArray:numbers];
+
+    double expectedSum = 0;
+    double expectedMinimum = INFINITY;
+    double expectedMaximum = -INFINITY;
+    for (NSNumber *number in numbers) {
+        expectedSum += number.doubleValue;
+        expectedMinimum = MIN(expectedMinimum, number.doubleValue);
+        expectedMaximum = MAX(expectedMaximum, number.doubleValue);
+    }
+
+    XCTAssertEqualWithAccuracy(array.sum, expectedSum, 1e-6, @"sum is incorrect");
+    XCTAssertEqual(array.minimum, expectedMinimum, @"minimum is incorrect");
+    XCTAssertEqual(array.maximum, expectedMaximum, @"maximum is incorrect");
+    XCTAssertEqualWithAccuracy(array.mean, expectedSum / numbers.count, 1e-6, @"mean is incorrect");
+
+    TWTDoubleArray *emptyArray = [[TWTDoubleArray alloc] initWithValues:NULL count:0];
+    XCTAssertEqual(emptyArray.sum, 0, @"Empty sum is not 0");
+    XCTAssertEqual(emptyArray.minimum, INFINITY, @"Empty minimum is not +∞");
+    XCTAssertEqual(emptyArray.maximum, -INFINITY, @"Empty maximum is not -∞");
+    XCTAssertTrue(isnan(emptyArray.mean), @"Empty mean is not NaN");
+}
+
+
+- (void)testInt64Reductions
+{
+    NSArray *numbers = [self randomInt64NumbersWithCount:random() % 1000 + 1];
+    TWTInt64Array *array = [[TWTInt64Array alloc] initWithArray:numbers];
+
+    int64_t expectedSum = 0;
+    int64_t expectedMinimum = INT64_MAX;
+    int64_t expectedMaximum = INT64_MIN;
+    for (NSNumber *number in numbers) {
+        expectedSum += number.longLongValue;
+        expectedMinimum = MIN(expectedMinimum, number.longLongValue);
+        expectedMaximum = MAX(expectedMaximum, number.longLongValue);
+    }
+
+    XCTAssertEqual(array.sum, expectedSum, @"sum is incorrect");
+    XCTAssertEqual(array.minimum, expectedMinimum, @"minimum is incorrect");
+    XCTAssertEqual(array.maximum, expectedMaximum, @"maximum is incorrect");
+    XCTAssertEqualWithAccuracy(array.mean, (double)expectedSum / numbers.count, 1e-6, @"mean is incorrect");
+
+    int64_t overflowingValues[] = { INT64_MAX, 1, 0, 0, 0 };
+    XCTAssertEqual([[TWTInt64Array alloc] initWithValues:overflowingValues count:5].sum, INT64_MIN, @"Sum does not wrap around");
+}
+
+
+- (void)testBlockEnumeration
+{
+    NSArray *numbers = [self randomInt64NumbersWithCount:random() % 1000 + 1];
+    TWTInt64Array *array = [[TWTInt64Array alloc] initWithArray:numbers];
+
+    TWTInt64Array *collectedArray = [array collectWithBlock:^int64_t(int64_t value) {
+        return value * 3;
+    }];
+
+    XCTAssertEqualObjects(collectedArray.arrayValue, [numbers twt_collectWithBlock:^id(NSNumber *number) {
+        return @(number.longLongValue * 3);
+    }], @"collect is incorrect");
+
+    BOOL (^predicate)(int64_t) = ^BOOL(int64_t value) {
+        return value % 3 == 0;
+    };
+
+    TWTBlockEnumerationPredicateBlock numberPredicate = ^BOOL(NSNumber *number) {
+        return predicate(number.longLongValue);
+    };
+
+    XCTAssertEqualObjects([array selectWithBlock:predicate].arrayValue, [numbers twt_selectWithBlock:numberPredicate], @"select is incorrect");
+    XCTAssertEqualObjects([array rejectWithBlock:predicate].arrayValue, [numbers twt_rejectWithBlock:numberPredicate], @"reject is incorrect");
+
+    NSUInteger detectedIndex = [array detectWithBlock:predicate];
+    XCTAssertEqual(detectedIndex, [numbers indexOfObjectPassingTest:^BOOL(NSNumber *number, NSUInteger index, BOOL *stop) {
+        return numberPredicate(number);
+    }], @"detect is incorrect");
+
+    int64_t sum = [array injectWithInitialValue:0 block:^int64_t(int64_t memo, int64_t value) {
+        return memo + value;
+    }];
+
+    XCTAssertEqual(sum, array.sum, @"inject is incorrect");
+
+    TWTDoubleArray *doubleArray = [[TWTDoubleArray alloc] initWithArray:@[ @1.5, @-2, @3, @0.25 ]];
+    XCTAssertEqualObjects([doubleArray rejectWithBlock:^BOOL(double value) {
+        return value < 1;
+    }].arrayValue, (@[ @1.5, @3 ]), @"reject is incorrect");
+}
+
+
+- (void)testMaskSelection
+{
+    NSArray *numbers = [self randomDoubleNumbersWithCount:random() % 1000 + 1];
+    TWTDoubleArray *array = [[TWTDoubleArray alloc] initWithArray:numbers];
+    double minimum = -random() % 5000;
+    double maximum = random() % 5000;
+
+    NSData *mask = [array maskForValuesWithMinimum:@(minimum) maximum:@(maximum)];
+    XCTAssertEqual(mask.length, array.count, @"Mask length is incorrect");
+
+    TWTDoubleArray *selectedArray = [array arrayBySelectingValuesWithMask:mask];
+    XCTAssertTrue([selectedArray isKindOfClass:[TWTDoubleArray class]], @"Selected array is not a double array");
+    XCTAssertEqualObjects(selectedArray.arrayValue, [numbers twt_selectWithBlock:^BOOL(NSNumber *number) {
+        return number.doubleValue >= minimum && number.doubleValue <= maximum;
+    }], @"Selected values are incorrect");
+
+    TWTInt64Array *int64Array = [[TWTInt64Array alloc] initWithArray:@[ @5, @-1, @10, @7 ]];
+    NSData *int64Mask = [int64Array maskForValuesWithMinimum:@5 maximum:@7];
+    XCTAssertEqualObjects([int64Array arrayBySelectingValuesWithMask:int64Mask].arrayValue, (@[ @5, @7 ]), @"Selected values are incorrect");
+}
+
+
+#pragma mark - Performance
+
+- (void)testBoxedSumPerformance
+{
+    NSArray *numbers = [self randomDoubleNumbersWithCount:100000];
+
+    [self measureBlock:^{
+        [numbers twt_injectWithInitialObject:@0 block:^id(NSNumber *memo, NSNumber *number) {
+            return @(memo.doubleValue + number.doubleValue);
+        }];
+    }];
+}
+
+
+- (void)testUnboxedSumPerformance
+{
+    TWTDoubleArray *array = [[TWTDoubleArray alloc] initWithArray:[self randomDoubleNumbersWithCount:100000]];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 100; ++i) {
+            [array sum];
+        }
+    }];
+}
+
+
+- (void)testConversionPerformance
+{
+    NSArray *numbers = [self randomDoubleNumbersWithCount:100000];
+
+    [self measureBlock:^{
+        (void)[[TWTDoubleArray alloc] initWithArray:numbers];
+    }];
+}
+
+@end
@@ -0,0 +1,234 @@
+//
+//  TWTOperationCoalescerTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTOperationCoalescer.h"
+
+
+@interface TWTOperationCoalescerTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTOperationCoalescerTests
+
+- (void)testConcurrentSubmissionsAreCoalesced
+{
+    NSOperationQueue *operationQueue = [[NSOperationQueue alloc] init];
+    operationQueue.suspended = YES;
+    TWTOperationCoalescer *coalescer = [[TWTOperationCoalescer alloc] initWithOperationQueue:operationQueue];
+
+    NSString *key = UMKRandomUnicodeString();
+    id expectedResult = UMKRandomUnicodeString();
+    NSUInteger submissionCount = random() % 16 + 2;
+
+    __block NSUInteger workCount = 0;
+    NSMutableArray *results = [[NSMutableArray alloc] init];
+    NSMutableSet *operations = [[NSMutableSet alloc] init];
+
+    for (NSUInteger i = 0; i < submissionCount; ++i) {
+        TWTAsynchronousOperation *operation = [coalescer submitOperationForKey:key workBlock:^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+            ++workCount;
+            finishBlock(expectedResult, nil);
+        } resultBlock:^(id result, NSError *error) {
+            XCTAssertNil(error, @"Error is non-nil");
+            @synchronized (results) {
+                [results addObject:result];
+            }
+        }];
+
+        [operations addObject:operation];
+    }
+
+    XCTAssertEqual(operations.count, 1, @"Submissions were not coalesced into a single operation");
+    XCTAssertEqual(coalescer.executionCount, 1, @"Incorrect execution count");
+    XCTAssertEqual(coalescer.coalescedCount, submissionCount - 1, @"Incorrect coalesced count");
+
+    operationQueue.suspended = NO;
+    [operationQueue waitUntilAllOperationsAreFinished];
+
+    XCTAssertEqual(workCount, 1, @"Work was performed more than once");
+    XCTAssertEqual(results.count, submissionCount, @"Not every result block was invoked");
+    for (id result in results) {
+        XCTAssertEqualObjects(result, expectedResult, @"Incorrect result");
+    }
+
+    // Now that the operation has finished, the key should be released
+    [coalescer submitOperationForKey:key workBlock:^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+        finishBlock(nil, nil);
+    } resultBlock:^(id result, NSError *error) { }];
+
+    XCTAssertEqual(coalescer.executionCount, 2, @"Key was not released after its operation finished");
+    XCTAssertEqual(coalescer.submissionCount, submissionCount + 1, @"Incorrect submission count");
+    [operationQueue waitUntilAllOperationsAreFinished];
+}
+
+
+- (void)testDistinctKeysAreNotCoalesced
+{
+    TWTOperationCoalescer *coalescer = [[TWTOperationCoalescer alloc] init];
+    coalescer.operationQueue.suspended = YES;
+
+    NSUInteger keyCount = random() % 16 + 2;
+    for (NSUInteger i = 0; i < keyCount; ++i) {
+        [coalescer submitOperationForKey:@(i) workBlock:^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+            finishBlock(@(i), nil);
+        } resultBlock:^(id result, NSError *error) {
+            XCTAssertEqualObjects(result, @(i), @"Incorrect result for key");
+        }];
+    }
+
+    XCTAssertEqual(coalescer.executionCount, keyCount, @"Distinct keys were coalesced");
+    XCTAssertEqual(coalescer.coalescedCount, 0, @"Incorrect coalesced count");
+
+    coalescer.operationQueue.suspended = NO;
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+}
+
+
+- (void)testResultsAreCached
+{
+    TWTOperationCoalescer *coalescer = [[TWTOperationCoalescer alloc] init];
+    coalescer.resultCacheDuration = 60;
+
+    NSString *key = UMKRandomUnicodeString();
+    id expectedResult = UMKRandomUnicodeString();
+
+    TWTOperationCoalescerWorkBlock workBlock = ^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+        finishBlock(expectedResult, nil);
+    };
+
+    [coalescer submitOperationForKey:key workBlock:workBlock resultBlock:^(id result, NSError *error) { }];
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+
+    __block id cachedResult = nil;
+    TWTAsynchronousOperation *operation = [coalescer submitOperationForKey:key workBlock:workBlock resultBlock:^(id result, NSError *error) {
+        cachedResult = result;
+    }];
+
+    XCTAssertNil(operation, @"Operation returned for cached result");
+    XCTAssertEqualObjects(cachedResult, expectedResult, @"Cached result was not delivered synchronously");
+    XCTAssertEqual(coalescer.cacheHitCount, 1, @"Incorrect cache hit count");
+    XCTAssertEqual(coalescer.executionCount, 1, @"Cached key was executed again");
+
+    [coalescer removeAllCachedResults];
+    operation = [coalescer submitOperationForKey:key workBlock:workBlock resultBlock:^(id result, NSError *error) { }];
+    XCTAssertNotNil(operation, @"Cached result was used after cache was emptied");
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+}
+
+
+- (void)testExpiredResultsDoNotEvictNewerResults
+{
+    TWTOperationCoalescer *coalescer = [[TWTOperationCoalescer alloc] init];
+    coalescer.resultCacheDuration = 0.01;
+
+    NSString *key = UMKRandomUnicodeString();
+    TWTOperationCoalescerWorkBlock workBlock = ^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+        finishBlock(@YES, nil);
+    };
+
+    [coalescer submitOperationForKey:key workBlock:workBlock resultBlock:^(id result, NSError *error) { }];
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+    [NSThread sleepForTimeInterval:0.05];
+
+    // Cache the key again, then finish another operation so that the first, expired result is swept
+    coalescer.resultCacheDuration = 60;
+    XCTAssertNotNil([coalescer submitOperationForKey:key workBlock:workBlock resultBlock:^(id result, NSError *error) { }],
+                    @"Expired result was used");
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+
+    [coalescer submitOperationForKey:[key stringByAppendingString:@"-other"] workBlock:workBlock resultBlock:^(id result, NSError *error) { }];
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+
+    XCTAssertNil([coalescer submitOperationForKey:key workBlock:workBlock resultBlock:^(id result, NSError *error) { }],
+                 @"Sweeping an expired result removed a newer result for the same key");
+    XCTAssertEqual(coalescer.cacheHitCount, 1, @"Incorrect cache hit count");
+}
+
+
+- (void)testErrorsAreNotCached
+{
+    TWTOperationCoalescer *coalescer = [[TWTOperationCoalescer alloc] init];
+    coalescer.resultCacheDuration = 60;
+
+    NSString *key = UMKRandomUnicodeString();
+    NSError *expectedError = [NSError errorWithDomain:UMKRandomUnicodeString() code:random() userInfo:nil];
+
+    __block NSError *receivedError = nil;
+    [coalescer submitOperationForKey:key workBlock:^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+        finishBlock(nil, expectedError);
+    } resultBlock:^(id result, NSError *error) {
+        receivedError = error;
+    }];
+
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+    XCTAssertEqualObjects(receivedError, expectedError, @"Error was not delivered");
+
+    TWTAsynchronousOperation *operation = [coalescer submitOperationForKey:key workBlock:^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+        finishBlock(nil, nil);
+    } resultBlock:^(id result, NSError *error) { }];
+
+    XCTAssertNotNil(operation, @"Error was cached");
+    XCTAssertEqual(coalescer.cacheHitCount, 0, @"Incorrect cache hit count");
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+}
+
+
+- (void)testCancelledOperationsDeliverNoResultError
+{
+    TWTOperationCoalescer *coalescer = [[TWTOperationCoalescer alloc] init];
+    coalescer.operationQueue.suspended = YES;
+
+    NSString *key = UMKRandomUnicodeString();
+    __block BOOL workPerformed = NO;
+    __block NSError *receivedError = nil;
+
+    TWTAsynchronousOperation *operation = [coalescer submitOperationForKey:key workBlock:^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+        workPerformed = YES;
+        finishBlock(nil, nil);
+    } resultBlock:^(id result, NSError *error) {
+        receivedError = error;
+    }];
+
+    [operation cancel];
+    coalescer.operationQueue.suspended = NO;
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+
+    XCTAssertFalse(workPerformed, @"Cancelled operation performed its work");
+    XCTAssertEqualObjects(receivedError.domain, kTWTOperationCoalescerErrorDomain, @"Incorrect error domain");
+    XCTAssertEqual(receivedError.code, TWTOperationCoalescerErrorNoResult, @"Incorrect error code");
+
+    TWTAsynchronousOperation *nextOperation = [coalescer submitOperationForKey:key workBlock:^(TWTAsynchronousOperation *operation, TWTOperationCoalescerResultBlock finishBlock) {
+        finishBlock(nil, nil);
+    } resultBlock:^(id result, NSError *error) { }];
+
+    XCTAssertNotEqual(nextOperation, operation, @"Key was not released after cancellation");
+    [coalescer.operationQueue waitUntilAllOperationsAreFinished];
+}
+
+@end
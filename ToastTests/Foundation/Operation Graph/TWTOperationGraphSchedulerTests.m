@@ -0,0 +1,224 @@
+//
+//  TWTOperationGraphSchedulerTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTOperationGraphScheduler.h"
+
+
+@interface TWTOperationGraphSchedulerTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTOperationGraphSchedulerTests
+
+#pragma mark - Helpers
+
+- (TWTAsynchronousOperation *)operationWithName:(NSString *)name duration:(NSTimeInterval)duration executionOrder:(NSMutableArray *)executionOrder
+{
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        @synchronized (executionOrder) {
+            [executionOrder addObject:operation.name];
+        }
+
+        if (duration > 0) {
+            [NSThread sleepForTimeInterval:duration];
+        }
+
+        [operation finishOperationExecution];
+    }];
+
+    operation.name = name;
+    return operation;
+}
+
+
+/*!
+ Returns a graph with one chain of chainLength operations and shortOperationCount independent operations that appear 
+ before the chain in the returned array. Every operation takes the specified duration.
+ */
+- (NSArray *)graphWithChainLength:(NSUInteger)chainLength
+              shortOperationCount:(NSUInteger)shortOperationCount
+                         duration:(NSTimeInterval)duration
+                   executionOrder:(NSMutableArray *)executionOrder
+{
+    NSMutableArray *operations = [[NSMutableArray alloc] init];
+    for (NSUInteger i = 0; i < shortOperationCount; ++i) {
+        [operations addObject:[self operationWithName:[NSString stringWithFormat:@"short%lu", (unsigned long)i]
+                                             duration:duration
+                                       executionOrder:executionOrder]];
+    }
+
+    TWTAsynchronousOperation *previousOperation = nil;
+    for (NSUInteger i = 0; i < chainLength; ++i) {
+        TWTAsynchronousOperation *operation = [self operationWithName:[NSString stringWithFormat:@"chain%lu", (unsigned long)i]
+                                                             duration:duration
+                                                       executionOrder:executionOrder];
+        if (previousOperation) {
+            [operation addDependency:previousOperation];
+        }
+
+        [operations addObject:operation];
+        previousOperation = operation;
+    }
+
+    return operations;
+}
+
+
+#pragma mark - Tests
+
+- (void)testCriticalPathIsStartedFirst
+{
+    TWTOperationGraphScheduler *scheduler = [[TWTOperationGraphScheduler alloc] initWithMaximumConcurrentOperationCount:1];
+    NSMutableArray *executionOrder = [[NSMutableArray alloc] init];
+
+    NSUInteger chainLength = random() % 10 + 2;
+    NSUInteger shortOperationCount = random() % 10 + 1;
+    NSArray *operations = [self graphWithChainLength:chainLength shortOperationCount:shortOperationCount duration:0 executionOrder:executionOrder];
+
+    NSError *error = nil;
+    XCTAssertTrue([scheduler executeOperationsAndWait:operations error:&error], @"Valid graph failed to execute: %@", error);
+    XCTAssertEqualObjects(executionOrder.firstObject, @"chain0", @"Critical path was not started first");
+
+    for (NSOperation *operation in operations) {
+        XCTAssertTrue(operation.isFinished, @"Operation did not finish");
+    }
+}
+
+
+- (void)testCostBlock
+{
+    TWTOperationGraphScheduler *scheduler = [[TWTOperationGraphScheduler alloc] initWithMaximumConcurrentOperationCount:1];
+    NSMutableArray *executionOrder = [[NSMutableArray alloc] init];
+
+    TWTAsynchronousOperation *cheapOperation = [self operationWithName:@"cheap" duration:0 executionOrder:executionOrder];
+    TWTAsynchronousOperation *expensiveOperation = [self operationWithName:@"expensive" duration:0 executionOrder:executionOrder];
+
+    scheduler.costBlock = ^NSTimeInterval(NSOperation *operation) {
+        return [operation.name isEqualToString:@"expensive"] ? 10 : -1;
+    };
+
+    XCTAssertTrue([scheduler executeOperationsAndWait:@[ cheapOperation, expensiveOperation ] error:NULL], @"Valid graph failed to execute");
+
+    NSArray *expectedOrder = @[ @"expensive", @"cheap" ];
+    XCTAssertEqualObjects(executionOrder, expectedOrder, @"Cost block was not used to order operations");
+}
+
+
+- (void)testMeasuredCosts
+{
+    TWTOperationGraphScheduler *scheduler = [[TWTOperationGraphScheduler alloc] init];
+    NSMutableArray *executionOrder = [[NSMutableArray alloc] init];
+
+    TWTAsynchronousOperation *operation = [self operationWithName:@"measured" duration:0.01 executionOrder:executionOrder];
+    XCTAssertTrue([scheduler executeOperationsAndWait:@[ operation ] error:NULL], @"Valid graph failed to execute");
+
+    NSNumber *measuredCost = scheduler.measuredCosts[@"measured"];
+    XCTAssertNotNil(measuredCost, @"Operation cost was not measured");
+    XCTAssertGreaterThanOrEqual(measuredCost.doubleValue, 0.01, @"Measured cost is too low");
+}
+
+
+- (void)testCycleDetection
+{
+    TWTOperationGraphScheduler *scheduler = [[TWTOperationGraphScheduler alloc] init];
+
+    NSUInteger cycleLength = random() % 10 + 2;
+    NSMutableArray *operations = [[NSMutableArray alloc] initWithCapacity:cycleLength];
+    for (NSUInteger i = 0; i < cycleLength; ++i) {
+        TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:nil];
+        if (operations.lastObject) {
+            [operation addDependency:operations.lastObject];
+        }
+
+        [operations addObject:operation];
+    }
+
+    // Close the cycle
+    [operations.firstObject addDependency:operations.lastObject];
+
+    NSError *error = nil;
+    XCTAssertFalse([scheduler executeOperations:operations completion:nil error:&error], @"Cyclic graph was executed");
+    XCTAssertEqualObjects(error.domain, kTWTOperationGraphErrorDomain, @"Incorrect error domain");
+    XCTAssertEqual(error.code, TWTOperationGraphErrorCycle, @"Incorrect error code");
+    XCTAssertEqual([error.userInfo[kTWTOperationGraphErrorOperationsKey] count], cycleLength, @"Incorrect cyclic operations");
+
+    for (NSOperation *operation in operations) {
+        XCTAssertFalse(operation.isExecuting || operation.isFinished, @"Operation in cyclic graph was started");
+    }
+}
+
+
+- (void)testUnfinishedExternalDependency
+{
+    TWTOperationGraphScheduler *scheduler = [[TWTOperationGraphScheduler alloc] init];
+
+    TWTAsynchronousOperation *externalOperation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:nil];
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:nil];
+    [operation addDependency:externalOperation];
+
+    NSError *error = nil;
+    XCTAssertFalse([scheduler validateOperations:@[ operation ] error:&error], @"Graph with unfinished external dependency is valid");
+    XCTAssertEqual(error.code, TWTOperationGraphErrorUnfinishedExternalDependency, @"Incorrect error code");
+
+    [externalOperation start];
+    XCTAssertTrue([scheduler validateOperations:@[ operation ] error:NULL], @"Graph with finished external dependency is invalid");
+}
+
+
+#pragma mark - Performance
+
+- (void)testCriticalPathSchedulerMakespanPerformance
+{
+    TWTOperationGraphScheduler *scheduler = [[TWTOperationGraphScheduler alloc] initWithMaximumConcurrentOperationCount:4];
+
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        NSArray *operations = [self graphWithChainLength:10 shortOperationCount:20 duration:0.002 executionOrder:[[NSMutableArray alloc] init]];
+
+        [self startMeasuring];
+        [scheduler executeOperationsAndWait:operations error:NULL];
+        [self stopMeasuring];
+    }];
+}
+
+
+- (void)testOperationQueueMakespanPerformance
+{
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    queue.maxConcurrentOperationCount = 4;
+
+    [self measureMetrics:[[self class] defaultPerformanceMetrics] automaticallyStartMeasuring:NO forBlock:^{
+        NSArray *operations = [self graphWithChainLength:10 shortOperationCount:20 duration:0.002 executionOrder:[[NSMutableArray alloc] init]];
+
+        [self startMeasuring];
+        [queue addOperations:operations waitUntilFinished:YES];
+        [self stopMeasuring];
+    }];
+}
+
+@end
@@ -0,0 +1,306 @@
+//
+//  TWTWorkStealingExecutorTests.m
+//  Toast
+//
+//  Created by Two Toasters on 10/17/2026.
+//  Copyright (c) 2026 Ticketmaster Entertainment, Inc. All rights reserved.
+//
+//  Permission is hereby granted, free of charge, to any person obtaining a copy
+//  of this software and associated documentation files (the "Software"), to deal
+//  in the Software without restriction, including without limitation the rights
+//  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+//  copies of the Software, and to permit persons to whom the Software is
+//  furnished to do so, subject to the following conditions:
+//
+//  The above copyright notice and this permission notice shall be included in
+//  all copies or substantial portions of the Software.
+//
+//  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN
+//  THE SOFTWARE.
+//
+
+#import "TWTRandomizedTestCase.h"
+
+#import "TWTWorkStealingExecutor.h"
+
+
+@interface TWTWorkStealingExecutorTests : TWTRandomizedTestCase
+
+@end
+
+
+@implementation TWTWorkStealingExecutorTests
+
+#pragma mark - Helpers
+
+- (NSUInteger)randomWorkerCount
+{
+    return random() % 8 + 1;
+}
+
+
+/*!
+ Submits a fan-out/fan-in graph to the executor: a root operation, width children that each depend on the root, and
+ a join operation that depends on every child. Returns the join operation.
+ */
+- (TWTAsynchronousOperation *)submitFanOutFanInGraphWithWidth:(NSUInteger)width
+                                                   toExecutor:(TWTWorkStealingExecutor *)executor
+                                                    workBlock:(void (^)(void))workBlock
+{
+    TWTAsynchronousOperation *root = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        workBlock();
+        [operation finishOperationExecution];
+    }];
+
+    TWTAsynchronousOperation *join = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        workBlock();
+        [operation finishOperationExecution];
+    }];
+
+    NSMutableArray *operations = [[NSMutableArray alloc] initWithCapacity:width + 2];
+    [operations addObject:root];
+    for (NSUInteger i = 0; i < width; ++i) {
+        TWTAsynchronousOperation *child = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+            workBlock();
+            [operation finishOperationExecution];
+        }];
+
+        [child addDependency:root];
+        [join addDependency:child];
+        [operations addObject:child];
+    }
+
+    [operations addObject:join];
+    [executor addOperations:operations waitUntilFinished:NO];
+    return join;
+}
+
+
+#pragma mark - Tests
+
+- (void)testBlockExecution
+{
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:[self randomWorkerCount]];
+
+    NSUInteger operationCount = random() % 1000 + 1;
+    NSMutableArray *operations = [[NSMutableArray alloc] initWithCapacity:operationCount];
+    for (NSUInteger i = 0; i < operationCount; ++i) {
+        [operations addObject:[executor addOperationWithBlock:^(TWTAsynchronousOperation *operation) {
+            [operation finishOperationExecution];
+        }]];
+    }
+
+    [executor waitUntilAllOperationsAreFinished];
+
+    for (TWTAsynchronousOperation *operation in operations) {
+        XCTAssertTrue(operation.isFinished, @"Operation did not finish");
+    }
+}
+
+
+- (void)testTaskExecution
+{
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:[self randomWorkerCount]];
+    TWTAsynchronousOperationPool *pool = [[TWTAsynchronousOperationPool alloc] init];
+
+    NSUInteger taskCount = random() % 1000 + 1;
+    __block NSUInteger executionCount = 0;
+    for (NSUInteger i = 0; i < taskCount; ++i) {
+        [executor addTask:[pool taskWithBlock:^(TWTAsynchronousTask *task) {
+            @synchronized (pool) {
+                ++executionCount;
+            }
+
+            [task finishTaskExecution];
+        }]];
+    }
+
+    [executor waitUntilAllOperationsAreFinished];
+    XCTAssertEqual(executionCount, taskCount, @"Tasks did not all execute");
+}
+
+
+- (void)testDependenciesAreHonored
+{
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:[self randomWorkerCount]];
+
+    NSUInteger chainLength = random() % 100 + 2;
+    NSMutableArray *executionOrder = [[NSMutableArray alloc] initWithCapacity:chainLength];
+    NSMutableArray *operations = [[NSMutableArray alloc] initWithCapacity:chainLength];
+
+    for (NSUInteger i = 0; i < chainLength; ++i) {
+        TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+            // Finish asynchronously so that dependents have to wait for finish handlers rather than -start returning
+            dispatch_async(dispatch_get_global_queue(DISPATCH_QUEUE_PRIORITY_DEFAULT, 0), ^{
+                @synchronized (executionOrder) {
+                    [executionOrder addObject:@(i)];
+                }
+                [operation finishOperationExecution];
+            });
+        }];
+
+        [operation addDependency:operations.lastObject ?: [NSBlockOperation blockOperationWithBlock:^{ }]];
+        [operations addObject:operation];
+    }
+
+    // Submit in reverse so that the executor can’t rely on submission order. The very first dependency is an
+    // NSBlockOperation that was never started, so start it last.
+    NSBlockOperation *externalDependency = [[operations.firstObject dependencies] firstObject];
+    [executor addOperations:[[operations reverseObjectEnumerator] allObjects] waitUntilFinished:NO];
+    [externalDependency start];
+    [executor waitUntilAllOperationsAreFinished];
+
+    NSMutableArray *expectedOrder = [[NSMutableArray alloc] initWithCapacity:chainLength];
+    for (NSUInteger i = 0; i < chainLength; ++i) {
+        [expectedOrder addObject:@(i)];
+    }
+
+    XCTAssertEqualObjects(executionOrder, expectedOrder, @"Operations did not execute in dependency order");
+}
+
+
+- (void)testCancellationIsHonored
+{
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:[self randomWorkerCount]];
+
+    __block BOOL blockExecuted = NO;
+    TWTAsynchronousOperation *operation = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+        blockExecuted = YES;
+        [operation finishOperationExecution];
+    }];
+
+    [operation cancel];
+    [executor addOperations:@[ operation ] waitUntilFinished:YES];
+
+    XCTAssertFalse(blockExecuted, @"Cancelled operation executed its block");
+    XCTAssertTrue(operation.isFinished, @"Cancelled operation did not finish");
+}
+
+
+- (void)testNestedSubmission
+{
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:[self randomWorkerCount]];
+
+    NSUInteger childCount = random() % 100 + 1;
+    __block NSUInteger childrenExecuted = 0;
+    [executor addOperationWithBlock:^(TWTAsynchronousOperation *operation) {
+        for (NSUInteger i = 0; i < childCount; ++i) {
+            [executor addOperationWithBlock:^(TWTAsynchronousOperation *child) {
+                @synchronized (executor) {
+                    ++childrenExecuted;
+                }
+                [child finishOperationExecution];
+            }];
+        }
+
+        [operation finishOperationExecution];
+    }];
+
+    [executor waitUntilAllOperationsAreFinished];
+    XCTAssertEqual(childrenExecuted, childCount, @"Not all child operations executed");
+}
+
+
+- (void)testFanOutFanIn
+{
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:[self randomWorkerCount]];
+    TWTAsynchronousOperation *join = [self submitFanOutFanInGraphWithWidth:random() % 1000 + 1 toExecutor:executor workBlock:^{ }];
+
+    [executor waitUntilAllOperationsAreFinished];
+    XCTAssertTrue(join.isFinished, @"Join operation did not finish");
+}
+
+
+#pragma mark - Performance
+
+- (void (^)(void))busyWorkBlock
+{
+    return ^{
+        // Roughly a few microseconds of busy work per task
+        volatile double value = 0;
+        for (NSUInteger i = 0; i < 1000; ++i) {
+            value += sqrt((double)i);
+        }
+    };
+}
+
+
+/*!
+ Measures running ten fan-out/fan-in graphs of width 500 on an executor with the specified number of workers. 
+ Comparing the results for different worker counts shows how the executor scales.
+ */
+- (void)measureFanOutFanInWithWorkerCount:(NSUInteger)workerCount
+{
+    void (^workBlock)(void) = [self busyWorkBlock];
+    TWTWorkStealingExecutor *executor = [[TWTWorkStealingExecutor alloc] initWithWorkerCount:workerCount];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10; ++i) {
+            [self submitFanOutFanInGraphWithWidth:500 toExecutor:executor workBlock:workBlock];
+        }
+
+        [executor waitUntilAllOperationsAreFinished];
+    }];
+}
+
+
+- (void)testFanOutFanInWithOneWorkerPerformance
+{
+    [self measureFanOutFanInWithWorkerCount:1];
+}
+
+
+- (void)testFanOutFanInWithTwoWorkersPerformance
+{
+    [self measureFanOutFanInWithWorkerCount:2];
+}
+
+
+- (void)testFanOutFanInWithFourWorkersPerformance
+{
+    [self measureFanOutFanInWithWorkerCount:4];
+}
+
+
+- (void)testFanOutFanInWithOneWorkerPerProcessorPerformance
+{
+    [self measureFanOutFanInWithWorkerCount:[[NSProcessInfo processInfo] activeProcessorCount]];
+}
+
+
+- (void)testOperationQueueFanOutFanInPerformance
+{
+    void (^workBlock)(void) = [self busyWorkBlock];
+    NSOperationQueue *queue = [[NSOperationQueue alloc] init];
+    queue.maxConcurrentOperationCount = [[NSProcessInfo processInfo] activeProcessorCount];
+
+    [self measureBlock:^{
+        for (NSUInteger i = 0; i < 10; ++i) {
+            TWTAsynchronousOperation *root = [[TWTAsynchronousOperation alloc] initWithOperationBlock:^(TWTAsynchronousOperation *operation) {
+                workBlock();
+                [operation finishOperationExecution];
+            }];
+
+            NSBlockOperation *join = [NSBlockOperation blockOperationWithBlock:workBlock];
+            NSMutableArray *operations = [[NSMutableArray alloc] initWithObjects:root, nil];
+            for (NSUInteger j = 0; j < 500; ++j) {
+                NSBlockOperation *child = [NSBlockOperation blockOperationWithBlock:workBlock];
+                [child addDependency:root];
+                [join addDependency:child];
+                [operations addObject:child];
+            }
+
+            [operations addObject:join];
+            [queue addOperations:operations waitUntilFinished:NO];
+        }
+
+        [queue waitUntilAllOperationsAreFinished];
+    }];
+}
+
+@end
@@ -46,3 +46,13 @@
  */
 #define UMKAssertTrueBeforeTimeout(timeoutInterval, expression, format...) \
     XCTAssertTrue(UMKWaitForCondition((timeoutInterval), ^BOOL{ return (expression); }), ## format)
+
+
+/*!
+ @abstract Returns the number of heap allocations made on the calling thread while executing the specified block.
+ @discussion Allocations are counted using libmalloc’s malloc_logger hook, which allocation tracing tools also use.
+     Allocations made on other threads while the block executes, e.g., by the test runner, are not counted.
+ @param block The block to execute. May not be nil.
+ @result The number of allocations the block made on the calling thread.
+ */
+extern NSUInteger TWTAllocationCountForBlock(void (^block)(void));
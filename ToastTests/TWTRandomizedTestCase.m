@@ -26,6 +26,8 @@
 
 #import "TWTRandomizedTestCase.h"
 
+#import <pthread.h>
+
 @implementation TWTRandomizedTestCase
 
 + (void)setUp
@@ -44,3 +46,45 @@
 }
 
 @end
+
+
+#pragma mark - Allocation Counting
+
+// When malloc_logger is set, libmalloc calls it for every allocation and deallocation. This is the hook that
+// allocation tracing tools use
+typedef void (TWTMallocLogger)(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result,
+                               uint32_t numberOfHotFramesToSkip);
+extern TWTMallocLogger *malloc_logger;
+
+static const uint32_t kTWTMallocLoggerTypeAllocate = 2;
+
+static TWTMallocLogger *TWTPreviousMallocLogger;
+static pthread_t TWTAllocationCountingThread;
+static NSUInteger TWTAllocationCount;
+
+static void TWTCountAllocation(uint32_t type, uintptr_t arg1, uintptr_t arg2, uintptr_t arg3, uintptr_t result,
+                               uint32_t numberOfHotFramesToSkip)
+{
+    // Ignore allocations on other threads, e.g., by the test runner
+    if ((type & kTWTMallocLoggerTypeAllocate) && pthread_equal(pthread_self(), TWTAllocationCountingThread)) {
+        ++TWTAllocationCount;
+    }
+
+    if (TWTPreviousMallocLogger) {
+        TWTPreviousMallocLogger(type, arg1, arg2, arg3, result, numberOfHotFramesToSkip + 1);
+    }
+}
+
+
+NSUInteger TWTAllocationCountForBlock(void (^block)(void))
+{
+    TWTAllocationCountingThread = pthread_self();
+    TWTAllocationCount = 0;
+    TWTPreviousMallocLogger = malloc_logger;
+
+    malloc_logger = TWTCountAllocation;
+    block();
+    malloc_logger = TWTPreviousMallocLogger;
+
+    return TWTAllocationCount;
+}